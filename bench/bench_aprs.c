@@ -0,0 +1,353 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <limits.h>
+
+#include "aprs.h"
+#include "bench_common.h"
+#include "bench_aprs.h"
+
+// Decodes info once and releases whatever the decoder allocated, returns the decoder result
+typedef int (*bench_aprs_decode_fn_t)(const char *info, size_t len);
+
+typedef struct {
+    const char *name;
+    const char *info;
+    size_t len;
+    bench_aprs_decode_fn_t decode;
+} bench_aprs_case_t;
+
+static int bench_position_no_ts(const char *info, size_t len) {
+    (void) len;
+    aprs_position_no_ts_t data;
+    int ret = aprs_decode_position_no_ts(info, &data);
+    if (ret == 0)
+        free(data.comment);
+    return ret;
+}
+
+static int bench_position_with_ts(const char *info, size_t len) {
+    (void) len;
+    aprs_position_with_ts_t data;
+    int ret = aprs_decode_position_with_ts(info, &data);
+    if (ret == 0)
+        free(data.comment);
+    return ret;
+}
+
+static int bench_compressed_position(const char *info, size_t len) {
+    (void) len;
+    aprs_compressed_position_t data;
+    int ret = aprs_decode_compressed_position(info, &data);
+    if (ret == 0)
+        aprs_free_compressed_position(&data);
+    return ret;
+}
+
+static int bench_mice(const char *info, size_t len) {
+    aprs_mice_t data;
+    int messageBits;
+    bool ns, longOffset, we;
+    if (aprs_decode_mice_destination("SUSURB", &data, &messageBits, &ns, &longOffset, &we) != 0)
+        return -1;
+    return aprs_decode_mice_info(info, len, &data, longOffset, we);
+}
+
+static int bench_mice_destination(const char *info, size_t len) {
+    (void) len;
+    aprs_mice_t data;
+    int messageBits;
+    bool ns, longOffset, we;
+    return aprs_decode_mice_destination(info, &data, &messageBits, &ns, &longOffset, &we);
+}
+
+static int bench_weather_report(const char *info, size_t len) {
+    (void) len;
+    aprs_weather_report_t data;
+    return aprs_decode_weather_report(info, &data);
+}
+
+static int bench_position_weather(const char *info, size_t len) {
+    (void) len;
+    aprs_position_no_ts_t pos;
+    aprs_weather_report_t data;
+    memset(&pos, 0, sizeof(pos));
+    pos.symbol_code = '_';
+    pos.comment = (char*) info;
+    return aprs_decode_position_weather(&pos, &data);
+}
+
+static int bench_peet1(const char *info, size_t len) {
+    (void) len;
+    aprs_weather_report_t data;
+    return aprs_decode_peet1(info, &data);
+}
+
+static int bench_peet2(const char *info, size_t len) {
+    (void) len;
+    aprs_weather_report_t data;
+    return aprs_decode_peet2(info, &data);
+}
+
+static int bench_message(const char *info, size_t len) {
+    (void) len;
+    aprs_message_t data;
+    int ret = aprs_decode_message(info, &data);
+    if (ret == 0) {
+        free(data.message);
+        free(data.message_number);
+    }
+    return ret;
+}
+
+static int bench_object_report(const char *info, size_t len) {
+    (void) len;
+    aprs_object_report_t data;
+    int ret = aprs_decode_object_report(info, &data);
+    if (ret == 0)
+        free(data.comment);
+    return ret;
+}
+
+static int bench_item_report(const char *info, size_t len) {
+    (void) len;
+    aprs_item_report_t data;
+    int ret = aprs_decode_item_report(info, &data);
+    if (ret == 0)
+        free(data.comment);
+    return ret;
+}
+
+static int bench_telemetry(const char *info, size_t len) {
+    (void) len;
+    aprs_telemetry_t data;
+    return aprs_decode_telemetry(info, &data);
+}
+
+static int bench_status(const char *info, size_t len) {
+    (void) len;
+    aprs_status_t data;
+    return aprs_decode_status(info, &data);
+}
+
+static int bench_general_query(const char *info, size_t len) {
+    (void) len;
+    aprs_general_query_t data;
+    return aprs_decode_general_query(info, &data);
+}
+
+static int bench_station_capabilities(const char *info, size_t len) {
+    (void) len;
+    aprs_station_capabilities_t data;
+    return aprs_decode_station_capabilities(info, &data);
+}
+
+static int bench_raw_gps(const char *info, size_t len) {
+    (void) len;
+    aprs_raw_gps_t data;
+    int ret = aprs_decode_raw_gps(info, &data);
+    if (ret == 0)
+        free(data.raw_data);
+    return ret;
+}
+
+static int bench_grid_square(const char *info, size_t len) {
+    (void) len;
+    aprs_grid_square_t data;
+    int ret = aprs_decode_grid_square(info, &data);
+    if (ret == 0)
+        free(data.comment);
+    return ret;
+}
+
+static int bench_test_packet(const char *info, size_t len) {
+    (void) len;
+    aprs_test_packet_t data;
+    int ret = aprs_decode_test_packet(info, &data);
+    if (ret == 0)
+        free(data.data);
+    return ret;
+}
+
+static int bench_df_report(const char *info, size_t len) {
+    (void) len;
+    aprs_df_report_t data;
+    return aprs_decode_df_report(info, &data);
+}
+
+static int bench_agrelo_df(const char *info, size_t len) {
+    (void) len;
+    aprs_agrelo_df_t data;
+    return aprs_decode_agrelo_df(info, &data);
+}
+
+static int bench_user_defined(const char *info, size_t len) {
+    (void) len;
+    aprs_user_defined_format_t data;
+    return aprs_decode_user_defined(info, &data);
+}
+
+static int bench_third_party(const char *info, size_t len) {
+    (void) len;
+    static aprs_third_party_packet_t data;
+    return aprs_decode_third_party(info, &data);
+}
+
+static const char bench_mice_info[] = { 0x60, 0x43, 0x46, 0x22, 0x1C, 0x1F, 0x21, 0x5B, 0x2F, 0x3A, 0x60, 0x22, 0x33, 0x7A, 0x7D, 0x5F, 0x20, 0 };
+
+static char bench_compressed_info[64];
+
+static bench_aprs_case_t bench_aprs_cases[] = {
+    { "position_no_ts", "!4903.50N/07201.75W-Test /A=001234", 0, bench_position_no_ts },
+    { "position_with_ts", "@092345z4903.50N/07201.75W-Test", 0, bench_position_with_ts },
+    { "compressed_position", bench_compressed_info, 0, bench_compressed_position },
+    { "mice_destination", "SUSURB", 0, bench_mice_destination },
+    { "mice_info", bench_mice_info, sizeof(bench_mice_info) - 1, bench_mice },
+    { "weather_report", "_10090556c220s004g005t077r000p000P000h50b09900wRSW", 0, bench_weather_report },
+    { "position_weather", "c360s004t071g015r000p033P002h54b10001", 0, bench_position_weather },
+    { "peet1", "#W1c360s004g015t071r000p033P002h54b10001", 0, bench_peet1 },
+    { "peet2", "*W2c360s004g015t071r000p033P002h54b10001", 0, bench_peet2 },
+    { "message", ":WB2OSZ-7 :Hello{001}", 0, bench_message },
+    { "object_report", ";LEADER   *092345z4903.50N/07201.75W>", 0, bench_object_report },
+    { "item_report", ")ITEM1    !3746.49N/12225.16W>Test item", 0, bench_item_report },
+    { "telemetry", "T#001,123,045,067,089,100,00000000", 0, bench_telemetry },
+    { "status", ">092345zTest status", 0, bench_status },
+    { "general_query", "?APRS?", 0, bench_general_query },
+    { "station_capabilities", "<IGATE,MSG_CNT=43,LOC_CNT=14", 0, bench_station_capabilities },
+    { "raw_gps", "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47", 0, bench_raw_gps },
+    { "grid_square", "[JJ00 Test location", 0, bench_grid_square },
+    { "test_packet", ",TEST123", 0, bench_test_packet },
+    { "df_report", "!4930.00N/07245.00W\\088/036/270/729 DF test DFS5132", 0, bench_df_report },
+    { "agrelo_df", "%123/5", 0, bench_agrelo_df },
+    { "user_defined", "{XYCUSTOM_PAYLOAD", 0, bench_user_defined },
+    { "third_party", "}SRC>DEST,PATH1,PATH2:A>B:HELLO_WORLD", 0, bench_third_party },
+};
+
+static void bench_decode(void *ctx, uint64_t iterations) {
+    bench_aprs_case_t *c = ctx;
+    int sum = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        sum += c->decode(c->info, c->len);
+    }
+    bench_sink = sum;
+}
+
+// Whole corpus, each packet decoded by the decoder for its data type identifier as a receiver
+// would pick it. Mic-E packets also decode their destination address.
+typedef struct {
+    const bench_aprs_packet_t *packets[64];
+    size_t len[64];
+    bench_aprs_decode_fn_t decode[64];
+    int count;
+    int bytes;
+} bench_aprs_mix_t;
+
+static int bench_mix_decode(const bench_aprs_packet_t *packet, size_t len, bench_aprs_decode_fn_t decode) {
+    if (decode != bench_mice)
+        return decode(packet->info, len);
+
+    aprs_mice_t data;
+    int messageBits;
+    bool ns, longOffset, we;
+    if (aprs_decode_mice_destination(packet->dest, &data, &messageBits, &ns, &longOffset, &we) != 0)
+        return -1;
+    return aprs_decode_mice_info(packet->info, len, &data, longOffset, we);
+}
+
+static void bench_decode_mix(void *ctx, uint64_t iterations) {
+    bench_aprs_mix_t *m = ctx;
+    int sum = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        for (int i = 0; i < m->count; i++) {
+            sum += bench_mix_decode(m->packets[i], m->len[i], m->decode[i]);
+        }
+    }
+    bench_sink = sum;
+}
+
+static bench_aprs_decode_fn_t bench_aprs_dispatch(const bench_aprs_packet_t *packet) {
+    switch (packet->info[0]) {
+        case '`':
+        case '\'':
+            return bench_mice;
+        case '!':
+        case '=':
+            return bench_position_no_ts;
+        case '@':
+        case '/':
+            return bench_position_with_ts;
+        case '_':
+            return bench_weather_report;
+        case ':':
+            return bench_message;
+        case ';':
+            return bench_object_report;
+        case '>':
+            return bench_status;
+        case 'T':
+            return bench_telemetry;
+        default:
+            return NULL;
+    }
+}
+
+void bench_aprs_main(void) {
+    aprs_compressed_position_t pos = { .latitude = 49.0583, .longitude = -72.0292, .symbol_table = '/', .symbol_code = '>', .comment = NULL, .dti =
+    APRS_DTI_POSITION_NO_TS_NO_MSG, .has_course_speed = true, .course = 88, .speed = 36, .has_altitude = false, .altitude = INT_MIN };
+    aprs_encode_compressed_position(bench_compressed_info, sizeof(bench_compressed_info), &pos);
+
+    char name[64];
+    for (size_t i = 0; i < sizeof(bench_aprs_cases) / sizeof(bench_aprs_cases[0]); i++) {
+        bench_aprs_case_t *c = &bench_aprs_cases[i];
+        if (c->len == 0)
+            c->len = strlen(c->info);
+        snprintf(name, sizeof(name), "aprs_decode_%s", c->name);
+        if (c->decode(c->info, c->len) != 0) {
+            bench_skip("aprs", name, "input rejected by the decoder");
+            continue;
+        }
+        bench_run("aprs", name, bench_decode, c, c->len, 1);
+    }
+
+    static bench_aprs_mix_t mix;
+    mix.count = 0;
+    mix.bytes = 0;
+    for (int i = 0; i < bench_aprs_corpus_len && mix.count < 64; i++) {
+        const bench_aprs_packet_t *packet = &bench_aprs_corpus[i];
+        bench_aprs_decode_fn_t decode = bench_aprs_dispatch(packet);
+        size_t len = strlen(packet->info);
+        if (decode == NULL || bench_mix_decode(packet, len, decode) != 0) {
+            bench_skip("aprs", "corpus", packet->info);
+            continue;
+        }
+        mix.packets[mix.count] = packet;
+        mix.decode[mix.count] = decode;
+        mix.len[mix.count] = len;
+        mix.bytes += len;
+        mix.count++;
+    }
+    bench_run("aprs", "corpus", bench_decode_mix, &mix, mix.bytes, mix.count);
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ax25.h"
+#include "bench_common.h"
+#include "bench_ax25.h"
+
+#define BENCH_AX25_INFO "!4903.50N/07201.75W-Test /A=001234 mobile on the interstate, 146.520MHz simplex"
+
+// Raw AX.25 frame of one type: address field N0CALL <- N1CALL-1, control, then PID and info
+typedef struct {
+    const char *name;
+    int modulo128;
+    uint8_t control[4]; // Control field, PID or FRMR information
+    int controlLen;
+    const uint8_t *payload;
+    int payloadLen;
+    uint8_t frame[BENCH_MAX_FRAME];
+    int len;
+    ax25_frame_t *decoded;
+} bench_ax25_case_t;
+
+static const uint8_t bench_ax25_address[] = { 0x9C, 0x60, 0x86, 0x82, 0x98, 0x98, 0xE0, 0x9C, 0x62, 0x86, 0x82, 0x98, 0x98, 0x63 };
+
+static const uint8_t bench_ax25_xid[] = { 0x82, 0x80, 0x00, 0x17, 0x02, 0x02, 0x00, 0x21, 0x03, 0x03, 0x86, 0xA8, 0x02, 0x06, 0x02, 0x04, 0x00, 0x08,
+        0x01, 0x07, 0x09, 0x02, 0x0B, 0xB8, 0x0A, 0x01, 0x0A };
+
+static const uint8_t bench_ax25_test[] = "TEST 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+#define BENCH_INFO .payload = (const uint8_t*) BENCH_AX25_INFO, .payloadLen = (int) (sizeof(BENCH_AX25_INFO) - 1)
+
+static bench_ax25_case_t bench_ax25_cases[] = {
+    { .name = "ui", .modulo128 = MODULO128_FALSE, .control = { 0x03, 0xF0 }, .controlLen = 2, BENCH_INFO },
+    { .name = "i_8bit", .modulo128 = MODULO128_FALSE, .control = { 0x24, 0xF0 }, .controlLen = 2, BENCH_INFO },
+    { .name = "i_16bit", .modulo128 = MODULO128_TRUE, .control = { 0x04, 0x06, 0xF0 }, .controlLen = 3, BENCH_INFO },
+    { .name = "rr_8bit", .modulo128 = MODULO128_FALSE, .control = { 0x41 }, .controlLen = 1 },
+    { .name = "rnr_8bit", .modulo128 = MODULO128_FALSE, .control = { 0x45 }, .controlLen = 1 },
+    { .name = "rej_8bit", .modulo128 = MODULO128_FALSE, .control = { 0x49 }, .controlLen = 1 },
+    { .name = "srej_8bit", .modulo128 = MODULO128_FALSE, .control = { 0x4D }, .controlLen = 1 },
+    { .name = "rr_16bit", .modulo128 = MODULO128_TRUE, .control = { 0x01, 0x0A }, .controlLen = 2 },
+    { .name = "rnr_16bit", .modulo128 = MODULO128_TRUE, .control = { 0x05, 0x0A }, .controlLen = 2 },
+    { .name = "rej_16bit", .modulo128 = MODULO128_TRUE, .control = { 0x09, 0x0A }, .controlLen = 2 },
+    { .name = "srej_16bit", .modulo128 = MODULO128_TRUE, .control = { 0x0D, 0x0A }, .controlLen = 2 },
+    { .name = "sabm", .modulo128 = MODULO128_FALSE, .control = { 0x3F }, .controlLen = 1 },
+    { .name = "sabme", .modulo128 = MODULO128_FALSE, .control = { 0x7F }, .controlLen = 1 },
+    { .name = "disc", .modulo128 = MODULO128_FALSE, .control = { 0x53 }, .controlLen = 1 },
+    { .name = "dm", .modulo128 = MODULO128_FALSE, .control = { 0x1F }, .controlLen = 1 },
+    { .name = "ua", .modulo128 = MODULO128_FALSE, .control = { 0x73 }, .controlLen = 1 },
+    { .name = "frmr", .modulo128 = MODULO128_FALSE, .control = { 0x97, 0x24, 0x42, 0x01 }, .controlLen = 4 },
+    { .name = "xid", .modulo128 = MODULO128_FALSE, .control = { 0xBF }, .controlLen = 1, .payload = bench_ax25_xid, .payloadLen = (int) sizeof(bench_ax25_xid) },
+    { .name = "test", .modulo128 = MODULO128_FALSE, .control = { 0xF3 }, .controlLen = 1, .payload = bench_ax25_test, .payloadLen = (int) sizeof(bench_ax25_test) - 1 },
+};
+
+static void bench_decode(void *ctx, uint64_t iterations) {
+    bench_ax25_case_t *c = ctx;
+    uint8_t err = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        ax25_frame_t *frame = ax25_frame_decode(c->frame, c->len, c->modulo128, &err);
+        bench_sink = (uintptr_t) frame;
+        ax25_frame_free(frame, &err);
+    }
+}
+
+static void bench_decode_into(void *ctx, uint64_t iterations) {
+    bench_ax25_case_t *c = ctx;
+    static ax25_frame_storage_t storage;
+    uint8_t err = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        bench_sink = (uintptr_t) ax25_frame_decode_into(c->frame, c->len, c->modulo128, &storage, &err);
+    }
+}
+
+static void bench_decode_arena(void *ctx, uint64_t iterations) {
+    bench_ax25_case_t *c = ctx;
+    static unsigned char buffer[4096];
+    mem_arena_t arena;
+    uint8_t err = 0;
+    mem_arena_init(&arena, buffer, sizeof(buffer));
+    for (uint64_t it = 0; it < iterations; it++) {
+        bench_sink = (uintptr_t) ax25_frame_decode_arena(c->frame, c->len, c->modulo128, &arena, &err);
+        mem_arena_reset(&arena);
+    }
+}
+
+static void bench_decode_pool(void *ctx, uint64_t iterations) {
+    bench_ax25_case_t *c = ctx;
+    static ax25_frame_pool_slot_t slots[4];
+    ax25_frame_pool_t pool;
+    uint8_t err = 0;
+    ax25_frame_pool_init(&pool, slots, 4);
+    for (uint64_t it = 0; it < iterations; it++) {
+        ax25_frame_t *frame = ax25_frame_pool_decode(&pool, c->frame, c->len, c->modulo128, &err);
+        bench_sink = (uintptr_t) frame;
+        ax25_frame_pool_free(&pool, frame, &err);
+    }
+}
+
+static void bench_encode(void *ctx, uint64_t iterations) {
+    bench_ax25_case_t *c = ctx;
+    uint8_t err = 0;
+    size_t len = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        uint8_t *buf = ax25_frame_encode(c->decoded, &len, &err);
+        bench_sink = (uintptr_t) buf;
+        free(buf);
+    }
+}
+
+static void bench_encode_into(void *ctx, uint64_t iterations) {
+    bench_ax25_case_t *c = ctx;
+    uint8_t buf[BENCH_MAX_FRAME];
+    uint8_t err = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        bench_sink = ax25_frame_encode_into(c->decoded, buf, sizeof(buf), &err);
+    }
+}
+
+void bench_ax25_main(void) {
+    static ax25_frame_storage_t storage;
+    char name[64];
+
+    for (size_t i = 0; i < sizeof(bench_ax25_cases) / sizeof(bench_ax25_cases[0]); i++) {
+        bench_ax25_case_t *c = &bench_ax25_cases[i];
+        uint8_t err = 0;
+
+        memcpy(c->frame, bench_ax25_address, sizeof(bench_ax25_address));
+        c->len = sizeof(bench_ax25_address);
+        memcpy(c->frame + c->len, c->control, c->controlLen);
+        c->len += c->controlLen;
+        if (c->payload) {
+            memcpy(c->frame + c->len, c->payload, c->payloadLen);
+            c->len += c->payloadLen;
+        }
+
+        c->decoded = ax25_frame_decode(c->frame, c->len, c->modulo128, &err);
+        if (c->decoded == NULL) {
+            snprintf(name, sizeof(name), "ax25_frame_decode/%s", c->name);
+            bench_skip("ax25", name, "frame rejected by the decoder");
+            continue;
+        }
+
+        snprintf(name, sizeof(name), "ax25_frame_decode/%s", c->name);
+        bench_run("ax25", name, bench_decode, c, c->len, 1);
+        snprintf(name, sizeof(name), "ax25_frame_decode_arena/%s", c->name);
+        bench_run("ax25", name, bench_decode_arena, c, c->len, 1);
+        snprintf(name, sizeof(name), "ax25_frame_pool_decode/%s", c->name);
+        bench_run("ax25", name, bench_decode_pool, c, c->len, 1);
+        if (ax25_frame_decode_into(c->frame, c->len, c->modulo128, &storage, &err) != NULL) {
+            snprintf(name, sizeof(name), "ax25_frame_decode_into/%s", c->name);
+            bench_run("ax25", name, bench_decode_into, c, c->len, 1);
+        } else {
+            snprintf(name, sizeof(name), "ax25_frame_decode_into/%s", c->name);
+            bench_skip("ax25", name, "frame type not supported");
+        }
+        snprintf(name, sizeof(name), "ax25_frame_encode/%s", c->name);
+        bench_run("ax25", name, bench_encode, c, c->len, 1);
+        snprintf(name, sizeof(name), "ax25_frame_encode_into/%s", c->name);
+        bench_run("ax25", name, bench_encode_into, c, c->len, 1);
+
+        ax25_frame_free(c->decoded, &err);
+        c->decoded = NULL;
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "bench_common.h"
+
+volatile uintptr_t bench_sink;
+
+static const char *bench_filter = NULL;
+
+// Traffic seen on a busy APRS channel: mostly positions and Mic-E trackers, then weather
+// stations, messages, objects, status and telemetry
+const bench_aprs_packet_t bench_aprs_corpus[] = {
+    { "position", "APRS", "!4903.50N/07201.75W-Test /A=001234" },
+    { "position", "APDW16", "=3746.49N/12225.16W>Mobile 146.520MHz" },
+    { "position", "APRS", "@092345z4903.50N/07201.75W>088/036 Heading north" },
+    { "position", "APN391", "!3318.00N/11205.00W#PHG5360 W1 digi, Phoenix AZ" },
+    { "mic-e", "SUSURB", "`CF\"\x1c\x1f![/:`\"3z}_ " },
+    { "mic-e", "S32U6T", "`x(2l\"Oj/]Kenwood TM-D710 =" },
+    { "mic-e", "T2SP0W", "`j;Dl!0>/`\"4T}146.940MHz T100 -060_%" },
+    { "weather", "APRS", "_10090556c220s004g005t077r000p000P000h50b09900wRSW" },
+    { "weather", "APRS", "@092345z4903.50N/07201.75W_220/004g005t077r000p000P000h50b09900" },
+    { "message", "APRS", ":WB2OSZ-7 :Hello{001}" },
+    { "message", "APRS", ":N0CALL-9 :Meet at the repeater site at 1900 local{42" },
+    { "message", "APRS", ":BLN1     :Net tonight 2000z on 146.940" },
+    { "object", "APRS", ";LEADER   *092345z4903.50N/07201.75W>" },
+    { "status", "APRS", ">092345zNet control, monitoring 146.520" },
+    { "telemetry", "APRS", "T#001,123,045,067,089,100,00000000" },
+};
+
+const int bench_aprs_corpus_len = (int) (sizeof(bench_aprs_corpus) / sizeof(bench_aprs_corpus[0]));
+
+void bench_set_filter(const char *filter) {
+    bench_filter = filter;
+}
+
+void bench_print_header(void) {
+    printf("group,name,iterations,frames,ns_per_frame,mb_per_s\n");
+}
+
+static uint64_t bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static bool bench_selected(const char *group, const char *name) {
+    char full[128];
+    snprintf(full, sizeof(full), "%s/%s", group, name);
+    return bench_filter == NULL || strstr(full, bench_filter) != NULL;
+}
+
+void bench_skip(const char *group, const char *name, const char *reason) {
+    if (bench_selected(group, name))
+        printf("# %s,%s skipped: %s\n", group, name, reason);
+}
+
+void bench_run(const char *group, const char *name, bench_fn_t fn, void *ctx, double bytes, int frames) {
+    if (!bench_selected(group, name))
+        return;
+
+    // Warm up caches and lazy tables, then grow the iteration count to a full sample
+    uint64_t iterations = 1;
+    fn(ctx, 1);
+    for (;;) {
+        uint64_t start = bench_now();
+        fn(ctx, iterations);
+        if (bench_now() - start >= BENCH_SAMPLE_NS / 4)
+            break;
+        iterations *= 2;
+    }
+    iterations *= 4;
+
+    uint64_t best = UINT64_MAX;
+    for (int s = 0; s < BENCH_SAMPLES; s++) {
+        uint64_t start = bench_now();
+        fn(ctx, iterations);
+        uint64_t elapsed = bench_now() - start;
+        if (elapsed < best)
+            best = elapsed;
+    }
+
+    double nsPerIteration = (double) best / (double) iterations;
+    double mbPerS = (bytes > 0) ? bytes * 1000.0 / nsPerIteration : 0.0;
+    printf("%s,%s,%llu,%d,%.2f,%.2f\n", group, name, (unsigned long long) iterations, frames, nsPerIteration / frames, mbPerS);
+    fflush(stdout);
+}
+
+// Appends a callsign-SSID address, ch is the command/has-been-repeated bit
+static int bench_address(unsigned char *out, const char *call, int ssid, int ch, int last) {
+    int i = 0;
+    for (; i < 6 && call[i]; i++) {
+        out[i] = (unsigned char) (call[i] << 1);
+    }
+    for (; i < 6; i++) {
+        out[i] = ' ' << 1;
+    }
+    out[6] = (unsigned char) ((ch << 7) | 0x60 | (ssid << 1) | last);
+    return 7;
+}
+
+int bench_ui_frame(const bench_aprs_packet_t *packet, unsigned char *frame) {
+    int len = 0;
+    len += bench_address(frame + len, packet->dest, 0, 1, 0);
+    len += bench_address(frame + len, "N0CALL", 9, 0, 0);
+    len += bench_address(frame + len, "WIDE1", 1, 0, 0);
+    len += bench_address(frame + len, "WIDE2", 1, 0, 1);
+    frame[len++] = 0x03;
+    frame[len++] = 0xF0;
+
+    int infoLen = (int) strlen(packet->info);
+    if (infoLen > BENCH_MAX_FRAME - len)
+        infoLen = BENCH_MAX_FRAME - len;
+    memcpy(frame + len, packet->info, infoLen);
+    return len + infoLen;
+}
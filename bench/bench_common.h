@@ -0,0 +1,99 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BENCH_COMMON_H_
+#define BENCH_COMMON_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BENCH_SAMPLE_NS  20000000ULL ///< Minimum duration of one timed sample, in nanoseconds
+#define BENCH_SAMPLES    5           ///< Timed samples per benchmark, the fastest one is reported
+#define BENCH_MAX_FRAME  330         ///< Largest AX.25 frame built from the corpus, in bytes
+
+/**
+ * @brief Benchmark body: runs the measured operation iterations times.
+ */
+typedef void (*bench_fn_t)(void *ctx, uint64_t iterations);
+
+/**
+ * @brief APRS packet of the benchmark corpus.
+ */
+typedef struct {
+    const char *kind; ///< Packet family: position, mic-e, weather, message...
+    const char *dest; ///< AX.25 destination callsign (carries the Mic-E latitude)
+    const char *info; ///< APRS information field
+} bench_aprs_packet_t;
+
+extern const bench_aprs_packet_t bench_aprs_corpus[];
+extern const int bench_aprs_corpus_len;
+
+/**
+ * @brief Results are written here so the compiler cannot drop the measured work.
+ */
+extern volatile uintptr_t bench_sink;
+
+/**
+ * @brief Only runs the benchmarks whose "group/name" contains filter (NULL for all).
+ */
+void bench_set_filter(const char *filter);
+
+/**
+ * @brief Prints the CSV header of the results.
+ */
+void bench_print_header(void);
+
+/**
+ * @brief Calibrates, times and reports one benchmark as a CSV line.
+ *
+ * The iteration count is doubled until a sample lasts BENCH_SAMPLE_NS, then the fastest of
+ * BENCH_SAMPLES samples is reported as nanoseconds per frame and MB/s (10^6 bytes).
+ *
+ * @param group Benchmark group (module).
+ * @param name Benchmark name, usually the function measured and its input.
+ * @param fn Benchmark body.
+ * @param ctx Context passed to fn.
+ * @param bytes Bytes processed by one iteration, 0 if not meaningful.
+ * @param frames Frames processed by one iteration.
+ */
+void bench_run(const char *group, const char *name, bench_fn_t fn, void *ctx, double bytes, int frames);
+
+/**
+ * @brief Reports a benchmark that cannot run as a CSV comment line.
+ *
+ * @param group Benchmark group (module).
+ * @param name Benchmark name.
+ * @param reason Why the benchmark was skipped.
+ */
+void bench_skip(const char *group, const char *name, const char *reason);
+
+/**
+ * @brief Builds an AX.25 UI frame, without FCS, from a corpus packet.
+ *
+ * Source N0CALL-9, path WIDE1-1,WIDE2-1, PID 0xF0.
+ *
+ * @param packet Corpus packet.
+ * @param frame Output buffer, at least BENCH_MAX_FRAME bytes long.
+ * @return Length of the frame in bytes.
+ */
+int bench_ui_frame(const bench_aprs_packet_t *packet, unsigned char *frame);
+
+#endif /* BENCH_COMMON_H_ */
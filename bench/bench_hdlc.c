@@ -0,0 +1,238 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "common.h"
+#include "hdlc.h"
+#include "bench_common.h"
+#include "bench_hdlc.h"
+
+#define BENCH_HDLC_FRAMES     32
+#define BENCH_HDLC_ENCODED    ((BENCH_MAX_FRAME + 2) * 6 / 5 + 4)
+#define BENCH_HDLC_STREAM_LEN (BENCH_HDLC_FRAMES * BENCH_HDLC_ENCODED + 2)
+
+// The corpus as AX.25 frames, in normal and bit-reversed order, and HDLC encoded
+typedef struct {
+    int count;
+    int bytes;
+    unsigned char frames[BENCH_HDLC_FRAMES][BENCH_MAX_FRAME];
+    unsigned char reversed[BENCH_HDLC_FRAMES][BENCH_MAX_FRAME];
+    int lens[BENCH_HDLC_FRAMES];
+    unsigned char encoded[BENCH_HDLC_FRAMES][BENCH_HDLC_ENCODED];
+    unsigned char nrzi[BENCH_HDLC_FRAMES][BENCH_HDLC_ENCODED];
+    int encodedLens[BENCH_HDLC_FRAMES];
+    int nrziLens[BENCH_HDLC_FRAMES];
+    hdlc_frame_desc_t descs[BENCH_HDLC_FRAMES];
+    unsigned char stream[BENCH_HDLC_STREAM_LEN];
+    int streamLen;
+    unsigned char out[BENCH_HDLC_STREAM_LEN];
+} bench_hdlc_ctx_t;
+
+static bench_hdlc_ctx_t bench_ctx;
+
+static unsigned char bench_reverse(unsigned char b) {
+    b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
+    b = (b & 0xCC) >> 2 | (b & 0x33) << 2;
+    b = (b & 0xAA) >> 1 | (b & 0x55) << 1;
+    return b;
+}
+
+static void bench_crc(void *ctx, uint64_t iterations) {
+    bench_hdlc_ctx_t *c = ctx;
+    uintptr_t sum = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        for (int i = 0; i < c->count; i++) {
+            sum += CRC(c->reversed[i], c->lens[i]);
+        }
+    }
+    bench_sink = sum;
+}
+
+static void bench_crc_update(void *ctx, uint64_t iterations) {
+    bench_hdlc_ctx_t *c = ctx;
+    uintptr_t sum = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        for (int i = 0; i < c->count; i++) {
+            crc_ctx_t crc;
+            crc_init(&crc);
+            crc_update(&crc, c->frames[i], c->lens[i]);
+            sum += crc_final(&crc);
+        }
+    }
+    bench_sink = sum;
+}
+
+static void bench_encode(void *ctx, uint64_t iterations) {
+    bench_hdlc_ctx_t *c = ctx;
+    int len = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        for (int i = 0; i < c->count; i++) {
+            hdlc_frame_encode(c->frames[i], c->lens[i], c->out, &len);
+        }
+    }
+    bench_sink = len;
+}
+
+static void bench_encode_fast(void *ctx, uint64_t iterations) {
+    bench_hdlc_ctx_t *c = ctx;
+    int len = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        for (int i = 0; i < c->count; i++) {
+            hdlc_frame_encode_fast(c->frames[i], c->lens[i], c->out, &len);
+        }
+    }
+    bench_sink = len;
+}
+
+static void bench_encode_nrzi(void *ctx, uint64_t iterations) {
+    bench_hdlc_ctx_t *c = ctx;
+    int len = 0;
+    uint8_t level = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        for (int i = 0; i < c->count; i++) {
+            hdlc_frame_encode_nrzi(c->frames[i], c->lens[i], c->out, &len, &level);
+        }
+    }
+    bench_sink = len;
+}
+
+static void bench_encode_batch(void *ctx, uint64_t iterations) {
+    bench_hdlc_ctx_t *c = ctx;
+    int len = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        hdlc_frame_encode_batch(c->descs, c->count, c->out, &len, NULL);
+    }
+    bench_sink = len;
+}
+
+static void bench_decode(void *ctx, uint64_t iterations) {
+    bench_hdlc_ctx_t *c = ctx;
+    int len = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        for (int i = 0; i < c->count; i++) {
+            hdlc_frame_decode(c->encoded[i], c->encodedLens[i], c->out, &len);
+        }
+    }
+    bench_sink = len;
+}
+
+static void bench_decode_fast(void *ctx, uint64_t iterations) {
+    bench_hdlc_ctx_t *c = ctx;
+    int len = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        for (int i = 0; i < c->count; i++) {
+            hdlc_frame_decode_fast(c->encoded[i], c->encodedLens[i], c->out, &len);
+        }
+    }
+    bench_sink = len;
+}
+
+static void bench_decode_nrzi(void *ctx, uint64_t iterations) {
+    bench_hdlc_ctx_t *c = ctx;
+    int len = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        for (int i = 0; i < c->count; i++) {
+            hdlc_frame_decode_nrzi(c->nrzi[i], c->nrziLens[i], c->out, &len, 0);
+        }
+    }
+    bench_sink = len;
+}
+
+static void bench_decode_batch(void *ctx, uint64_t iterations) {
+    bench_hdlc_ctx_t *c = ctx;
+    hdlc_frame_desc_t descs[BENCH_HDLC_FRAMES];
+    int count = 0;
+    for (uint64_t it = 0; it < iterations; it++) {
+        count = hdlc_frame_decode_batch(c->stream, c->streamLen, c->out, sizeof(c->out), descs, BENCH_HDLC_FRAMES, NULL);
+    }
+    bench_sink = count;
+}
+
+static void bench_deframer_frame(const unsigned char *frame, int frameLen, void *ctx) {
+    (void) frame;
+    (void) ctx;
+    bench_sink += frameLen;
+}
+
+static void bench_deframer(void *ctx, uint64_t iterations) {
+    bench_hdlc_ctx_t *c = ctx;
+    static hdlc_deframer_t deframer;
+    hdlc_deframer_init(&deframer, bench_deframer_frame, NULL);
+    for (uint64_t it = 0; it < iterations; it++) {
+        hdlc_deframer_push(&deframer, c->stream, c->streamLen);
+    }
+}
+
+void bench_hdlc_main(void) {
+    bench_hdlc_ctx_t *c = &bench_ctx;
+
+    c->count = (bench_aprs_corpus_len < BENCH_HDLC_FRAMES) ? bench_aprs_corpus_len : BENCH_HDLC_FRAMES;
+    c->bytes = 0;
+    for (int i = 0; i < c->count; i++) {
+        uint8_t level = 0;
+        c->lens[i] = bench_ui_frame(&bench_aprs_corpus[i], c->frames[i]);
+        for (int k = 0; k < c->lens[i]; k++) {
+            c->reversed[i][k] = bench_reverse(c->frames[i][k]);
+        }
+        hdlc_frame_encode_fast(c->frames[i], c->lens[i], c->encoded[i], &c->encodedLens[i]);
+        hdlc_frame_encode_nrzi(c->frames[i], c->lens[i], c->nrzi[i], &c->nrziLens[i], &level);
+        c->descs[i].frame = c->frames[i];
+        c->descs[i].len = c->lens[i];
+        c->bytes += c->lens[i];
+    }
+    hdlc_frame_encode_batch(c->descs, c->count, c->stream, &c->streamLen, NULL);
+    hdlc_frame_desc_t descs[BENCH_HDLC_FRAMES];
+    if (hdlc_frame_decode_batch(c->stream, c->streamLen, c->out, sizeof(c->out), descs, BENCH_HDLC_FRAMES, NULL) != c->count)
+        printf("# hdlc: corpus stream does not decode, results are not meaningful\n");
+
+    static const struct {
+        crc_kernel_t kernel;
+        const char *name;
+    } kernels[] = {
+        { CRC_KERNEL_TABLE, "CRC/table" },
+        { CRC_KERNEL_SLICE8, "CRC/slice8" },
+        { CRC_KERNEL_PCLMUL, "CRC/pclmul" },
+    };
+    crc_kernel_t saved = crc_get_kernel();
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (!crc_set_kernel(kernels[k].kernel)) {
+            bench_skip("hdlc", kernels[k].name, "kernel not supported");
+            continue;
+        }
+        bench_run("hdlc", kernels[k].name, bench_crc, c, c->bytes, c->count);
+    }
+    crc_set_kernel(saved);
+    bench_run("hdlc", "crc_update", bench_crc_update, c, c->bytes, c->count);
+
+    bench_run("hdlc", "hdlc_frame_encode", bench_encode, c, c->bytes, c->count);
+    bench_run("hdlc", "hdlc_frame_encode_fast", bench_encode_fast, c, c->bytes, c->count);
+    bench_run("hdlc", "hdlc_frame_encode_nrzi", bench_encode_nrzi, c, c->bytes, c->count);
+    bench_run("hdlc", "hdlc_frame_encode_batch", bench_encode_batch, c, c->bytes, c->count);
+    bench_run("hdlc", "hdlc_frame_decode", bench_decode, c, c->bytes, c->count);
+    bench_run("hdlc", "hdlc_frame_decode_fast", bench_decode_fast, c, c->bytes, c->count);
+    bench_run("hdlc", "hdlc_frame_decode_nrzi", bench_decode_nrzi, c, c->bytes, c->count);
+    bench_run("hdlc", "hdlc_frame_decode_batch", bench_decode_batch, c, c->bytes, c->count);
+    bench_run("hdlc", "hdlc_deframer_push", bench_deframer, c, c->bytes, c->count);
+}
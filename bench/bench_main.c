@@ -0,0 +1,39 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+
+#include "bench_common.h"
+#include "bench_hdlc.h"
+#include "bench_ax25.h"
+#include "bench_aprs.h"
+
+// Usage: bench [filter]. Results go to stdout as CSV, lines starting with '#' are comments.
+int main(int argc, char **argv) {
+    if (argc > 1)
+        bench_set_filter(argv[1]);
+
+    bench_print_header();
+    bench_hdlc_main();
+    bench_ax25_main();
+    bench_aprs_main();
+    return 0;
+}
@@ -43,24 +43,6 @@
 // Base91 character set for APRS compression
 static const char BASE91_CHARSET[] = "!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
 
-/**
- * Custom strndup implementation for C99.
- * @param s String to duplicate
- * @param n Maximum number of characters to copy
- * @return Pointer to duplicated string or NULL on failure
- */
-static char* my_strndup(const char *s, size_t n) {
-    size_t len;
-    for (len = 0; len < n && s[len] != '\0'; len++)
-        ;
-    char *dup = malloc(len + 1);
-    if (dup) {
-        memcpy(dup, s, len);
-        dup[len] = '\0';
-    }
-    return dup;
-}
-
 double aprs_parse_lat(const char *str, int *ambiguity) {  // MODIFIED
     if (!str || strlen(str) != 8)               // MODIFIED: strict length "DDMM.hhN"
         return NAN;                             // MODIFIED
@@ -267,7 +249,7 @@ char* lon_to_aprs(double lon, int ambiguity) {
     return buf;
 }
 
-int aprs_decode_message(const char *info, aprs_message_t *data) {
+int aprs_decode_message_arena(const char *info, aprs_message_t *data, mem_arena_t *arena) {
     if (info[0] != ':')
         return -1;
     char addressee[10];
@@ -282,7 +264,7 @@ int aprs_decode_message(const char *info, aprs_message_t *data) {
     size_t msg_len = msg_num ? (size_t) (msg_num - message_start) : strlen(message_start);
     if (msg_len > 67)
         return -1;
-    data->message = my_strndup(message_start, msg_len);
+    data->message = mem_strndup(arena, message_start, msg_len);
     if (!data->message)
         return -1;
 
@@ -290,21 +272,21 @@ int aprs_decode_message(const char *info, aprs_message_t *data) {
         const char *msg_num_end = strchr(msg_num, '}');
         if (msg_num_end && msg_num_end > msg_num + 1) {
             size_t num_len = (size_t) (msg_num_end - (msg_num + 1));
-            data->message_number = my_strndup(msg_num + 1, num_len);
+            data->message_number = mem_strndup(arena, msg_num + 1, num_len);
             if (!data->message_number || num_len < 1 || num_len > 5) {  // MODIFIED: accept 1–5 chars
                 if (data->message_number) {
-                    free(data->message_number);
+                    mem_free(arena, data->message_number);
                     data->message_number = NULL;
                 }  // MODIFIED
-                free(data->message);  // MODIFIED
+                mem_free(arena, data->message);  // MODIFIED
                 return -1;  // MODIFIED
             }
             // MODIFIED: ensure message number is alphanumeric only per spec
             for (size_t i = 0; i < num_len; i++) {  // MODIFIED
                 if (!isalnum((unsigned char )data->message_number[i])) {  // MODIFIED
-                    free(data->message_number);  // MODIFIED
+                    mem_free(arena, data->message_number);  // MODIFIED
                     data->message_number = NULL;  // MODIFIED
-                    free(data->message);  // MODIFIED
+                    mem_free(arena, data->message);  // MODIFIED
                     return -1;  // MODIFIED
                 }  // MODIFIED
             }  // MODIFIED
@@ -323,7 +305,7 @@ int aprs_decode_message(const char *info, aprs_message_t *data) {
                             && (data->message[2] == 'j' || data->message[2] == 'J')))) {
         if (!data->message_number) {  // MODIFIED: message number is required for ACK/REJ
             if (data->message) {
-                free(data->message);
+                mem_free(arena, data->message);
                 data->message = NULL;
             }  // MODIFIED
             return -1;  // MODIFIED
@@ -331,20 +313,20 @@ int aprs_decode_message(const char *info, aprs_message_t *data) {
         {
             size_t __n = strlen(data->message_number);  // MODIFIED
             if (__n < 1 || __n > 5) {  // MODIFIED: allow 1–5
-                free(data->message_number);
+                mem_free(arena, data->message_number);
                 data->message_number = NULL;  // MODIFIED
                 if (data->message) {
-                    free(data->message);
+                    mem_free(arena, data->message);
                     data->message = NULL;
                 }  // MODIFIED
                 return -1;  // MODIFIED
             }
             for (size_t __i = 0; __i < __n; ++__i) {  // MODIFIED: alnum only
                 if (!isalnum((unsigned char )data->message_number[__i])) {  // MODIFIED
-                    free(data->message_number);
+                    mem_free(arena, data->message_number);
                     data->message_number = NULL;  // MODIFIED
                     if (data->message) {
-                        free(data->message);
+                        mem_free(arena, data->message);
                         data->message = NULL;
                     }  // MODIFIED
                     return -1;  // MODIFIED
@@ -356,6 +338,10 @@ int aprs_decode_message(const char *info, aprs_message_t *data) {
     return 0;
 }
 
+int aprs_decode_message(const char *info, aprs_message_t *data) {
+    return aprs_decode_message_arena(info, data, NULL);
+}
+
 int aprs_encode_message(char *info, size_t len, const aprs_message_t *data) {
     bool null_found = false;
     for (int i = 0; i < 9; i++) {
@@ -475,7 +461,7 @@ int aprs_encode_position_no_ts(char *out, size_t outlen, const aprs_position_no_
     return (int) idx;
 }
 
-int aprs_decode_position_no_ts(const char *info, aprs_position_no_ts_t *pos) {
+int aprs_decode_position_no_ts_arena(const char *info, aprs_position_no_ts_t *pos, mem_arena_t *arena) {
     if (!info || !pos)
         return -1;
 
@@ -570,7 +556,9 @@ int aprs_decode_position_no_ts(const char *info, aprs_position_no_ts_t *pos) {
     }                                                                                        // MODIFIED
 
     /* Comment is whatever remains after the (optional) extension, untouched */              // MODIFIED
-    pos->comment = (p && *p) ? my_strdup(p) : NULL;                                          // MODIFIED
+    pos->comment = (p && *p) ? mem_strndup(arena, p, strlen(p)) : NULL;  // MODIFIED
+    if (p && *p && !pos->comment)
+        return -1;
 
     // Set ambiguity values (keep per-axis)
     pos->lat_ambiguity = amb_lat;
@@ -587,6 +575,10 @@ int aprs_decode_position_no_ts(const char *info, aprs_position_no_ts_t *pos) {
     return 0;
 }
 
+int aprs_decode_position_no_ts(const char *info, aprs_position_no_ts_t *pos) {
+    return aprs_decode_position_no_ts_arena(info, pos, NULL);
+}
+
 int aprs_encode_weather_report(char *info, size_t len, const aprs_weather_report_t *data) {
     if (!info || !data) {
         return -1;
@@ -761,7 +753,7 @@ int aprs_encode_weather_report(char *info, size_t len, const aprs_weather_report
     return written;
 }
 
-int aprs_decode_weather_report(const char *info, aprs_weather_report_t *data) {
+int aprs_decode_weather_report_arena(const char *info, aprs_weather_report_t *data, mem_arena_t *arena) {
     if (!info || !data)
         return -1;
     const char *wx = info;
@@ -772,7 +764,7 @@ int aprs_decode_weather_report(const char *info, aprs_weather_report_t *data) {
     // 1) Optional position (DTI '!' or '=')
     aprs_position_no_ts_t pos = (aprs_position_no_ts_t ) { 0 };  // MODIFIED: explicit zero-init
     if (*wx == APRS_DTI_POSITION_NO_TS_NO_MSG || *wx == APRS_DTI_POSITION_NO_TS_WITH_MSG) {
-        if (aprs_decode_position_no_ts(wx, &pos) != 0) {
+        if (aprs_decode_position_no_ts_arena(wx, &pos, arena) != 0) {
             return -1;
         }
         data->has_position = true;
@@ -780,6 +772,7 @@ int aprs_decode_weather_report(const char *info, aprs_weather_report_t *data) {
         data->longitude = pos.longitude;            // MODIFIED
         data->symbol_table = pos.symbol_table;      // MODIFIED
         data->symbol_code = pos.symbol_code;        // MODIFIED
+        mem_free(arena, pos.comment);
 
         // Advance wx to start of weather portion (after position block and optional comment)
         const char *after = strchr(wx, '_');
@@ -1022,6 +1015,10 @@ int aprs_decode_weather_report(const char *info, aprs_weather_report_t *data) {
     return 0;
 }
 
+int aprs_decode_weather_report(const char *info, aprs_weather_report_t *data) {
+    return aprs_decode_weather_report_arena(info, data, NULL);
+}
+
 int aprs_encode_object_report(char *dest, size_t len, const aprs_object_report_t *data) {
     size_t pos = 0;
 
@@ -1116,7 +1113,7 @@ int aprs_encode_object_report(char *dest, size_t len, const aprs_object_report_t
     return (int) pos;
 }
 
-int aprs_decode_object_report(const char *info, aprs_object_report_t *data) {
+int aprs_decode_object_report_arena(const char *info, aprs_object_report_t *data, mem_arena_t *arena) {
     const char *p = info;
     char buf[16];
     int dummy_amb;
@@ -1196,7 +1193,7 @@ int aprs_decode_object_report(const char *info, aprs_object_report_t *data) {
     // 11) Comment
     if (*p != '\0') {
         size_t clen = strlen(p) + 1;
-        data->comment = malloc(clen);
+        data->comment = mem_alloc(arena, clen);
         if (!data->comment)
             return -1;
         memcpy(data->comment, p, clen);
@@ -1207,6 +1204,10 @@ int aprs_decode_object_report(const char *info, aprs_object_report_t *data) {
     return 0;
 }
 
+int aprs_decode_object_report(const char *info, aprs_object_report_t *data) {
+    return aprs_decode_object_report_arena(info, data, NULL);
+}
+
 int aprs_encode_position_with_ts(char *info, size_t len, const aprs_position_with_ts_t *data) {
     // Validate inputs
     if (data->dti != '/' && data->dti != '@') {
@@ -1268,7 +1269,7 @@ int aprs_encode_position_with_ts(char *info, size_t len, const aprs_position_wit
     return ret;  // Return length of encoded string
 }
 
-int aprs_decode_position_with_ts(const char *info, aprs_position_with_ts_t *data) {  // MODIFIED
+int aprs_decode_position_with_ts_arena(const char *info, aprs_position_with_ts_t *data, mem_arena_t *arena) {  // MODIFIED
     if (!info || !data)                      // MODIFIED
         return -1;                           // MODIFIED
 
@@ -1342,7 +1343,7 @@ int aprs_decode_position_with_ts(const char *info, aprs_position_with_ts_t *data
     /* Capture remaining text as comment (if any) */  // MODIFIED
     if (*rest) {                              // MODIFIED
         size_t clen = strlen(rest);           // MODIFIED
-        data->comment = (char*) malloc(clen + 1);  // MODIFIED
+        data->comment = (char*) mem_alloc(arena, clen + 1);  // MODIFIED
         if (!data->comment)
             return -1;        // MODIFIED
         memcpy(data->comment, rest, clen + 1);        // MODIFIED
@@ -1358,6 +1359,10 @@ int aprs_decode_position_with_ts(const char *info, aprs_position_with_ts_t *data
     return 0;                                 // MODIFIED
 }
 
+int aprs_decode_position_with_ts(const char *info, aprs_position_with_ts_t *data) {
+    return aprs_decode_position_with_ts_arena(info, data, NULL);
+}
+
 int aprs_parse_weather_field(const char *data, char field_id, char *value, size_t value_len) {
     const char *p = data;
     while (*p) {
@@ -1919,7 +1924,7 @@ int aprs_encode_item_report(char *info, size_t len, const aprs_item_report_t *da
     return (int) pos;
 }
 
-int aprs_decode_item_report(const char *info, aprs_item_report_t *data) {
+int aprs_decode_item_report_arena(const char *info, aprs_item_report_t *data, mem_arena_t *arena) {
     if (!info || !data)
         return -1;
     size_t len = strlen(info);
@@ -2007,13 +2012,13 @@ int aprs_decode_item_report(const char *info, aprs_item_report_t *data) {
     }
 
     if (pos < len) {
-        data->comment = malloc(len - pos + 1);
+        data->comment = mem_alloc(arena, len - pos + 1);
         if (!data->comment)
             return -1;
         memcpy(data->comment, info + pos, len - pos);
         data->comment[len - pos] = '\0';
     } else {
-        data->comment = malloc(1);
+        data->comment = mem_alloc(arena, 1);
         if (!data->comment)
             return -1;
         data->comment[0] = '\0';
@@ -2022,6 +2027,10 @@ int aprs_decode_item_report(const char *info, aprs_item_report_t *data) {
     return 0;
 }
 
+int aprs_decode_item_report(const char *info, aprs_item_report_t *data) {
+    return aprs_decode_item_report_arena(info, data, NULL);
+}
+
 int aprs_encode_test_packet(char *info, size_t len, const aprs_test_packet_t *data) {
     if (len < data->data_len + 2) {  // +1 for DTI, +1 for null terminator
         return -1;
@@ -2135,7 +2144,7 @@ int aprs_encode_raw_gps(char *info, size_t len, const aprs_raw_gps_t *data) {
 
 /* aprs.c */
 
-int aprs_decode_raw_gps(const char *info, aprs_raw_gps_t *data) {                 // MOD: rewritten for NMEA and Ultimeter
+int aprs_decode_raw_gps_arena(const char *info, aprs_raw_gps_t *data, mem_arena_t *arena) {  // MOD: rewritten for NMEA and Ultimeter
     if (!info || !data)
         return -1;                                                // MOD
     size_t total_len = strlen(info);                                              // MOD
@@ -2161,7 +2170,7 @@ int aprs_decode_raw_gps(const char *info, aprs_raw_gps_t *data) {
         }
 
         // Allocate raw_data (without extra leading '$')
-        data->raw_data = (char*) malloc(strlen(p) + 1);                            // MOD
+        data->raw_data = (char*) mem_alloc(arena, strlen(p) + 1);  // MOD
         if (!data->raw_data)
             return -1;                                           // MOD
         strcpy(data->raw_data, p);                                                // MOD
@@ -2210,7 +2219,7 @@ int aprs_decode_raw_gps(const char *info, aprs_raw_gps_t *data) {
             return -1;                                      // MOD
     }
 
-    data->raw_data = (char*) malloc(strlen(p) + 1);                                // MOD
+    data->raw_data = (char*) mem_alloc(arena, strlen(p) + 1);  // MOD
     if (!data->raw_data)
         return -1;                                               // MOD
     strcpy(data->raw_data, p);                                                    // MOD
@@ -2218,6 +2227,10 @@ int aprs_decode_raw_gps(const char *info, aprs_raw_gps_t *data) {
     return 0;                                                                     // MOD
 }
 
+int aprs_decode_raw_gps(const char *info, aprs_raw_gps_t *data) {
+    return aprs_decode_raw_gps_arena(info, data, NULL);
+}
+
 int aprs_encode_grid_square(char *info, size_t len, const aprs_grid_square_t *data) {
     if (data == NULL || len < 1) {
         return -1;
@@ -2243,7 +2256,7 @@ int aprs_encode_grid_square(char *info, size_t len, const aprs_grid_square_t *da
     return total_len;
 }
 
-int aprs_decode_grid_square(const char *info, aprs_grid_square_t *data) {
+int aprs_decode_grid_square_arena(const char *info, aprs_grid_square_t *data, mem_arena_t *arena) {
     if (info == NULL || info[0] != APRS_DTI_GRID_SQUARE) {
         return -1;
     }
@@ -2264,7 +2277,7 @@ int aprs_decode_grid_square(const char *info, aprs_grid_square_t *data) {
     size_t comment_start = space_pos - info + 1;
     size_t comment_len = len - comment_start;
     if (comment_len > 0) {
-        data->comment = malloc(comment_len + 1);
+        data->comment = mem_alloc(arena, comment_len + 1);
         if (!data->comment) {
             return -1;
         }
@@ -2276,7 +2289,11 @@ int aprs_decode_grid_square(const char *info, aprs_grid_square_t *data) {
     return 0;
 }
 
-int aprs_decode_test_packet(const char *info, aprs_test_packet_t *data) {
+int aprs_decode_grid_square(const char *info, aprs_grid_square_t *data) {
+    return aprs_decode_grid_square_arena(info, data, NULL);
+}
+
+int aprs_decode_test_packet_arena(const char *info, aprs_test_packet_t *data, mem_arena_t *arena) {
     if (!info || !data)
         return -1;  // modified: null checks
     // modified: accept old '"' map/test and reserved '&' as test-like payloads
@@ -2285,7 +2302,7 @@ int aprs_decode_test_packet(const char *info, aprs_test_packet_t *data) {
         return -1;
     }
     size_t len = strlen(info + 1);
-    data->data = my_strndup(info + 1, len);
+    data->data = mem_strndup(arena, info + 1, len);
     if (!data->data) {
         return -1;
     }
@@ -2293,6 +2310,10 @@ int aprs_decode_test_packet(const char *info, aprs_test_packet_t *data) {
     return 0;
 }
 
+int aprs_decode_test_packet(const char *info, aprs_test_packet_t *data) {
+    return aprs_decode_test_packet_arena(info, data, NULL);
+}
+
 static void encode_base91(uint32_t value, char *output, int length) {
     for (int i = length - 1; i >= 0; i--) {
         output[i] = BASE91_CHARSET[value % BASE91_SIZE];
@@ -2542,7 +2563,7 @@ int aprs_encode_compressed_position(char *info, size_t len, const aprs_compresse
     return written;
 }
 
-int aprs_decode_compressed_position(const char *info, aprs_compressed_position_t *data) {
+int aprs_decode_compressed_position_arena(const char *info, aprs_compressed_position_t *data, mem_arena_t *arena) {
     if (!info || !data || strlen(info) < 14) {
         return -1;
     }
@@ -2607,7 +2628,7 @@ int aprs_decode_compressed_position(const char *info, aprs_compressed_position_t
     // Extract comment (everything after the 13-character compressed position)
     if (strlen(info) > 14) {
         size_t comment_len = strlen(info) - 14;
-        data->comment = malloc(comment_len + 1);
+        data->comment = mem_alloc(arena, comment_len + 1);
         if (data->comment) {
             strcpy(data->comment, &info[14]);
         }
@@ -2616,6 +2637,10 @@ int aprs_decode_compressed_position(const char *info, aprs_compressed_position_t
     return 0;
 }
 
+int aprs_decode_compressed_position(const char *info, aprs_compressed_position_t *data) {
+    return aprs_decode_compressed_position_arena(info, data, NULL);
+}
+
 bool aprs_is_compressed_position(const char *info) {
     if (!info || strlen(info) < 14) {
         return false;
@@ -2629,7 +2654,10 @@ bool aprs_is_compressed_position(const char *info) {
 
     // Try to decode and see if it succeeds
     aprs_compressed_position_t temp;
-    return aprs_decode_compressed_position(info, &temp) == 0;
+    if (aprs_decode_compressed_position(info, &temp) != 0)
+        return false;
+    aprs_free_compressed_position(&temp);
+    return true;
 }
 
 void aprs_free_compressed_position(aprs_compressed_position_t *data) {
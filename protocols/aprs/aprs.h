@@ -26,6 +26,8 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "common.h"
+
 /** @defgroup aprs_dti Data Type Identifiers (DTIs)
  *  @brief Single-character identifiers that select the APRS information format.
  *  @{
@@ -517,6 +519,15 @@ bool aprs_is_bulletin(const aprs_message_t *msg);
  * @return 0 on success; negative on error.
  */
 int aprs_decode_item_report(const char *info, aprs_item_report_t *data);
+
+/**
+ * @brief Same as aprs_decode_item_report(), with the comment allocated from an arena.
+ * @param info Input NUL-terminated info field.
+ * @param data Output structure; its pointers are released by mem_arena_reset(), not free().
+ * @param arena Arena to allocate from, or NULL to use malloc().
+ * @return 0 on success; negative on error, including an exhausted arena.
+ */
+int aprs_decode_item_report_arena(const char *info, aprs_item_report_t *data, mem_arena_t *arena);
 /** @} */
 
 /** @name Position helpers
@@ -555,6 +566,15 @@ int aprs_encode_position_no_ts(char *info, size_t len, const aprs_position_no_ts
  */
 int aprs_decode_position_no_ts(const char *info, aprs_position_no_ts_t *data);
 
+/**
+ * @brief Same as aprs_decode_position_no_ts(), with the comment allocated from an arena.
+ * @param info Input NUL-terminated info field.
+ * @param data Output structure; its pointers are released by mem_arena_reset(), not free().
+ * @param arena Arena to allocate from, or NULL to use malloc().
+ * @return 0 on success; negative on error, including an exhausted arena.
+ */
+int aprs_decode_position_no_ts_arena(const char *info, aprs_position_no_ts_t *data, mem_arena_t *arena);
+
 /**
  * @brief Encode a position report with timestamp (DTIs '/' or '@').
  * @param info Output buffer.
@@ -572,6 +592,15 @@ int aprs_encode_position_with_ts(char *info, size_t len, const aprs_position_wit
  */
 int aprs_decode_position_with_ts(const char *info, aprs_position_with_ts_t *data);
 
+/**
+ * @brief Same as aprs_decode_position_with_ts(), with the comment allocated from an arena.
+ * @param info Input NUL-terminated info field.
+ * @param data Output structure; its pointers are released by mem_arena_reset(), not free().
+ * @param arena Arena to allocate from, or NULL to use malloc().
+ * @return 0 on success; negative on error, including an exhausted arena.
+ */
+int aprs_decode_position_with_ts_arena(const char *info, aprs_position_with_ts_t *data, mem_arena_t *arena);
+
 /**
  * @brief Parse latitude from "DDMM.mmN/S" text and report ambiguity.
  * @param str        Pointer to latitude string.
@@ -608,6 +637,15 @@ int aprs_encode_message(char *info, size_t len, const aprs_message_t *data);
  * @return 0 on success; negative on error.
  */
 int aprs_decode_message(const char *info, aprs_message_t *data);
+
+/**
+ * @brief Same as aprs_decode_message(), with the message text and number allocated from an arena.
+ * @param info Input NUL-terminated info field.
+ * @param data Output structure; its pointers are released by mem_arena_reset(), not free().
+ * @param arena Arena to allocate from, or NULL to use malloc().
+ * @return 0 on success; negative on error, including an exhausted arena.
+ */
+int aprs_decode_message_arena(const char *info, aprs_message_t *data, mem_arena_t *arena);
 /** @} */
 
 /** @name Weather
@@ -630,6 +668,15 @@ int aprs_encode_weather_report(char *info, size_t len, const aprs_weather_report
  */
 int aprs_decode_weather_report(const char *info, aprs_weather_report_t *data);
 
+/**
+ * @brief Same as aprs_decode_weather_report(), with the scratch position comment allocated from an arena.
+ * @param info Input NUL-terminated info field.
+ * @param data Output weather structure.
+ * @param arena Arena to allocate from, or NULL to use malloc().
+ * @return 0 on success; negative on error, including an exhausted arena.
+ */
+int aprs_decode_weather_report_arena(const char *info, aprs_weather_report_t *data, mem_arena_t *arena);
+
 /**
  * @brief Decode Peet Bros raw weather format #1 (DTI '#').
  * @param info Input NUL-terminated info field.
@@ -692,6 +739,15 @@ int aprs_encode_object_report(char *info, size_t len, const aprs_object_report_t
  * @return 0 on success; negative on error.
  */
 int aprs_decode_object_report(const char *info, aprs_object_report_t *data);
+
+/**
+ * @brief Same as aprs_decode_object_report(), with the comment allocated from an arena.
+ * @param info Input NUL-terminated info field.
+ * @param data Output structure; its pointers are released by mem_arena_reset(), not free().
+ * @param arena Arena to allocate from, or NULL to use malloc().
+ * @return 0 on success; negative on error, including an exhausted arena.
+ */
+int aprs_decode_object_report_arena(const char *info, aprs_object_report_t *data, mem_arena_t *arena);
 /** @} */
 
 /** @name Validation & helpers
@@ -885,6 +941,15 @@ int aprs_encode_test_packet(char *info, size_t len, const aprs_test_packet_t *da
  */
 int aprs_decode_raw_gps(const char *info, aprs_raw_gps_t *data);
 
+/**
+ * @brief Same as aprs_decode_raw_gps(), with the raw payload allocated from an arena.
+ * @param info Input NUL-terminated info field.
+ * @param data Output structure; its pointers are released by mem_arena_reset(), not free().
+ * @param arena Arena to allocate from, or NULL to use malloc().
+ * @return 0 on success; negative on error, including an exhausted arena.
+ */
+int aprs_decode_raw_gps_arena(const char *info, aprs_raw_gps_t *data, mem_arena_t *arena);
+
 /**
  * @brief Decode Maidenhead grid beacon.
  * @param info Input NUL-terminated info field.
@@ -893,6 +958,15 @@ int aprs_decode_raw_gps(const char *info, aprs_raw_gps_t *data);
  */
 int aprs_decode_grid_square(const char *info, aprs_grid_square_t *data);
 
+/**
+ * @brief Same as aprs_decode_grid_square(), with the comment allocated from an arena.
+ * @param info Input NUL-terminated info field.
+ * @param data Output structure; its pointers are released by mem_arena_reset(), not free().
+ * @param arena Arena to allocate from, or NULL to use malloc().
+ * @return 0 on success; negative on error, including an exhausted arena.
+ */
+int aprs_decode_grid_square_arena(const char *info, aprs_grid_square_t *data, mem_arena_t *arena);
+
 /**
  * @brief Decode DF report.
  * @param info Input NUL-terminated info field.
@@ -908,6 +982,15 @@ int aprs_decode_df_report(const char *info, aprs_df_report_t *data);
  * @return 0 on success; negative on error.
  */
 int aprs_decode_test_packet(const char *info, aprs_test_packet_t *data);
+
+/**
+ * @brief Same as aprs_decode_test_packet(), with the payload allocated from an arena.
+ * @param info Input NUL-terminated info field.
+ * @param data Output structure; its pointers are released by mem_arena_reset(), not free().
+ * @param arena Arena to allocate from, or NULL to use malloc().
+ * @return 0 on success; negative on error, including an exhausted arena.
+ */
+int aprs_decode_test_packet_arena(const char *info, aprs_test_packet_t *data, mem_arena_t *arena);
 /** @} */
 
 /** @name Compressed positions
@@ -930,6 +1013,15 @@ int aprs_encode_compressed_position(char *info, size_t len, const aprs_compresse
  */
 int aprs_decode_compressed_position(const char *info, aprs_compressed_position_t *data);
 
+/**
+ * @brief Same as aprs_decode_compressed_position(), with the comment allocated from an arena.
+ * @param info Input NUL-terminated info field.
+ * @param data Output structure; its pointers are released by mem_arena_reset(), not free().
+ * @param arena Arena to allocate from, or NULL to use malloc().
+ * @return 0 on success; negative on error, including an exhausted arena.
+ */
+int aprs_decode_compressed_position_arena(const char *info, aprs_compressed_position_t *data, mem_arena_t *arena);
+
 /**
  * @brief Check whether an info field is a compressed position.
  * @param info Input NUL-terminated info field.
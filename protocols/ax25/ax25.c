@@ -79,6 +79,18 @@ static uint32_t uint_decode(const uint8_t *data, size_t len, bool big_endian, ui
     return value;
 }
 
+static void address_decode_into(const uint8_t *data, ax25_address_t *addr) {
+    for (int i = 0; i < 6; i++) {
+        addr->callsign[i] = (data[i] >> 1) & 0x7F;
+    }
+    addr->callsign[6] = '\0';
+    addr->ssid = (data[6] & 0x1E) >> 1;
+    addr->ch = (data[6] & 0x80) != 0;
+    addr->res1 = (data[6] & 0x40) != 0;  // res1 is bit 6
+    addr->res0 = (data[6] & 0x20) != 0;  // res0 is bit 5
+    addr->extension = (data[6] & 0x01) != 0;
+}
+
 ax25_address_t* ax25_address_decode(const uint8_t *data, uint8_t *err) {
     *err = 0;
     if (data == NULL) {
@@ -90,35 +102,19 @@ ax25_address_t* ax25_address_decode(const uint8_t *data, uint8_t *err) {
         *err = 1; // Memory allocation failure
         return NULL;
     }
-    for (int i = 0; i < 6; i++) {
-        addr->callsign[i] = (data[i] >> 1) & 0x7F;
-    }
-    addr->callsign[6] = '\0';
-    addr->ssid = (data[6] & 0x1E) >> 1;
-    addr->ch = (data[6] & 0x80) != 0;
-    addr->res1 = (data[6] & 0x40) != 0;  // res1 is bit 6
-    addr->res0 = (data[6] & 0x20) != 0;  // res0 is bit 5
-    addr->extension = (data[6] & 0x01) != 0;
+    address_decode_into(data, addr);
     return addr;
 }
 
-ax25_address_t* ax25_address_from_string(const char *str, uint8_t *err) {
-    *err = 0;
+// Parses "CALL-SSID*" into addr. Returns 0 on success or the error code of ax25_address_from_string().
+static uint8_t address_parse(const char *str, ax25_address_t *addr) {
     if (str == NULL) {
-        *err = 2;
-        return NULL;
+        return 2;
     }
 
     size_t total_len = strlen(str);
     if (total_len > 11) { // Allows "REPEATER-1*" exactly
-        *err = 4;
-        return NULL;
-    }
-
-    ax25_address_t *addr = malloc(sizeof(ax25_address_t));
-    if (!addr) {
-        *err = 1;
-        return NULL;
+        return 4;
     }
 
     char callsign[7] = { 0 };
@@ -129,9 +125,7 @@ ax25_address_t* ax25_address_from_string(const char *str, uint8_t *err) {
     if (dash) {
         size_t callsign_len = dash - str;
         if (callsign_len == 0) {
-            *err = 4;
-            free(addr);
-            return NULL;
+            return 4;
         }
         if (callsign_len > 6) {
             callsign_len = 6;
@@ -142,9 +136,7 @@ ax25_address_t* ax25_address_from_string(const char *str, uint8_t *err) {
         const char *ssid_str = dash + 1;
         size_t ssid_len = strlen(ssid_str);
         if (ssid_len == 0) {
-            *err = 4;
-            free(addr);
-            return NULL;
+            return 4;
         }
 
         const char *p = ssid_str;
@@ -155,40 +147,30 @@ ax25_address_t* ax25_address_from_string(const char *str, uint8_t *err) {
             p++;
         }
         if (*p != '\0') {
-            *err = 5;
-            free(addr);
-            return NULL;
+            return 5;
         }
 
         if (p - ssid_str - (ch ? 1 : 0) == 0) {
-            *err = 4;
-            free(addr);
-            return NULL;
+            return 4;
         }
 
         char *endptr;
         ssid = strtol(ssid_str, &endptr, 10);
         if ((ch && endptr != ssid_str + (p - ssid_str - 1)) || (!ch && endptr != p) || ssid < 0 || ssid > 15) {
-            *err = 4;
-            free(addr);
-            return NULL;
+            return 4;
         }
     } else {
         size_t len = strlen(str);
         const char *star = strchr(str, '*');
         if (star) {
             if (star != str + len - 1) {
-                *err = 6;
-                free(addr);
-                return NULL;
+                return 6;
             }
             len = star - str;
             ch = true;
         }
         if (len == 0) {
-            *err = 4;
-            free(addr);
-            return NULL;
+            return 4;
         }
         if (len > 6) {
             len = 6;
@@ -205,20 +187,32 @@ ax25_address_t* ax25_address_from_string(const char *str, uint8_t *err) {
     addr->res0 = true;
     addr->res1 = true;
     addr->extension = false;
-    return addr;
+    return 0;
 }
 
-uint8_t* ax25_address_encode(const ax25_address_t *addr, size_t *len, uint8_t *err) {
-    *err = 0;
-    uint8_t *bytes = malloc(7);
+ax25_address_t* ax25_address_from_string(const char *str, uint8_t *err) {
+    ax25_address_t parsed;
 
-    if (!bytes) {
+    *err = address_parse(str, &parsed);
+    if (*err)
+        return NULL;
+
+    ax25_address_t *addr = malloc(sizeof(ax25_address_t));
+    if (!addr) {
         *err = 1;
         return NULL;
     }
+    *addr = parsed;
 
+    return addr;
+}
+
+static void address_encode_into(const ax25_address_t *addr, uint8_t *bytes) {
+    // Callsigns shorter than 6 characters are padded with spaces
+    bool pad = false;
     for (int i = 0; i < 6; i++) {
-        bytes[i] = (addr->callsign[i] ? addr->callsign[i] : ' ') << 1;
+        pad = pad || !addr->callsign[i];
+        bytes[i] = (pad ? ' ' : addr->callsign[i]) << 1;
     }
 
     bytes[6] = (addr->ssid << 1) & 0x1E;
@@ -230,11 +224,60 @@ uint8_t* ax25_address_encode(const ax25_address_t *addr, size_t *len, uint8_t *e
         bytes[6] |= 0x40;
     if (addr->ch)
         bytes[6] |= 0x80;
+}
+
+uint8_t* ax25_address_encode(const ax25_address_t *addr, size_t *len, uint8_t *err) {
+    *err = 0;
+    uint8_t *bytes = malloc(7);
+
+    if (!bytes) {
+        *err = 1;
+        return NULL;
+    }
+
+    address_encode_into(addr, bytes);
     *len = 7;
 
     return bytes;
 }
 
+ax25_packed_address_t ax25_address_pack_wire(const uint8_t *data) {
+    ax25_packed_address_t packed = 0;
+    for (int i = 0; i < 7; i++) {
+        packed = (packed << 8) | data[i];
+    }
+    return packed;
+}
+
+void ax25_address_unpack_wire(ax25_packed_address_t packed, uint8_t *data) {
+    for (int i = 6; i >= 0; i--) {
+        data[i] = packed & 0xFF;
+        packed >>= 8;
+    }
+}
+
+ax25_packed_address_t ax25_address_pack(const ax25_address_t *addr) {
+    uint8_t bytes[7];
+    address_encode_into(addr, bytes);
+    return ax25_address_pack_wire(bytes);
+}
+
+void ax25_address_unpack(ax25_packed_address_t packed, ax25_address_t *addr) {
+    uint8_t bytes[7];
+    ax25_address_unpack_wire(packed, bytes);
+    address_decode_into(bytes, addr);
+}
+
+ax25_packed_address_t ax25_address_pack_string(const char *str, uint8_t *err) {
+    ax25_address_t parsed;
+
+    *err = address_parse(str, &parsed);
+    if (*err)
+        return 0;
+
+    return ax25_address_pack(&parsed);
+}
+
 ax25_address_t* ax25_address_copy(const ax25_address_t *addr, uint8_t *err) {
     *err = 0;
     ax25_address_t *copy = malloc(sizeof(ax25_address_t));
@@ -301,67 +344,66 @@ void ax25_path_free(ax25_path_t *path, uint8_t *err) {
     free(path);
 }
 
-header_decode_result_t ax25_frame_header_decode(const uint8_t *data, size_t len, uint8_t *err) {
-    *err = 0;
-    header_decode_result_t result = { NULL, data, len };
-    ax25_address_t *addresses[2 + MAX_REPEATERS];
+// Parses the address field into a caller-provided header. Returns the length of the address
+// field in bytes, or 0 with *err set if the field is invalid.
+static size_t header_decode_into(const uint8_t *data, size_t len, ax25_frame_header_t *header, uint8_t *err) {
     int addr_count = 0;
     size_t pos = 0;
+    bool last = false;
 
     // Parse addresses until extension bit is set or max repeaters reached
     while (pos + 7 <= len && addr_count < 2 + MAX_REPEATERS) {
-        addresses[addr_count] = ax25_address_decode(data + pos, err);
-        if (addresses[addr_count] == NULL) {
-            *err = 2; // Invalid address format
-            for (int i = 0; i < addr_count; i++)
-                ax25_address_free(addresses[i], err);
-            return result;
-        }
+        ax25_address_t *addr = (addr_count == 0) ? &header->destination : (addr_count == 1) ? &header->source :
+                               &header->repeaters.repeaters[addr_count - 2];
+        address_decode_into(data + pos, addr);
         pos += 7;
         addr_count++;
+        last = addr->extension;
         // Continue parsing if fewer than 2 addresses or extension bit is 0
-        if (addr_count >= 2 && addresses[addr_count - 1]->extension)
+        if (addr_count >= 2 && last)
             break;
     }
 
     // Check for minimum address requirement (destination + source)
     if (addr_count < 2) {
         *err = 4; // Too few addresses
-        for (int i = 0; i < addr_count; i++)
-            ax25_address_free(addresses[i], err);
-        return result;
+        return 0;
     }
 
     // Check if last address has extension bit set (required for termination)
-    if (!addresses[addr_count - 1]->extension) {
+    if (!last) {
         *err = 5; // Last address doesn't have extension bit set
-        for (int i = 0; i < addr_count; i++)
-            ax25_address_free(addresses[i], err);
+        return 0;
+    }
+
+    header->cr = (header->destination.ch && !header->source.ch);
+    header->src_cr = header->source.ch;
+    header->repeaters.num_repeaters = addr_count - 2;
+
+    return pos;
+}
+
+header_decode_result_t ax25_frame_header_decode(const uint8_t *data, size_t len, uint8_t *err) {
+    *err = 0;
+    header_decode_result_t result = { NULL, data, len };
+    ax25_frame_header_t parsed;
+
+    if (data == NULL) {
+        *err = 2; // Invalid address format
         return result;
     }
 
+    size_t pos = header_decode_into(data, len, &parsed, err);
+    if (pos == 0)
+        return result;
+
     // Allocate header
     ax25_frame_header_t *header = malloc(sizeof(ax25_frame_header_t));
     if (!header) {
         *err = 6; // Memory allocation failure
-        for (int i = 0; i < addr_count; i++)
-            ax25_address_free(addresses[i], err);
         return result;
     }
-
-    // Populate header fields
-    header->destination = *addresses[0];
-    header->source = *addresses[1];
-    header->cr = (header->destination.ch && !header->source.ch);
-    header->src_cr = header->source.ch;
-    header->repeaters.num_repeaters = addr_count - 2;
-    for (int i = 0; i < header->repeaters.num_repeaters; i++) {
-        header->repeaters.repeaters[i] = *addresses[i + 2];
-    }
-
-    // Free temporary addresses
-    for (int i = 0; i < addr_count; i++)
-        ax25_address_free(addresses[i], err);
+    *header = parsed;
 
     result.header = header;
     result.remaining = data + pos;
@@ -370,44 +412,40 @@ header_decode_result_t ax25_frame_header_decode(const uint8_t *data, size_t len,
     return result;
 }
 
-uint8_t* ax25_frame_header_encode(const ax25_frame_header_t *header, size_t *len, uint8_t *err) {
-    *err = 0;
-    size_t total_len = 7 * (2 + header->repeaters.num_repeaters);
-    uint8_t *bytes = malloc(total_len);
-    if (!bytes) {
-        *err = 1;
-        return NULL;
-    }
-
+// Writes the address field for header into bytes, which must hold 7 * (2 + num_repeaters) bytes
+static void header_encode_into(const ax25_frame_header_t *header, uint8_t *bytes) {
     size_t offset = 0;
     ax25_address_t dest = header->destination;
     dest.extension = false;
     dest.ch = header->cr; // Command: ch=1, Response: ch=0
-    size_t dest_len;
-    uint8_t *dest_bytes = ax25_address_encode(&dest, &dest_len, err);
-    memcpy(bytes + offset, dest_bytes, dest_len);
-    offset += dest_len;
-    free(dest_bytes);
+    address_encode_into(&dest, bytes + offset);
+    offset += 7;
 
     ax25_address_t src = header->source;
     src.extension = (header->repeaters.num_repeaters == 0);
     src.ch = !header->cr; // Command: ch=0, Response: ch=1
-    size_t src_len;
-    uint8_t *src_bytes = ax25_address_encode(&src, &src_len, err);
-    memcpy(bytes + offset, src_bytes, src_len);
-    offset += src_len;
-    free(src_bytes);
+    address_encode_into(&src, bytes + offset);
+    offset += 7;
 
     for (int i = 0; i < header->repeaters.num_repeaters; i++) {
         ax25_address_t rpt = header->repeaters.repeaters[i];
         rpt.extension = (i == header->repeaters.num_repeaters - 1);
-        size_t rpt_len;
-        uint8_t *rpt_bytes = ax25_address_encode(&rpt, &rpt_len, err);
-        memcpy(bytes + offset, rpt_bytes, rpt_len);
-        offset += rpt_len;
-        free(rpt_bytes);
+        address_encode_into(&rpt, bytes + offset);
+        offset += 7;
+    }
+}
+
+uint8_t* ax25_frame_header_encode(const ax25_frame_header_t *header, size_t *len, uint8_t *err) {
+    *err = 0;
+    size_t total_len = 7 * (2 + header->repeaters.num_repeaters);
+    uint8_t *bytes = malloc(total_len);
+    if (!bytes) {
+        *err = 1;
+        return NULL;
     }
 
+    header_encode_into(header, bytes);
+
     *len = total_len;
     return bytes;
 }
@@ -416,141 +454,701 @@ void ax25_frame_header_free(ax25_frame_header_t *header, uint8_t *err) {
     free(header);
 }
 
-ax25_frame_t* ax25_frame_decode(const uint8_t *data, size_t len, int modulo128, uint8_t *err) {
+static size_t frame_struct_size(ax25_frame_type_t type);
+static bool xid_parameters_decode(const uint8_t *data, size_t len, ax25_exchange_identification_frame_t *frame, mem_arena_t *arena, uint8_t *err);
+
+// Parses a U-frame control and information field into storage, with payload pointers into info.
+// XID frames only get FI and GI here, their parameters are decoded by frame_copy_out().
+static bool unnumbered_parse(uint8_t control, const uint8_t *info, size_t len, ax25_frame_storage_t *storage, uint8_t *err) {
+    uint8_t modifier = control & 0xEF;
+    ax25_unnumbered_frame_t *u = &storage->unnumbered;
+    u->pf = (control & POLL_FINAL_8BIT) != 0;
+    u->modifier = modifier;
+
+    switch (modifier) {
+        case 0x03: // UI
+            if (len < 1) { // Need at least PID byte
+                *err = 1;
+                return false;
+            }
+            u->base.type = AX25_FRAME_UNNUMBERED_INFORMATION;
+            storage->ui.pid = info[0];
+            storage->ui.payload = (uint8_t*) (info + 1);
+            storage->ui.payload_len = len - 1;
+        break;
+        case 0x87: { // FRMR
+            ax25_frame_reject_frame_t *frmr = &storage->frmr;
+            // Modulo-128 FRMR frames carry a 5 byte information field, modulo-8 ones 3 bytes
+            frmr->is_modulo128 = (len == 5);
+            if (len != (frmr->is_modulo128 ? 5 : 3)) {
+                *err = 1; // Invalid length
+                return false;
+            }
+            u->base.type = AX25_FRAME_UNNUMBERED_FRMR;
+            if (frmr->is_modulo128) {
+                frmr->frmr_control = info[0] | (info[1] << 8);
+                frmr->vs = (info[2] >> 1) & 0x7F;
+                frmr->frmr_cr = info[2] & 0x01;
+                frmr->vr = (info[3] >> 1) & 0x7F;
+            } else {
+                frmr->frmr_control = info[0];
+                frmr->vr = (info[1] >> 5) & 0x07;
+                frmr->frmr_cr = (info[1] & 0x10) != 0;
+                frmr->vs = (info[1] >> 1) & 0x07;
+            }
+            uint8_t flags = info[frmr->is_modulo128 ? 4 : 2];
+            frmr->w = (flags & 0x01) != 0;
+            frmr->x = (flags & 0x02) != 0;
+            frmr->y = (flags & 0x04) != 0;
+            frmr->z = (flags & 0x08) != 0;
+            break;
+        }
+        case 0xAF: { // XID
+            if (len < 4) {
+                *err = 1;
+                return false;
+            }
+            if (len - 4 != uint_decode(info + 2, 2, true, err)) { // Group length
+                *err = 2;
+                return false;
+            }
+            for (size_t pos = 4; pos < len; pos += 2 + info[pos + 1]) {
+                if (len - pos < 2 || len - pos - 2 < info[pos + 1]) {
+                    *err = 3; // Truncated parameter
+                    return false;
+                }
+            }
+            u->base.type = AX25_FRAME_UNNUMBERED_XID;
+            storage->xid.fi = info[0];
+            storage->xid.gi = info[1];
+            storage->xid.parameters = NULL;
+            storage->xid.param_count = 0;
+            break;
+        }
+        case 0xE3: // TEST
+            u->base.type = AX25_FRAME_UNNUMBERED_TEST;
+            storage->test.payload = (uint8_t*) info;
+            storage->test.payload_len = len;
+        break;
+        case 0x2F: // SABM
+        case 0x6F: // SABME
+        case 0x43: // DISC
+        case 0x0F: // DM
+        case 0x63: // UA
+            u->base.type = (modifier == 0x2F) ? AX25_FRAME_UNNUMBERED_SABM : (modifier == 0x6F) ? AX25_FRAME_UNNUMBERED_SABME :
+                           (modifier == 0x43) ? AX25_FRAME_UNNUMBERED_DISC : (modifier == 0x0F) ? AX25_FRAME_UNNUMBERED_DM : AX25_FRAME_UNNUMBERED_UA;
+        break;
+        default:
+            *err = 6; // Invalid U-frame modifier
+            return false;
+    }
+
+    return true;
+}
+
+// Parses an I-frame control and information field into storage, with the payload pointing into info
+static void information_parse(uint16_t control, const uint8_t *info, size_t len, bool is_16bit, ax25_frame_storage_t *storage) {
+    ax25_information_frame_t *iframe = &storage->information;
+    iframe->base.type = is_16bit ? AX25_FRAME_INFORMATION_16BIT : AX25_FRAME_INFORMATION_8BIT;
+    iframe->nr = is_16bit ? ((control & 0xFE00) >> 9) : ((control & 0xE0) >> 5);
+    iframe->pf = (control & (is_16bit ? POLL_FINAL_16BIT : POLL_FINAL_8BIT)) != 0;
+    iframe->ns = is_16bit ? ((control & 0x00FE) >> 1) : ((control & 0x0E) >> 1);
+    iframe->pid = (len > 0) ? info[0] : 0;
+    iframe->payload = (len > 1) ? (uint8_t*) (info + 1) : NULL;
+    iframe->payload_len = (len > 0) ? len - 1 : 0;
+}
+
+// Parses an S-frame control field into storage
+static void supervisory_parse(uint16_t control, bool is_16bit, ax25_frame_storage_t *storage) {
+    static const ax25_frame_type_t s_types[2][4] = {
+            { AX25_FRAME_SUPERVISORY_RR_8BIT, AX25_FRAME_SUPERVISORY_RNR_8BIT, AX25_FRAME_SUPERVISORY_REJ_8BIT, AX25_FRAME_SUPERVISORY_SREJ_8BIT },
+            { AX25_FRAME_SUPERVISORY_RR_16BIT, AX25_FRAME_SUPERVISORY_RNR_16BIT, AX25_FRAME_SUPERVISORY_REJ_16BIT, AX25_FRAME_SUPERVISORY_SREJ_16BIT } };
+    ax25_supervisory_frame_t *sframe = &storage->supervisory;
+    sframe->code = control & 0x0C;
+    sframe->base.type = s_types[is_16bit][sframe->code >> 2];
+    sframe->nr = is_16bit ? ((control & 0xFE00) >> 9) : ((control & 0xE0) >> 5);
+    sframe->pf = (control & (is_16bit ? POLL_FINAL_16BIT : POLL_FINAL_8BIT)) != 0;
+}
+
+// Parses a whole frame into storage, with payload pointers into data. Every frame decoder goes
+// through here and only differs in where, if anywhere, it copies the result.
+static ax25_frame_t* frame_parse(const uint8_t *data, size_t len, int modulo128, ax25_frame_storage_t *storage, uint8_t *err) {
     *err = 0;
 
     if (len < 14) {
         *err = 1;
         return NULL; // Minimum header size
     }
-
-    header_decode_result_t hdr_result = ax25_frame_header_decode(data, len, err);
-    if (!hdr_result.header) {
-        return NULL; // Error is already set by ax25_frame_header_decode
+    if (data == NULL) {
+        *err = 2;
+        return NULL;
     }
 
-    if (hdr_result.remaining_len == 0) {
+    ax25_frame_header_t *header = &storage->base.header;
+    size_t pos = header_decode_into(data, len, header, err);
+    if (pos == 0)
+        return NULL; // Error is already set by header_decode_into
+
+    if (pos == len) {
         *err = 3;
-        ax25_frame_header_free(hdr_result.header, err);
         return NULL;
     }
 
-    uint8_t control = hdr_result.remaining[0];
-    ax25_frame_t *frame = NULL;
+    const uint8_t *remaining = data + pos;
+    size_t remaining_len = len - pos;
+    uint8_t control = remaining[0];
+
+    if ((control & CONTROL_US_MASK) == CONTROL_U_VAL)
+        return unnumbered_parse(control, remaining + 1, remaining_len - 1, storage, err) ? &storage->base : NULL;
 
-    if ((control & CONTROL_US_MASK) == CONTROL_U_VAL) {
-        frame = (ax25_frame_t*) ax25_unnumbered_frame_decode(hdr_result.header, control, hdr_result.remaining + 1, hdr_result.remaining_len - 1, err);
+    if (modulo128 == MODULO128_NONE) {
+        storage->base.type = AX25_FRAME_RAW;
+        storage->raw.control = control;
+        storage->raw.payload = (uint8_t*) (remaining + 1);
+        storage->raw.payload_len = remaining_len - 1;
+        return &storage->base;
+    }
+
+    bool is_16bit;
+    if (modulo128 == MODULO128_AUTO) {
+        // Automatic detection based on source address res1 bit
+        is_16bit = !header->source.res1;
     } else {
-        if (modulo128 == MODULO128_NONE) {
-            if (hdr_result.remaining_len < 1) {
-                // Error: no control byte
-                *err = 4;
-                ax25_frame_header_free(hdr_result.header, err);
-                return NULL;
-            }
-            ax25_raw_frame_t *raw = malloc(sizeof(ax25_raw_frame_t));
-            if (!raw) {
-                *err = 4;
-                ax25_frame_header_free(hdr_result.header, err);
+        is_16bit = (modulo128 == MODULO128_TRUE);
+    }
+    size_t control_size = is_16bit ? 2 : 1;
+    if (remaining_len < control_size) {
+        *err = 6;
+        return NULL;
+    }
+    uint16_t full_control = control;
+    if (is_16bit)
+        full_control |= (remaining[1] << 8);
+
+    if ((full_control & CONTROL_I_MASK) == CONTROL_I_VAL)
+        information_parse(full_control, remaining + control_size, remaining_len - control_size, is_16bit, storage);
+    else
+        supervisory_parse(full_control, is_16bit, storage);
+
+    return &storage->base;
+}
+
+// Copies a parsed frame into memory from mem_alloc(), along with its payload, null-terminated for
+// UI frames. info is the field after the control byte, only read to decode XID parameters.
+static ax25_frame_t* frame_copy_out(const ax25_frame_storage_t *storage, const uint8_t *info, size_t info_len, mem_arena_t *arena, uint8_t *err) {
+    size_t size = frame_struct_size(storage->base.type);
+    ax25_frame_t *frame = mem_alloc(arena, size);
+    if (!frame) {
+        *err = 8;
+        return NULL;
+    }
+    memcpy(frame, storage, size);
+
+    uint8_t **payload = NULL;
+    size_t payload_len = 0;
+    size_t extra = 0;
+    switch (frame->type) {
+        case AX25_FRAME_RAW:
+            payload = &((ax25_raw_frame_t*) frame)->payload;
+            payload_len = ((ax25_raw_frame_t*) frame)->payload_len;
+        break;
+        case AX25_FRAME_UNNUMBERED_INFORMATION:
+            payload = &((ax25_unnumbered_information_frame_t*) frame)->payload;
+            payload_len = ((ax25_unnumbered_information_frame_t*) frame)->payload_len;
+            extra = 1; // Null terminator
+        break;
+        case AX25_FRAME_UNNUMBERED_TEST:
+            payload = &((ax25_test_frame_t*) frame)->payload;
+            payload_len = ((ax25_test_frame_t*) frame)->payload_len;
+        break;
+        case AX25_FRAME_INFORMATION_8BIT:
+        case AX25_FRAME_INFORMATION_16BIT:
+            payload = &((ax25_information_frame_t*) frame)->payload;
+            payload_len = ((ax25_information_frame_t*) frame)->payload_len;
+        break;
+        case AX25_FRAME_UNNUMBERED_XID:
+            if (!xid_parameters_decode(info + 4, info_len - 4, (ax25_exchange_identification_frame_t*) frame, arena, err)) {
+                mem_free(arena, frame);
                 return NULL;
             }
-            raw->base.type = AX25_FRAME_RAW;
-            raw->base.header = *hdr_result.header;
-            raw->control = hdr_result.remaining[0];
-            raw->payload_len = hdr_result.remaining_len - 1;
-            raw->payload = malloc(raw->payload_len);
-            if (!raw->payload) {
-                *err = 5;
-                free(raw);
-                ax25_frame_header_free(hdr_result.header, err);
-                return NULL;
+        break;
+        default:
+        break;
+    }
+
+    if (payload && payload_len + extra > 0) {
+        uint8_t *copy = mem_alloc(arena, payload_len + extra);
+        if (!copy) {
+            *err = 8;
+            mem_free(arena, frame);
+            return NULL;
+        }
+        if (payload_len)
+            memcpy(copy, *payload, payload_len);
+        if (extra)
+            copy[payload_len] = '\0';
+        *payload = copy;
+    } else if (payload) {
+        *payload = NULL;
+    }
+
+    return frame;
+}
+
+ax25_frame_t* ax25_frame_decode_arena(const uint8_t *data, size_t len, int modulo128, mem_arena_t *arena, uint8_t *err) {
+    ax25_frame_storage_t storage;
+
+    if (!frame_parse(data, len, modulo128, &storage, err))
+        return NULL;
+
+    size_t info_pos = 7 * (2 + storage.base.header.repeaters.num_repeaters) + 1;
+    return frame_copy_out(&storage, data + info_pos, len - info_pos, arena, err);
+}
+
+ax25_frame_t* ax25_frame_decode(const uint8_t *data, size_t len, int modulo128, uint8_t *err) {
+    return ax25_frame_decode_arena(data, len, modulo128, NULL, err);
+}
+
+ax25_frame_t* ax25_frame_decode_into(const uint8_t *data, size_t len, int modulo128, ax25_frame_storage_t *storage, uint8_t *err) {
+    ax25_frame_t *frame = frame_parse(data, len, modulo128, storage, err);
+
+    // Payload pointers refer to the caller's buffer, but XID parameters need storage of their own
+    if (frame && frame->type == AX25_FRAME_UNNUMBERED_XID) {
+        *err = 7;
+        return NULL;
+    }
+    return frame;
+}
+
+uint8_t* ax25_frame_encode(const ax25_frame_t *frame, size_t *len, uint8_t *err) {
+    *err = 0;
+
+    size_t total_len = ax25_frame_encode_into(frame, NULL, 0, err);
+    if (total_len == 0) {
+        return NULL; // Error is already set by ax25_frame_encode_into
+    }
+
+    uint8_t *result = malloc(total_len);
+    if (!result) {
+        *err = 4;
+        return NULL;
+    }
+
+    ax25_frame_encode_into(frame, result, total_len, err);
+    if (*err) {
+        free(result);
+        return NULL;
+    }
+
+    *len = total_len;
+    return result;
+}
+
+// Writes the XID control, FI, GI, GL and parameter fields, storing only the bytes that fit in size.
+// Each parameter is encoded once; returns the full length, or 0 with *err set if a parameter fails to encode.
+static size_t xid_body_encode_into(const ax25_exchange_identification_frame_t *xid, uint8_t *bytes, size_t size, uint8_t *err) {
+    size_t offset = 5;
+    for (size_t i = 0; i < xid->param_count; i++) {
+        const ax25_xid_parameter_t *param = xid->parameters[i];
+        if (param->encode == ax25_xid_raw_parameter_encode) {
+            const ax25_raw_param_data_t *data = (const ax25_raw_param_data_t*) param->data;
+            size_t pv_len = data ? data->pv_len : 0;
+            if (bytes && offset + 2 + pv_len <= size) {
+                bytes[offset] = param->pi;
+                bytes[offset + 1] = (uint8_t) pv_len;
+                if (pv_len)
+                    memcpy(bytes + offset + 2, data->pv, pv_len);
             }
-            memcpy(raw->payload, hdr_result.remaining + 1, raw->payload_len);
-            frame = (ax25_frame_t*) raw;
+            offset += 2 + pv_len;
         } else {
-            bool is_16bit;
-            if (modulo128 == MODULO128_AUTO) {
-                // Automatic detection based on source address res1 bit
-                is_16bit = !hdr_result.header->source.res1;
-            } else {
-                is_16bit = (modulo128 == MODULO128_TRUE);
-            }
-            size_t control_size = is_16bit ? 2 : 1;
-            if (hdr_result.remaining_len < control_size) {
-                *err = 6;
-                ax25_frame_header_free(hdr_result.header, err);
-                return NULL;
+            size_t param_len;
+            uint8_t *param_bytes = param->encode(param, &param_len, err);
+            if (!param_bytes) {
+                *err = 3; // Parameter failed to encode
+                return 0;
             }
-            uint16_t full_control = control;
-            if (is_16bit)
-                full_control |= (hdr_result.remaining[1] << 8);
+            if (bytes && offset + param_len <= size)
+                memcpy(bytes + offset, param_bytes, param_len);
+            free(param_bytes);
+            offset += param_len;
+        }
+    }
+    *err = 0;
+    if (bytes && size >= 5) {
+        bytes[0] = xid->base.modifier | (xid->base.pf ? POLL_FINAL_8BIT : 0);
+        bytes[1] = xid->fi;
+        bytes[2] = xid->gi;
+        bytes[3] = ((offset - 5) >> 8) & 0xFF; // Group length, big endian
+        bytes[4] = (offset - 5) & 0xFF;
+    }
+    return offset;
+}
 
-            const uint8_t *data_start = hdr_result.remaining + control_size;
-            size_t data_len = hdr_result.remaining_len - control_size;
+// Returns the encoded length of everything after the address field, or 0 for an unknown type
+static size_t frame_body_len(const ax25_frame_t *frame) {
+    switch (frame->type) {
+        case AX25_FRAME_RAW:
+            return 1 + ((const ax25_raw_frame_t*) frame)->payload_len;
+        case AX25_FRAME_UNNUMBERED_INFORMATION:
+            return 2 + ((const ax25_unnumbered_information_frame_t*) frame)->payload_len;
+        case AX25_FRAME_UNNUMBERED_SABM:
+        case AX25_FRAME_UNNUMBERED_SABME:
+        case AX25_FRAME_UNNUMBERED_DISC:
+        case AX25_FRAME_UNNUMBERED_DM:
+        case AX25_FRAME_UNNUMBERED_UA:
+            return 1;
+        case AX25_FRAME_UNNUMBERED_FRMR:
+            return ((const ax25_frame_reject_frame_t*) frame)->is_modulo128 ? 6 : 4;
+        case AX25_FRAME_UNNUMBERED_TEST:
+            return 1 + ((const ax25_test_frame_t*) frame)->payload_len;
+        case AX25_FRAME_INFORMATION_8BIT:
+            return 2 + ((const ax25_information_frame_t*) frame)->payload_len;
+        case AX25_FRAME_INFORMATION_16BIT:
+            return 3 + ((const ax25_information_frame_t*) frame)->payload_len;
+        case AX25_FRAME_SUPERVISORY_RR_8BIT:
+        case AX25_FRAME_SUPERVISORY_RNR_8BIT:
+        case AX25_FRAME_SUPERVISORY_REJ_8BIT:
+        case AX25_FRAME_SUPERVISORY_SREJ_8BIT:
+            return 1;
+        case AX25_FRAME_SUPERVISORY_RR_16BIT:
+        case AX25_FRAME_SUPERVISORY_RNR_16BIT:
+        case AX25_FRAME_SUPERVISORY_REJ_16BIT:
+        case AX25_FRAME_SUPERVISORY_SREJ_16BIT:
+            return 2;
+        default:
+            return 0;
+    }
+}
 
-            if ((full_control & CONTROL_I_MASK) == CONTROL_I_VAL) {
-                frame = (ax25_frame_t*) ax25_information_frame_decode(hdr_result.header, full_control, data_start, data_len, is_16bit, err);
-            } else if ((full_control & CONTROL_US_MASK) == CONTROL_S_VAL) {
-                frame = (ax25_frame_t*) ax25_supervisory_frame_decode(hdr_result.header, full_control, is_16bit, err);
+// Writes control, PID and information fields, producing the same bytes as the per-type encoders
+static void frame_body_encode_into(const ax25_frame_t *frame, uint8_t *bytes) {
+    switch (frame->type) {
+        case AX25_FRAME_RAW: {
+            const ax25_raw_frame_t *raw = (const ax25_raw_frame_t*) frame;
+            bytes[0] = raw->control;
+            if (raw->payload_len)
+                memcpy(bytes + 1, raw->payload, raw->payload_len);
+            break;
+        }
+        case AX25_FRAME_UNNUMBERED_INFORMATION: {
+            const ax25_unnumbered_information_frame_t *ui = (const ax25_unnumbered_information_frame_t*) frame;
+            bytes[0] = ui->base.modifier | (ui->base.pf ? POLL_FINAL_8BIT : 0);
+            bytes[1] = ui->pid;
+            if (ui->payload_len)
+                memcpy(bytes + 2, ui->payload, ui->payload_len);
+            break;
+        }
+        case AX25_FRAME_UNNUMBERED_SABM:
+        case AX25_FRAME_UNNUMBERED_SABME:
+        case AX25_FRAME_UNNUMBERED_DISC:
+        case AX25_FRAME_UNNUMBERED_DM:
+        case AX25_FRAME_UNNUMBERED_UA: {
+            const ax25_unnumbered_frame_t *u = (const ax25_unnumbered_frame_t*) frame;
+            bytes[0] = u->modifier | (u->pf ? POLL_FINAL_8BIT : 0);
+            break;
+        }
+        case AX25_FRAME_UNNUMBERED_FRMR: {
+            const ax25_frame_reject_frame_t *frmr = (const ax25_frame_reject_frame_t*) frame;
+            uint8_t flags = (frmr->w ? 0x01 : 0) | (frmr->x ? 0x02 : 0) | (frmr->y ? 0x04 : 0) | (frmr->z ? 0x08 : 0);
+            bytes[0] = frmr->base.modifier | (frmr->base.pf ? POLL_FINAL_8BIT : 0);
+            if (frmr->is_modulo128) {
+                bytes[1] = frmr->frmr_control & 0xFF;
+                bytes[2] = (frmr->frmr_control >> 8) & 0xFF;
+                bytes[3] = ((frmr->vs & 0x7F) << 1) | (frmr->frmr_cr ? 0x01 : 0);
+                bytes[4] = (frmr->vr & 0x7F) << 1;
+                bytes[5] = flags;
+            } else {
+                bytes[1] = frmr->frmr_control & 0xFF;
+                bytes[2] = ((frmr->vr & 0x07) << 5) | (frmr->frmr_cr ? 0x10 : 0) | ((frmr->vs & 0x07) << 1);
+                bytes[3] = flags;
+            }
+            break;
+        }
+        case AX25_FRAME_UNNUMBERED_TEST: {
+            const ax25_test_frame_t *test = (const ax25_test_frame_t*) frame;
+            bytes[0] = test->base.modifier | (test->base.pf ? POLL_FINAL_8BIT : 0);
+            if (test->payload_len)
+                memcpy(bytes + 1, test->payload, test->payload_len);
+            break;
+        }
+        case AX25_FRAME_INFORMATION_8BIT:
+        case AX25_FRAME_INFORMATION_16BIT: {
+            const ax25_information_frame_t *iframe = (const ax25_information_frame_t*) frame;
+            size_t offset;
+            if (frame->type == AX25_FRAME_INFORMATION_16BIT) {
+                uint16_t control = ((iframe->nr << 9) & 0xFE00) | (iframe->pf ? POLL_FINAL_16BIT : 0) | ((iframe->ns << 1) & 0x01FE) | CONTROL_I_VAL;
+                bytes[0] = control & 0xFF;
+                bytes[1] = (control >> 8) & 0xFF;
+                offset = 2;
+            } else {
+                bytes[0] = ((iframe->nr << 5) & 0xE0) | (iframe->pf ? POLL_FINAL_8BIT : 0) | ((iframe->ns << 1) & 0x0E) | CONTROL_I_VAL;
+                offset = 1;
             }
+            bytes[offset++] = iframe->pid;
+            if (iframe->payload_len)
+                memcpy(bytes + offset, iframe->payload, iframe->payload_len);
+            break;
+        }
+        default: {
+            const ax25_supervisory_frame_t *sframe = (const ax25_supervisory_frame_t*) frame;
+            if (frame->type >= AX25_FRAME_SUPERVISORY_RR_16BIT) {
+                uint16_t control = ((sframe->nr << 9) & 0xFE00) | (sframe->pf ? POLL_FINAL_16BIT : 0) | (sframe->code & 0x0C) | CONTROL_S_VAL;
+                bytes[0] = control & 0xFF;
+                bytes[1] = (control >> 8) & 0xFF;
+            } else {
+                bytes[0] = ((sframe->nr << 5) & 0xE0) | (sframe->pf ? POLL_FINAL_8BIT : 0) | (sframe->code & 0x0C) | CONTROL_S_VAL;
+            }
+            break;
         }
     }
-
-    ax25_frame_header_free(hdr_result.header, err);
-
-    return frame;
 }
 
-uint8_t* ax25_frame_encode(const ax25_frame_t *frame, size_t *len, uint8_t *err) {
+size_t ax25_frame_encode_into(const ax25_frame_t *frame, uint8_t *buf, size_t size, uint8_t *err) {
     *err = 0;
 
-    // Determine if it's a modulo-128 frame
+    if (!frame) {
+        *err = 2;
+        return 0;
+    }
+
+    size_t header_len = 7 * (2 + frame->header.repeaters.num_repeaters);
+    size_t body_len;
+    if (frame->type == AX25_FRAME_UNNUMBERED_XID) {
+        // Parameters may only encode to the heap, so the XID body is written during the length pass
+        bool room = buf && size > header_len;
+        body_len = xid_body_encode_into((const ax25_exchange_identification_frame_t*) frame, room ? buf + header_len : NULL, room ? size - header_len : 0,
+                err);
+        if (*err)
+            return 0;
+    } else {
+        body_len = frame_body_len(frame);
+        if (body_len == 0) {
+            *err = 2; // Unknown frame type
+            return 0;
+        }
+    }
+
+    size_t total_len = header_len + body_len;
+    if (!buf)
+        return total_len; // Size query
+    if (size < total_len) {
+        *err = 5; // Buffer too small
+        return total_len;
+    }
+
+    // Same address field adjustment as ax25_frame_encode()
     bool is_modulo128 = (frame->type == AX25_FRAME_INFORMATION_16BIT || frame->type == AX25_FRAME_SUPERVISORY_RR_16BIT
             || frame->type == AX25_FRAME_SUPERVISORY_RNR_16BIT || frame->type == AX25_FRAME_SUPERVISORY_REJ_16BIT
             || frame->type == AX25_FRAME_SUPERVISORY_SREJ_16BIT || frame->type == AX25_FRAME_UNNUMBERED_SABME);
-
-    // Create a copy of the header
-    ax25_frame_header_t header_copy = frame->header;
     if (is_modulo128) {
+        ax25_frame_header_t header_copy = frame->header;
         header_copy.source.res1 = false;
+        header_encode_into(&header_copy, buf);
+    } else {
+        header_encode_into(&frame->header, buf);
+    }
+
+    if (frame->type != AX25_FRAME_UNNUMBERED_XID)
+        frame_body_encode_into(frame, buf + header_len);
+
+    return total_len;
+}
+
+bool ax25_frame_view_init(ax25_frame_view_t *view, const uint8_t *data, size_t len, uint8_t *err) {
+    *err = 0;
+    view->data = data;
+    view->len = len;
+    view->num_addresses = 0;
+
+    if (data == NULL || len < 14) {
+        *err = 1;
+        return false;
+    }
+
+    size_t pos = 6;
+    int count = 1;
+    while ((count < 2 || !(data[pos] & 0x01)) && count < 2 + MAX_REPEATERS && pos + 7 < len) {
+        pos += 7;
+        count++;
+    }
+    if (count < 2 || !(data[pos] & 0x01)) {
+        *err = 5; // Last address doesn't have extension bit set
+        return false;
+    }
+    if (pos + 1 >= len) {
+        *err = 3; // No control field
+        return false;
     }
 
-    size_t header_len;
-    uint8_t *header_bytes = ax25_frame_header_encode(&header_copy, &header_len, err);
-    if (!header_bytes) {
+    view->num_addresses = count;
+    return true;
+}
+
+int ax25_frame_view_ssid(const ax25_frame_view_t *view, int n) {
+    if (n < 0 || n >= view->num_addresses)
+        return -1;
+    return (view->data[n * 7 + 6] & 0x1E) >> 1;
+}
+
+bool ax25_frame_view_ch(const ax25_frame_view_t *view, int n) {
+    if (n < 0 || n >= view->num_addresses)
+        return false;
+    return (view->data[n * 7 + 6] & 0x80) != 0;
+}
+
+size_t ax25_frame_view_callsign(const ax25_frame_view_t *view, int n, char *callsign) {
+    size_t len = 0;
+    if (n >= 0 && n < view->num_addresses) {
+        const uint8_t *addr = view->data + n * 7;
+        for (int i = 0; i < 6; i++) {
+            callsign[i] = (addr[i] >> 1) & 0x7F;
+            if (callsign[i] != ' ')
+                len = i + 1;
+        }
+    }
+    callsign[len] = '\0';
+    return len;
+}
+
+bool ax25_frame_view_address_equals(const ax25_frame_view_t *view, int n, const char *callsign, int ssid) {
+    if (n < 0 || n >= view->num_addresses)
+        return false;
+
+    const uint8_t *addr = view->data + n * 7;
+    bool pad = false;
+    for (int i = 0; i < 6; i++) {
+        pad = pad || !callsign[i];
+        if ((addr[i] >> 1) != (uint8_t) (pad ? ' ' : callsign[i]))
+            return false;
+    }
+    if (!pad && callsign[6])
+        return false; // Callsign longer than 6 characters
+
+    return ssid < 0 || ((addr[6] & 0x1E) >> 1) == ssid;
+}
+
+ax25_packed_address_t ax25_frame_view_packed_address(const ax25_frame_view_t *view, int n) {
+    if (n < 0 || n >= view->num_addresses)
+        return 0;
+    return ax25_address_pack_wire(view->data + n * 7);
+}
+
+uint8_t ax25_frame_view_control(const ax25_frame_view_t *view) {
+    return view->data[view->num_addresses * 7];
+}
+
+// Offset of the PID byte, or 0 if the frame has none
+static size_t frame_view_pid_offset(const ax25_frame_view_t *view, int modulo128) {
+    size_t pos = view->num_addresses * 7;
+    uint8_t control = view->data[pos];
+
+    if ((control & 0xEF) == 0x03) {
+        pos += 1; // UI
+    } else if ((control & CONTROL_I_MASK) == CONTROL_I_VAL && modulo128 != MODULO128_NONE) {
+        bool is_16bit = (modulo128 == MODULO128_AUTO) ? !(view->data[13] & 0x40) : (modulo128 == MODULO128_TRUE);
+        pos += is_16bit ? 2 : 1;
+    } else {
+        return 0;
+    }
+
+    return (pos < view->len) ? pos : 0;
+}
+
+int ax25_frame_view_pid(const ax25_frame_view_t *view, int modulo128) {
+    size_t pos = frame_view_pid_offset(view, modulo128);
+    return pos ? view->data[pos] : -1;
+}
+
+const uint8_t* ax25_frame_view_info(const ax25_frame_view_t *view, int modulo128, size_t *info_len) {
+    size_t pos = 0;
+    uint8_t control = ax25_frame_view_control(view);
+
+    *info_len = 0;
+    if ((control & 0xEF) == 0xE3) {
+        pos = view->num_addresses * 7 + 1; // TEST frames carry information without PID
+    } else if (modulo128 == MODULO128_NONE && (control & CONTROL_US_MASK) != CONTROL_U_VAL) {
+        pos = view->num_addresses * 7 + 1; // Raw frame, as decoded by ax25_frame_decode()
+    } else {
+        pos = frame_view_pid_offset(view, modulo128);
+        if (pos)
+            pos++;
+    }
+    if (pos == 0 || pos >= view->len)
+        return NULL;
+
+    *info_len = view->len - pos;
+    return view->data + pos;
+}
+
+// Frees the heap members of a frame. Members inside [lo, hi), the pool slot holding the frame,
+// are left alone; pass NULL for both to free every member.
+static void frame_free_members(ax25_frame_t *frame, const void *lo, const void *hi, uint8_t *err) {
+    void *payload = NULL;
+
+    switch (frame->type) {
+        case AX25_FRAME_RAW:
+            payload = ((ax25_raw_frame_t*) frame)->payload;
+        break;
+        case AX25_FRAME_UNNUMBERED_INFORMATION:
+            payload = ((ax25_unnumbered_information_frame_t*) frame)->payload;
+        break;
+        case AX25_FRAME_UNNUMBERED_XID: {
+            ax25_exchange_identification_frame_t *xid = (ax25_exchange_identification_frame_t*) frame;
+            for (size_t i = 0; i < xid->param_count; i++) {
+                xid->parameters[i]->free(xid->parameters[i], err);
+            }
+            payload = xid->parameters;
+            break;
+        }
+        case AX25_FRAME_UNNUMBERED_TEST:
+            payload = ((ax25_test_frame_t*) frame)->payload;
+        break;
+        case AX25_FRAME_INFORMATION_8BIT:
+        case AX25_FRAME_INFORMATION_16BIT:
+            payload = ((ax25_information_frame_t*) frame)->payload;
+        break;
+        default:
+        break;
+    }
+
+    if ((uintptr_t) payload < (uintptr_t) lo || (uintptr_t) payload >= (uintptr_t) hi)
+        free(payload);
+}
+
+void ax25_frame_free(ax25_frame_t *frame, uint8_t *err) {
+    *err = 0;
+
+    if (!frame) {
         *err = 1;
-        return NULL;
+        return;
     }
 
-    uint8_t *payload_bytes = NULL;
-    size_t payload_len;
-    switch (frame->type) {
+    frame_free_members(frame, NULL, NULL, err);
+    free(frame);
+}
+
+// Size of the structure for a frame type, or 0 for an unknown type
+static size_t frame_struct_size(ax25_frame_type_t type) {
+    switch (type) {
         case AX25_FRAME_RAW:
-            payload_bytes = ax25_raw_frame_encode((ax25_raw_frame_t*) frame, &payload_len, err);
-        break;
+            return sizeof(ax25_raw_frame_t);
         case AX25_FRAME_UNNUMBERED_INFORMATION:
-            payload_bytes = ax25_unnumbered_information_frame_encode((ax25_unnumbered_information_frame_t*) frame, &payload_len, err);
-        break;
+            return sizeof(ax25_unnumbered_information_frame_t);
         case AX25_FRAME_UNNUMBERED_SABM:
         case AX25_FRAME_UNNUMBERED_SABME:
         case AX25_FRAME_UNNUMBERED_DISC:
         case AX25_FRAME_UNNUMBERED_DM:
         case AX25_FRAME_UNNUMBERED_UA:
-            payload_bytes = ax25_unnumbered_frame_encode((ax25_unnumbered_frame_t*) frame, &payload_len, err);
-        break;
+            return sizeof(ax25_unnumbered_frame_t);
         case AX25_FRAME_UNNUMBERED_FRMR:
-            payload_bytes = ax25_frame_reject_frame_encode((ax25_frame_reject_frame_t*) frame, &payload_len, err);
-        break;
+            return sizeof(ax25_frame_reject_frame_t);
         case AX25_FRAME_UNNUMBERED_XID:
-            payload_bytes = ax25_exchange_identification_frame_encode((ax25_exchange_identification_frame_t*) frame, &payload_len, err);
-        break;
+            return sizeof(ax25_exchange_identification_frame_t);
         case AX25_FRAME_UNNUMBERED_TEST:
-            payload_bytes = ax25_test_frame_encode((ax25_test_frame_t*) frame, &payload_len, err);
-        break;
+            return sizeof(ax25_test_frame_t);
         case AX25_FRAME_INFORMATION_8BIT:
         case AX25_FRAME_INFORMATION_16BIT:
-            payload_bytes = ax25_information_frame_encode((ax25_information_frame_t*) frame, &payload_len, err);
-        break;
+            return sizeof(ax25_information_frame_t);
         case AX25_FRAME_SUPERVISORY_RR_8BIT:
         case AX25_FRAME_SUPERVISORY_RNR_8BIT:
         case AX25_FRAME_SUPERVISORY_REJ_8BIT:
@@ -559,72 +1157,173 @@ uint8_t* ax25_frame_encode(const ax25_frame_t *frame, size_t *len, uint8_t *err)
         case AX25_FRAME_SUPERVISORY_RNR_16BIT:
         case AX25_FRAME_SUPERVISORY_REJ_16BIT:
         case AX25_FRAME_SUPERVISORY_SREJ_16BIT:
-            payload_bytes = ax25_supervisory_frame_encode((ax25_supervisory_frame_t*) frame, &payload_len, err);
-        break;
+            return sizeof(ax25_supervisory_frame_t);
         default:
-            *err = 2;
-            free(header_bytes);
-            return NULL;
+            return 0;
     }
+}
 
-    if (!payload_bytes) {
-        *err = 3;
-        free(header_bytes);
-        return NULL;
-    }
+static ax25_frame_t* frame_create(ax25_frame_type_t type, const ax25_frame_header_t *header, size_t payload_len, mem_arena_t *arena, uint8_t *err) {
+    *err = 0;
 
-    *len = header_len + payload_len;
-    uint8_t *result = malloc(*len);
-    if (!result) {
-        *err = 4;
-        free(header_bytes);
-        free(payload_bytes);
+    size_t size = frame_struct_size(type);
+    if (size == 0) {
+        *err = 2;
         return NULL;
     }
 
-    memcpy(result, header_bytes, header_len);
-    memcpy(result + header_len, payload_bytes, payload_len);
-    free(header_bytes);
-    free(payload_bytes);
-
-    return result;
-}
-
-void ax25_frame_free(ax25_frame_t *frame, uint8_t *err) {
-    *err = 0;
-
+    ax25_frame_t *frame = mem_alloc(arena, size);
     if (!frame) {
-        *err = 1;
-        return;
+        *err = 4;
+        return NULL;
     }
+    memset(frame, 0, size);
+    frame->type = type;
+    frame->header = *header;
 
-    switch (frame->type) {
+    uint8_t **payload = NULL;
+    size_t *len = NULL;
+    size_t extra = 0;
+    switch (type) {
         case AX25_FRAME_RAW:
-            free(((ax25_raw_frame_t*) frame)->payload);
+            payload = &((ax25_raw_frame_t*) frame)->payload;
+            len = &((ax25_raw_frame_t*) frame)->payload_len;
         break;
         case AX25_FRAME_UNNUMBERED_INFORMATION:
-            free(((ax25_unnumbered_information_frame_t*) frame)->payload);
+            payload = &((ax25_unnumbered_information_frame_t*) frame)->payload;
+            len = &((ax25_unnumbered_information_frame_t*) frame)->payload_len;
+            extra = 1; // Null terminator, as for decoded UI frames
         break;
-        case AX25_FRAME_UNNUMBERED_XID: {
-            ax25_exchange_identification_frame_t *xid = (ax25_exchange_identification_frame_t*) frame;
-            for (size_t i = 0; i < xid->param_count; i++) {
-                xid->parameters[i]->free(xid->parameters[i], err);
-            }
-            free(xid->parameters);
-            break;
-        }
         case AX25_FRAME_UNNUMBERED_TEST:
-            free(((ax25_test_frame_t*) frame)->payload);
+            payload = &((ax25_test_frame_t*) frame)->payload;
+            len = &((ax25_test_frame_t*) frame)->payload_len;
         break;
         case AX25_FRAME_INFORMATION_8BIT:
         case AX25_FRAME_INFORMATION_16BIT:
-            free(((ax25_information_frame_t*) frame)->payload);
+            payload = &((ax25_information_frame_t*) frame)->payload;
+            len = &((ax25_information_frame_t*) frame)->payload_len;
         break;
         default:
         break;
     }
 
-    free(frame);
+    if (payload && payload_len > 0) {
+        *payload = mem_alloc(arena, payload_len + extra);
+        if (!*payload) {
+            mem_free(arena, frame);
+            *err = 4;
+            return NULL;
+        }
+        memset(*payload, 0, payload_len + extra);
+        *len = payload_len;
+    }
+
+    return frame;
+}
+
+ax25_frame_t* ax25_frame_create(ax25_frame_type_t type, const ax25_frame_header_t *header, uint8_t *err) {
+    return frame_create(type, header, 0, NULL, err);
+}
+
+void ax25_frame_pool_init(ax25_frame_pool_t *pool, ax25_frame_pool_slot_t *slots, size_t count) {
+    pool->slots = slots;
+    pool->count = count;
+    pool->free_list = NULL;
+    pool->in_use = 0;
+    pool->peak = 0;
+    pool->fallbacks = 0;
+
+    // Chained back to front so that slots are handed out in address order
+    for (size_t i = count; i > 0; i--) {
+        slots[i - 1].next = pool->free_list;
+        pool->free_list = &slots[i - 1];
+    }
+}
+
+static ax25_frame_pool_slot_t* frame_pool_take(ax25_frame_pool_t *pool) {
+    ax25_frame_pool_slot_t *slot = pool->free_list;
+
+    if (slot) {
+        pool->free_list = slot->next;
+        if (++pool->in_use > pool->peak)
+            pool->peak = pool->in_use;
+    }
+    return slot;
+}
+
+static void frame_pool_give(ax25_frame_pool_t *pool, ax25_frame_pool_slot_t *slot) {
+    slot->next = pool->free_list;
+    pool->free_list = slot;
+    pool->in_use--;
+}
+
+// Slot holding a frame, or NULL for a heap frame
+static ax25_frame_pool_slot_t* frame_pool_slot(const ax25_frame_pool_t *pool, const ax25_frame_t *frame) {
+    uintptr_t base = (uintptr_t) pool->slots;
+    uintptr_t addr = (uintptr_t) frame;
+
+    if (addr < base || addr >= base + pool->count * sizeof(ax25_frame_pool_slot_t))
+        return NULL;
+    return &pool->slots[(addr - base) / sizeof(ax25_frame_pool_slot_t)];
+}
+
+ax25_frame_t* ax25_frame_pool_decode(ax25_frame_pool_t *pool, const uint8_t *data, size_t len, int modulo128, uint8_t *err) {
+    ax25_frame_pool_slot_t *slot = frame_pool_take(pool);
+
+    if (slot) {
+        mem_arena_t arena;
+        mem_arena_init(&arena, slot->bytes, sizeof(slot->bytes));
+        ax25_frame_t *frame = ax25_frame_decode_arena(data, len, modulo128, &arena, err);
+        if (frame)
+            return frame;
+        frame_pool_give(pool, slot);
+        if (*err != 8)
+            return NULL; // Malformed frame, only an overflowing slot is retried on the heap
+    }
+
+    ax25_frame_t *frame = ax25_frame_decode(data, len, modulo128, err);
+    if (frame)
+        pool->fallbacks++;
+    return frame;
+}
+
+ax25_frame_t* ax25_frame_pool_create(ax25_frame_pool_t *pool, ax25_frame_type_t type, const ax25_frame_header_t *header, size_t payload_len,
+        uint8_t *err) {
+    ax25_frame_pool_slot_t *slot = frame_pool_take(pool);
+
+    if (slot) {
+        mem_arena_t arena;
+        mem_arena_init(&arena, slot->bytes, sizeof(slot->bytes));
+        ax25_frame_t *frame = frame_create(type, header, payload_len, &arena, err);
+        if (frame)
+            return frame;
+        frame_pool_give(pool, slot);
+        if (*err != 4)
+            return NULL;
+    }
+
+    ax25_frame_t *frame = frame_create(type, header, payload_len, NULL, err);
+    if (frame)
+        pool->fallbacks++;
+    return frame;
+}
+
+void ax25_frame_pool_free(ax25_frame_pool_t *pool, ax25_frame_t *frame, uint8_t *err) {
+    *err = 0;
+
+    if (!frame) {
+        *err = 1;
+        return;
+    }
+
+    ax25_frame_pool_slot_t *slot = frame_pool_slot(pool, frame);
+    if (!slot) {
+        ax25_frame_free(frame, err);
+        return;
+    }
+
+    frame_free_members(frame, slot, slot + 1, err);
+    frame_pool_give(pool, slot);
 }
 
 uint8_t* ax25_raw_frame_encode(const ax25_raw_frame_t *frame, size_t *len, uint8_t *err) {
@@ -640,47 +1339,19 @@ uint8_t* ax25_raw_frame_encode(const ax25_raw_frame_t *frame, size_t *len, uint8
     return bytes;
 }
 
-ax25_unnumbered_frame_t* ax25_unnumbered_frame_decode(ax25_frame_header_t *header, uint8_t control, const uint8_t *data, size_t len, uint8_t *err) {
-    *err = 0;
-    uint8_t modifier = control & 0xEF;
-    bool pf = (control & POLL_FINAL_8BIT) != 0;
-    ax25_unnumbered_frame_t *result = NULL;
+// Decodes a U-frame whose address field is already parsed, for the per-type decoders below
+static ax25_frame_t* unnumbered_decode(const ax25_frame_header_t *header, uint8_t control, const uint8_t *data, size_t len, uint8_t *err) {
+    ax25_frame_storage_t storage;
 
-    switch (modifier) {
-        case 0x03: // UI
-            result = (ax25_unnumbered_frame_t*) ax25_unnumbered_information_frame_decode(header, pf, data, len, err);
-        break;
-        case 0x87: // FRMR
-            result = (ax25_unnumbered_frame_t*) ax25_frame_reject_frame_decode(header, pf, data, len, err);
-        break;
-        case 0xAF: // XID
-            result = (ax25_unnumbered_frame_t*) ax25_exchange_identification_frame_decode(header, pf, data, len, err);
-        break;
-        case 0xE3: // TEST
-            result = (ax25_unnumbered_frame_t*) ax25_test_frame_decode(header, pf, data, len, err);
-        break;
-        case 0x2F: // SABM
-        case 0x6F: // SABME
-        case 0x43: // DISC
-        case 0x0F: // DM
-        case 0x63: // UA
-            result = malloc(sizeof(ax25_unnumbered_frame_t));
-            if (!result) {
-                *err = 6;
-                return NULL;
-            }
-            result->base.type = (modifier == 0x2F) ? AX25_FRAME_UNNUMBERED_SABM : (modifier == 0x6F) ? AX25_FRAME_UNNUMBERED_SABME :
-                                (modifier == 0x43) ? AX25_FRAME_UNNUMBERED_DISC : (modifier == 0x0F) ? AX25_FRAME_UNNUMBERED_DM : AX25_FRAME_UNNUMBERED_UA;
-            result->base.header = *header;
-            result->pf = pf;
-            result->modifier = modifier;
-        break;
-        default:
-            *err = 6; // Invalid U-frame modifier
-            return NULL;
-    }
+    *err = 0;
+    storage.base.header = *header;
+    if (!unnumbered_parse(control, data, len, &storage, err))
+        return NULL;
+    return frame_copy_out(&storage, data, len, NULL, err);
+}
 
-    return result;
+ax25_unnumbered_frame_t* ax25_unnumbered_frame_decode(ax25_frame_header_t *header, uint8_t control, const uint8_t *data, size_t len, uint8_t *err) {
+    return (ax25_unnumbered_frame_t*) unnumbered_decode(header, control, data, len, err);
 }
 
 uint8_t* ax25_unnumbered_frame_encode(const ax25_unnumbered_frame_t *frame, size_t *len, uint8_t *err) {
@@ -701,38 +1372,7 @@ uint8_t* ax25_unnumbered_frame_encode(const ax25_unnumbered_frame_t *frame, size
 
 ax25_unnumbered_information_frame_t* ax25_unnumbered_information_frame_decode(ax25_frame_header_t *header, bool pf, const uint8_t *data, size_t len,
         uint8_t *err) {
-    if (len < 1) { // Need at least PID byte
-        *err = 1;
-        return NULL;
-    }
-
-    ax25_unnumbered_information_frame_t *ui_frame = malloc(sizeof(ax25_unnumbered_information_frame_t));
-    if (!ui_frame) {
-        *err = 1;
-        return NULL;
-    }
-
-    ui_frame->base.base.type = AX25_FRAME_UNNUMBERED_INFORMATION;
-    ui_frame->base.base.header = *header;
-    ui_frame->base.pf = pf;
-    ui_frame->base.modifier = 0x03; // UI frame modifier
-    ui_frame->pid = data[0];
-
-    // Allocate payload with an extra byte for null terminator
-    ui_frame->payload_len = len - 1;
-    ui_frame->payload = malloc(ui_frame->payload_len + 1); // +1 for null terminator
-    if (!ui_frame->payload) {
-        *err = 1;
-        free(ui_frame);
-        return NULL;
-    }
-
-    // Copy payload and ensure null termination
-    memcpy(ui_frame->payload, data + 1, ui_frame->payload_len);
-    ui_frame->payload[ui_frame->payload_len] = '\0';
-
-    *err = 0;
-    return ui_frame;
+    return (ax25_unnumbered_information_frame_t*) unnumbered_decode(header, 0x03 | (pf ? POLL_FINAL_8BIT : 0), data, len, err);
 }
 
 uint8_t* ax25_unnumbered_information_frame_encode(const ax25_unnumbered_information_frame_t *frame, size_t *len, uint8_t *err) {
@@ -753,60 +1393,7 @@ uint8_t* ax25_unnumbered_information_frame_encode(const ax25_unnumbered_informat
 }
 
 ax25_frame_reject_frame_t* ax25_frame_reject_frame_decode(ax25_frame_header_t *header, bool pf, const uint8_t *data, size_t len, uint8_t *err) {
-    *err = 0;
-
-    // The modulo type should be determined by the caller (ax25_frame_decode) via modulo128 parameter
-    // However, since this function is called directly in tests, we need to infer it correctly
-    // For consistency, we'll assume modulo-128 if the data length is 5 bytes (as per AX.25 spec)
-    bool is_modulo128 = (len == 5);
-
-    // Check expected data length
-    size_t expected_len = is_modulo128 ? 5 : 3;
-    if (len != expected_len) {
-        *err = 1; // Invalid length
-        return NULL;
-    }
-
-    // Allocate frame structure
-    ax25_frame_reject_frame_t *frame = malloc(sizeof(ax25_frame_reject_frame_t));
-    if (!frame) {
-        *err = 2; // Memory allocation failed
-        return NULL;
-    }
-
-    // Initialize base fields
-    frame->base.base.type = AX25_FRAME_UNNUMBERED_FRMR;
-    frame->base.base.header = *header;
-    frame->base.pf = pf;
-    frame->base.modifier = 0x87; // FRMR control byte
-    frame->is_modulo128 = is_modulo128;
-
-    if (is_modulo128) {
-        // Parse 5-byte data field
-        frame->frmr_control = data[0] | (data[1] << 8);        // 16-bit control field
-        frame->vs = (data[2] >> 1) & 0x7F;                     // N(s): 7 bits
-        frame->frmr_cr = data[2] & 0x01;                       // CR: 1 bit
-        frame->vr = (data[3] >> 1) & 0x7F;                     // N(r): 7 bits
-        uint8_t flags = data[4];
-        frame->w = (flags & 0x01) != 0;
-        frame->x = (flags & 0x02) != 0;
-        frame->y = (flags & 0x04) != 0;
-        frame->z = (flags & 0x08) != 0;
-    } else {
-        // Parse 3-byte data field
-        frame->frmr_control = data[0];                         // 8-bit control field
-        uint8_t vr_cr_vs = data[1];
-        frame->vr = (vr_cr_vs >> 5) & 0x07;                    // V(r): 3 bits
-        frame->frmr_cr = (vr_cr_vs & 0x10) != 0;               // CR: 1 bit
-        frame->vs = (vr_cr_vs >> 1) & 0x07;                    // V(s): 3 bits
-        uint8_t flags = data[2];
-        frame->w = (flags & 0x01) != 0;
-        frame->x = (flags & 0x02) != 0;
-        frame->y = (flags & 0x04) != 0;
-        frame->z = (flags & 0x08) != 0;
-    }
-
-    return frame;
+    return (ax25_frame_reject_frame_t*) unnumbered_decode(header, 0x87 | (pf ? POLL_FINAL_8BIT : 0), data, len, err);
 }
 
 uint8_t* ax25_frame_reject_frame_encode(const ax25_frame_reject_frame_t *frame, size_t *len, uint8_t *err) {
@@ -843,39 +1430,12 @@ uint8_t* ax25_frame_reject_frame_encode(const ax25_frame_reject_frame_t *frame,
 
 ax25_information_frame_t* ax25_information_frame_decode(ax25_frame_header_t *header, uint16_t control, const uint8_t *data, size_t len, bool is_16bit,
         uint8_t *err) {
-    *err = 0;
-    ax25_information_frame_t *frame = malloc(sizeof(ax25_information_frame_t));
-    if (!frame) {
-        *err = 1;
-        return NULL;
-    }
-    frame->base.type = is_16bit ? AX25_FRAME_INFORMATION_16BIT : AX25_FRAME_INFORMATION_8BIT;
-    frame->base.header = *header;
-    frame->nr = is_16bit ? ((control & 0xFE00) >> 9) : ((control & 0xE0) >> 5);
-    frame->pf = (control & (is_16bit ? POLL_FINAL_16BIT : POLL_FINAL_8BIT)) != 0;
-    frame->ns = is_16bit ? ((control & 0x00FE) >> 1) : ((control & 0x0E) >> 1);
+    ax25_frame_storage_t storage;
 
-    if (len == 0) {
-        frame->pid = 0;
-        frame->payload_len = 0;
-        frame->payload = NULL;
-    } else {
-        if (len < 1) {
-            *err = 2;
-            free(frame);
-            return NULL;
-        }
-        frame->pid = data[0];
-        frame->payload_len = len - 1;
-        frame->payload = malloc(frame->payload_len);
-        if (!frame->payload && frame->payload_len > 0) {
-            *err = 3;
-            free(frame);
-            return NULL;
-        }
-        memcpy(frame->payload, data + 1, frame->payload_len);
-    }
-    return frame;
+    *err = 0;
+    storage.base.header = *header;
+    information_parse(control, data, len, is_16bit, &storage);
+    return (ax25_information_frame_t*) frame_copy_out(&storage, NULL, 0, NULL, err);
 }
 
 uint8_t* ax25_information_frame_encode(const ax25_information_frame_t *frame, size_t *len, uint8_t *err) {
@@ -927,78 +1487,37 @@ uint8_t* ax25_supervisory_frame_encode(const ax25_supervisory_frame_t *frame, si
 }
 
 ax25_supervisory_frame_t* ax25_supervisory_frame_decode(ax25_frame_header_t *header, uint16_t control, bool is_16bit, uint8_t *err) {
-    *err = 0;
-    uint8_t code = (control & 0x0C);
-    ax25_frame_type_t type;
-
-    if (is_16bit) {
-        switch (code) {
-            case 0x00:
-                type = AX25_FRAME_SUPERVISORY_RR_16BIT;
-            break;
-            case 0x04:
-                type = AX25_FRAME_SUPERVISORY_RNR_16BIT;
-            break;
-            case 0x08:
-                type = AX25_FRAME_SUPERVISORY_REJ_16BIT;
-            break;
-            case 0x0C:
-                type = AX25_FRAME_SUPERVISORY_SREJ_16BIT;
-            break;
-            default:
-                return NULL;
-        }
-    } else {
-        switch (code) {
-            case 0x00:
-                type = AX25_FRAME_SUPERVISORY_RR_8BIT;
-            break;
-            case 0x04:
-                type = AX25_FRAME_SUPERVISORY_RNR_8BIT;
-            break;
-            case 0x08:
-                type = AX25_FRAME_SUPERVISORY_REJ_8BIT;
-            break;
-            case 0x0C:
-                type = AX25_FRAME_SUPERVISORY_SREJ_8BIT;
-            break;
-            default:
-                *err = 1;
-                return NULL;
-        }
-    }
+    ax25_frame_storage_t storage;
 
-    ax25_supervisory_frame_t *frame = malloc(sizeof(ax25_supervisory_frame_t));
-    if (!frame) {
-        *err = 2;
-        return NULL;
-    }
-    frame->base.type = type;
-    frame->base.header = *header;
-    frame->nr = is_16bit ? ((control & 0xFE00) >> 9) : ((control & 0xE0) >> 5);
-    frame->pf = (control & (is_16bit ? POLL_FINAL_16BIT : POLL_FINAL_8BIT)) != 0;
-    frame->code = code;
+    *err = 0;
+    storage.base.header = *header;
+    supervisory_parse(control, is_16bit, &storage);
+    return (ax25_supervisory_frame_t*) frame_copy_out(&storage, NULL, 0, NULL, err);
+}
 
-    return frame;
+// Parameters decoded into an arena are released with the arena
+static void xid_arena_parameter_free(ax25_xid_parameter_t *param, uint8_t *err) {
+    (void) param;
+    *err = 0;
 }
 
-ax25_xid_parameter_t* ax25_xid_raw_parameter_new(int pi, const uint8_t *pv, size_t pv_len, uint8_t *err) {
+static ax25_xid_parameter_t* xid_raw_parameter_new(int pi, const uint8_t *pv, size_t pv_len, mem_arena_t *arena, uint8_t *err) {
     *err = 0;
     if (pv_len > 255) {
         *err = 1;
         return NULL;
     }
-    ax25_xid_parameter_t *param = malloc(sizeof(ax25_xid_parameter_t));
+    ax25_xid_parameter_t *param = mem_alloc(arena, sizeof(ax25_xid_parameter_t));
     if (!param) {
         *err = 2;
         return NULL;
     }
     ax25_raw_param_data_t *data = NULL;
     if (pv) {
-        data = malloc(sizeof(ax25_raw_param_data_t) + pv_len);
+        data = mem_alloc(arena, sizeof(ax25_raw_param_data_t) + pv_len);
         if (!data) {
             *err = 3;
-            free(param);
+            mem_free(arena, param);
             return NULL;
         }
         data->pv_len = pv_len;
@@ -1007,11 +1526,15 @@ ax25_xid_parameter_t* ax25_xid_raw_parameter_new(int pi, const uint8_t *pv, size
     param->pi = pi;
     param->encode = ax25_xid_raw_parameter_encode;
     param->copy = ax25_xid_raw_parameter_copy;
-    param->free = ax25_xid_raw_parameter_free;
+    param->free = arena ? xid_arena_parameter_free : ax25_xid_raw_parameter_free;
     param->data = data;
     return param;
 }
 
+ax25_xid_parameter_t* ax25_xid_raw_parameter_new(int pi, const uint8_t *pv, size_t pv_len, uint8_t *err) {
+    return xid_raw_parameter_new(pi, pv, pv_len, NULL, err);
+}
+
 uint8_t* ax25_xid_raw_parameter_encode(const ax25_xid_parameter_t *param, size_t *len, uint8_t *err) {
     *err = 0;
     ax25_raw_param_data_t *data = (ax25_raw_param_data_t*) param->data;
@@ -1048,7 +1571,7 @@ void ax25_xid_raw_parameter_free(ax25_xid_parameter_t *param, uint8_t *err) {
     free(param);
 }
 
-ax25_xid_parameter_t* ax25_xid_parameter_decode(const uint8_t *data, size_t len, size_t *consumed, uint8_t *err) {
+static ax25_xid_parameter_t* xid_parameter_decode(const uint8_t *data, size_t len, size_t *consumed, mem_arena_t *arena, uint8_t *err) {
     *err = 0;
 
     if (len < 2) {
@@ -1063,7 +1586,7 @@ ax25_xid_parameter_t* ax25_xid_parameter_decode(const uint8_t *data, size_t len,
         return NULL;
     }
 
-    ax25_xid_parameter_t *param = ax25_xid_raw_parameter_new(pi, data + 2, pv_len, err);
+    ax25_xid_parameter_t *param = xid_raw_parameter_new(pi, data + 2, pv_len, arena, err);
     if (!param) {
         *err = 3;
         return NULL;
@@ -1074,75 +1597,45 @@ ax25_xid_parameter_t* ax25_xid_parameter_decode(const uint8_t *data, size_t len,
     return param;
 }
 
-ax25_exchange_identification_frame_t* ax25_exchange_identification_frame_decode(ax25_frame_header_t *header, bool pf, const uint8_t *data, size_t len,
-        uint8_t *err) {
-    *err = 0;
-
-    if (len < 4) {
-        *err = 1;
-        return NULL;
-    }
-
-    uint8_t fi = data[0];
-    uint8_t gi = data[1];
-    uint16_t gl = uint_decode(data + 2, 2, true, err);
-
-    if (len - 4 != gl) {
-        *err = 2;
-        return NULL;
-    }
+ax25_xid_parameter_t* ax25_xid_parameter_decode(const uint8_t *data, size_t len, size_t *consumed, uint8_t *err) {
+    return xid_parameter_decode(data, len, consumed, NULL, err);
+}
 
+// Decodes a parameter field already checked by unnumbered_parse() into the frame's parameter list
+static bool xid_parameters_decode(const uint8_t *data, size_t len, ax25_exchange_identification_frame_t *frame, mem_arena_t *arena, uint8_t *err) {
     ax25_xid_parameter_t **params = NULL;
     size_t param_count = 0;
-    const uint8_t *param_data = data + 4;
-    size_t remaining = gl;
 
-    while (remaining > 0) {
+    while (len > 0) {
         size_t consumed;
-        ax25_xid_parameter_t *param = ax25_xid_parameter_decode(param_data, remaining, &consumed, err);
-        if (!param) {
-            *err = 3;
-            for (size_t i = 0; i < param_count; i++)
-                params[i]->free(params[i], err);
-            free(params);
-            return NULL;
-        }
-
-        ax25_xid_parameter_t **new_params = realloc(params, (param_count + 1) * sizeof(ax25_xid_parameter_t*));
+        ax25_xid_parameter_t *param = xid_parameter_decode(data, len, &consumed, arena, err);
+        ax25_xid_parameter_t **new_params = NULL;
+        if (param)
+            new_params = mem_realloc(arena, params, param_count * sizeof(ax25_xid_parameter_t*), (param_count + 1) * sizeof(ax25_xid_parameter_t*));
         if (!new_params) {
-            *err = 4;
-            param->free(param, err);
+            if (param)
+                param->free(param, err);
             for (size_t i = 0; i < param_count; i++)
                 params[i]->free(params[i], err);
-            free(params);
-            return NULL;
+            mem_free(arena, params);
+            *err = 8; // The field is already checked, so only an allocation can fail
+            return false;
         }
 
         params = new_params;
         params[param_count++] = param;
-        param_data += consumed;
-        remaining -= consumed;
-    }
-
-    ax25_exchange_identification_frame_t *frame = malloc(sizeof(ax25_exchange_identification_frame_t));
-    if (!frame) {
-        *err = 5;
-        for (size_t i = 0; i < param_count; i++)
-            params[i]->free(params[i], err);
-        free(params);
-        return NULL;
+        data += consumed;
+        len -= consumed;
     }
 
-    frame->base.base.type = AX25_FRAME_UNNUMBERED_XID;
-    frame->base.base.header = *header;
-    frame->base.pf = pf;
-    frame->base.modifier = 0xAF;
-    frame->fi = fi;
-    frame->gi = gi;
     frame->parameters = params;
     frame->param_count = param_count;
+    return true;
+}
 
-    return frame;
+ax25_exchange_identification_frame_t* ax25_exchange_identification_frame_decode(ax25_frame_header_t *header, bool pf, const uint8_t *data, size_t len,
+        uint8_t *err) {
+    return (ax25_exchange_identification_frame_t*) unnumbered_decode(header, 0xAF | (pf ? POLL_FINAL_8BIT : 0), data, len, err);
 }
 
 uint8_t* ax25_exchange_identification_frame_encode(const ax25_exchange_identification_frame_t *frame, size_t *len, uint8_t *err) {
@@ -1202,29 +1695,7 @@ uint8_t* ax25_exchange_identification_frame_encode(const ax25_exchange_identific
 }
 
 ax25_test_frame_t* ax25_test_frame_decode(ax25_frame_header_t *header, bool pf, const uint8_t *data, size_t len, uint8_t *err) {
-    *err = 0;
-
-    ax25_test_frame_t *frame = malloc(sizeof(ax25_test_frame_t));
-    if (!frame) {
-        *err = 1;
-        return NULL;
-    }
-
-    frame->base.base.type = AX25_FRAME_UNNUMBERED_TEST;
-    frame->base.base.header = *header;
-    frame->base.pf = pf;
-    frame->base.modifier = 0xE3;
-    frame->payload_len = len;
-    frame->payload = malloc(len);
-
-    if (!frame->payload) {
-        *err = 2;
-        free(frame);
-        return NULL;
-    }
-    memcpy(frame->payload, data, len);
-
-    return frame;
+    return (ax25_test_frame_t*) unnumbered_decode(header, 0xE3 | (pf ? POLL_FINAL_8BIT : 0), data, len, err);
 }
 
 uint8_t* ax25_test_frame_encode(const ax25_test_frame_t *frame, size_t *len, uint8_t *err) {
@@ -1515,3 +1986,128 @@ void ax25_free_segmented_info(ax25_segmented_info_t *segments, size_t num_segmen
     }
     free(segments);
 }
+
+void ax25_reassembler_init(ax25_reassembler_t *reassembler, uint8_t *buffer, size_t capacity) {
+    memset(reassembler, 0, sizeof(ax25_reassembler_t));
+    reassembler->buffer = buffer;
+    reassembler->capacity = capacity;
+    reassembler->last = -1;
+}
+
+void ax25_reassembler_reset(ax25_reassembler_t *reassembler) {
+    reassembler->total_length = 0;
+    reassembler->first_len = 0;
+    reassembler->segment_size = 0;
+    reassembler->last_len = 0;
+    reassembler->last = -1;
+    reassembler->first_seen = false;
+    reassembler->complete = false;
+    reassembler->last_parked = false;
+    reassembler->received = 0;
+}
+
+static int reassembler_reject(ax25_reassembler_t *reassembler, uint8_t code, uint8_t *err) {
+    *err = code;
+    reassembler->errors++;
+    return -1;
+}
+
+int ax25_reassembler_push(ax25_reassembler_t *reassembler, const uint8_t *segment, size_t len, uint8_t *err) {
+    *err = 0;
+    if (reassembler->complete)
+        ax25_reassembler_reset(reassembler);
+    if (len < 1)
+        return reassembler_reject(reassembler, 1, err);
+
+    uint8_t control = segment[0];
+    bool begin = (control & 0x80) != 0;
+    bool end = (control & 0x40) != 0;
+    int number = control & 0x3F;
+    const uint8_t *data = segment + 1;
+    size_t data_len = len - 1;
+    size_t offset;
+
+    if (begin) {
+        if (number != 0 || len < 3)
+            return reassembler_reject(reassembler, 1, err);
+        size_t total_length = (segment[1] << 8) | segment[2];
+        if (total_length > reassembler->capacity)
+            return reassembler_reject(reassembler, 2, err);
+        // A first segment announcing another length starts a new payload; otherwise it is a copy
+        if (reassembler->first_seen && total_length != reassembler->total_length) {
+            reassembler->errors++;
+            ax25_reassembler_reset(reassembler);
+        }
+        data += 2;
+        data_len -= 2;
+        if (!end && reassembler->segment_size && reassembler->segment_size != data_len + 2)
+            return reassembler_reject(reassembler, 3, err);
+        reassembler->first_seen = true;
+        reassembler->total_length = total_length;
+        reassembler->first_len = data_len;
+        if (!end)
+            reassembler->segment_size = data_len + 2;
+        offset = 0;
+    } else {
+        if (number == 0)
+            return reassembler_reject(reassembler, 1, err);
+        if (!end) {
+            // Every segment but the first and the last has the same size, N1 - 2
+            if (data_len == 0 || (reassembler->segment_size && reassembler->segment_size != data_len))
+                return reassembler_reject(reassembler, 3, err);
+            reassembler->segment_size = data_len;
+        }
+        offset = reassembler->segment_size - 2 + (number - 1) * reassembler->segment_size;
+    }
+
+    if ((reassembler->received >> number) & 1)
+        return 0;
+    if (end && reassembler->last >= 0)
+        return reassembler_reject(reassembler, 4, err);
+    // No segment may lie beyond the last one
+    if (reassembler->last >= 0 && number > reassembler->last)
+        return reassembler_reject(reassembler, 4, err);
+    if (end && number < 63 && (reassembler->received >> (number + 1)) != 0)
+        return reassembler_reject(reassembler, 4, err);
+    if (end && number > 0 && reassembler->segment_size == 0) {
+        // The last segment came before any segment giving the size: park it at the end of the
+        // buffer until its place is known
+        if (data_len > reassembler->capacity)
+            return reassembler_reject(reassembler, 2, err);
+        offset = reassembler->capacity - data_len;
+        reassembler->last_parked = true;
+    } else if (offset + data_len > reassembler->capacity) {
+        return reassembler_reject(reassembler, 2, err);
+    }
+    if (reassembler->last_parked && reassembler->segment_size) {
+        size_t last_offset = reassembler->segment_size - 2 + (reassembler->last - 1) * reassembler->segment_size;
+        if (last_offset + reassembler->last_len > reassembler->capacity) {
+            ax25_reassembler_reset(reassembler);
+            return reassembler_reject(reassembler, 2, err);
+        }
+        memmove(reassembler->buffer + last_offset, reassembler->buffer + reassembler->capacity - reassembler->last_len, reassembler->last_len);
+        reassembler->last_parked = false;
+    }
+    if (end) {
+        reassembler->last = number;
+        reassembler->last_len = data_len;
+    }
+    memcpy(reassembler->buffer + offset, data, data_len);
+    reassembler->received |= 1ULL << number;
+
+    if (!reassembler->first_seen || reassembler->last < 0)
+        return 0;
+    uint64_t all = (reassembler->last == 63) ? ~0ULL : (1ULL << (reassembler->last + 1)) - 1;
+    if (reassembler->received != all)
+        return 0;
+
+    size_t length = (reassembler->last == 0) ? reassembler->first_len
+            : reassembler->first_len + (reassembler->last - 1) * reassembler->segment_size + reassembler->last_len;
+    if (length != reassembler->total_length) {
+        ax25_reassembler_reset(reassembler);
+        return reassembler_reject(reassembler, 5, err);
+    }
+    reassembler->complete = true;
+    reassembler->payloads++;
+    return 1;
+}
@@ -26,6 +26,8 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "common.h"
+
 /**
  * @defgroup ControlFieldMasks Control Field Masks and Values
  * @{
@@ -165,6 +167,37 @@ typedef struct {
     int segment_number;     ///< Segment sequence number
 } ax25_reassembly_segment_t;
 
+/**
+ * @brief Largest payload announced by a first segment (16-bit total length).
+ */
+#define AX25_REASSEMBLY_MAX_LEN 65535
+
+/**
+ * @brief State of a streaming reassembler for PID 0x08 segments, one per link.
+ *
+ * Segments are pushed one at a time, in any order, and each one is copied once, straight to
+ * its final place in a buffer owned by the caller. The place follows from the segment number
+ * and the segment size, learnt from the first full-size segment received; only a last segment
+ * arriving before any of those waits at the end of the buffer and is moved once. A bitmap
+ * records the segments placed, so that duplicates are ignored and completion is a single
+ * comparison. The structure requires no dynamic memory.
+ */
+typedef struct {
+    uint8_t *buffer;       ///< Payload buffer given to ax25_reassembler_init()
+    size_t capacity;       ///< Size of the buffer in bytes
+    size_t total_length;   ///< Payload length announced by the first segment
+    size_t first_len;      ///< Data bytes in the first segment
+    size_t segment_size;   ///< Data bytes in a segment other than the first and last, 0 until known
+    size_t last_len;       ///< Data bytes in the last segment
+    int last;              ///< Number of the segment with the end flag, -1 until it arrives
+    bool first_seen;       ///< The first segment has arrived
+    bool complete;         ///< The payload is complete, cleared by the next push
+    bool last_parked;      ///< The last segment waits at the end of the buffer for its place
+    uint64_t received;     ///< Bit n set when segment n has been placed
+    uint32_t payloads;     ///< Payloads reassembled
+    uint32_t errors;       ///< Segments rejected and payloads abandoned
+} ax25_reassembler_t;
+
 /**
  * @brief Structure representing an AX.25 address.
  *
@@ -199,6 +232,27 @@ typedef struct {
     bool extension;              ///< HDLC extension bit (1 = last address)
 } ax25_address_t;
 
+/**
+ * @brief Canonical packed form of an AX.25 address.
+ *
+ * The seven address bytes exactly as sent on the wire (six shifted callsign characters padded
+ * with spaces, then the SSID byte with the C/H, reserved and extension bits) held big-endian
+ * in the low 56 bits of a uint64_t. The upper 8 bits are always zero.
+ *
+ * Use AX25_PACKED_ADDRESS_EQUALS() to compare the station identity (callsign and SSID, flags
+ * ignored) and AX25_PACKED_ADDRESS_HASH() for hash tables; both compile to a few instructions.
+ */
+typedef uint64_t ax25_packed_address_t;
+
+#define AX25_PACKED_ID_MASK  0x00FFFFFFFFFFFF1EULL ///< Callsign and SSID bits of a packed address
+#define AX25_PACKED_CH_BIT   0x80ULL               ///< C bit (dest/source) or H bit (repeater)
+#define AX25_PACKED_EXT_BIT  0x01ULL               ///< HDLC extension bit
+
+/// True if two packed addresses have the same callsign and SSID
+#define AX25_PACKED_ADDRESS_EQUALS(a, b) ((((a) ^ (b)) & AX25_PACKED_ID_MASK) == 0)
+/// 32-bit hash of the callsign and SSID of a packed address (Fibonacci hashing)
+#define AX25_PACKED_ADDRESS_HASH(a)      ((uint32_t) ((((a) & AX25_PACKED_ID_MASK) * 0x9E3779B97F4A7C15ULL) >> 32))
+
 /**
  * @brief Structure representing the path of repeaters in an AX.25 frame.
  *
@@ -512,6 +566,88 @@ typedef struct {
     size_t payload_len;           ///< Payload length in bytes
 } ax25_test_frame_t;
 
+/**
+ * @brief Caller-owned storage large enough for any frame decoded by ax25_frame_decode_into().
+ *
+ * All members start with the common ax25_frame_t, so the decoded frame is accessed through
+ * the returned ax25_frame_t pointer and cast to the subtype given by its type field, exactly
+ * as with frames returned by ax25_frame_decode(). Every decoder parses into this storage
+ * first. ax25_frame_decode_into() still rejects XID frames since their parameter list needs
+ * dynamic storage, use ax25_frame_decode_arena() for those.
+ */
+typedef union {
+    ax25_frame_t base;                            ///< Common frame header
+    ax25_raw_frame_t raw;                         ///< AX25_FRAME_RAW
+    ax25_unnumbered_frame_t unnumbered;           ///< SABM, SABME, DISC, DM, UA
+    ax25_unnumbered_information_frame_t ui;       ///< UI
+    ax25_frame_reject_frame_t frmr;               ///< FRMR
+    ax25_exchange_identification_frame_t xid;     ///< XID, without its parameter list
+    ax25_test_frame_t test;                       ///< TEST
+    ax25_information_frame_t information;         ///< I-frames
+    ax25_supervisory_frame_t supervisory;         ///< RR, RNR, REJ, SREJ
+} ax25_frame_storage_t;
+
+/**
+ * @defgroup Ax25FramePoolLimits AX.25 Frame Pool Limits
+ * @{
+ * May be overridden at compile time.
+ */
+#ifndef AX25_FRAME_POOL_INLINE_LEN
+#define AX25_FRAME_POOL_INLINE_LEN 256 ///< Payload bytes stored inside a pool slot, after the frame structure
+#endif
+/** @} */
+
+/**
+ * @brief Size of one pool slot: the largest frame structure, the inline payload and room for
+ * the arena alignment of both.
+ */
+#define AX25_FRAME_POOL_SLOT_SIZE (sizeof(ax25_frame_storage_t) + AX25_FRAME_POOL_INLINE_LEN + 3 * MEM_ARENA_ALIGN)
+
+/**
+ * @brief One fixed-size slot of a frame pool.
+ *
+ * Holds a frame structure followed by its payload (or XID parameters) while in use, and the
+ * free list link while free.
+ */
+typedef union ax25_frame_pool_slot {
+    union ax25_frame_pool_slot *next;               ///< Next free slot
+    unsigned char bytes[AX25_FRAME_POOL_SLOT_SIZE]; ///< Frame and inline payload
+} ax25_frame_pool_slot_t;
+
+/**
+ * @brief Pool of fixed-size frame slots over a caller-provided slot array.
+ *
+ * Every frame taken from the pool, whatever its type, uses one slot of the same size, so a
+ * long-running receiver that decodes and frees frames continuously keeps a constant memory
+ * footprint and never fragments the heap. Frames that do not fit in a slot, or that arrive
+ * while every slot is in use, are allocated from the heap instead and counted in fallbacks.
+ * A pool is not thread safe: use one per thread.
+ */
+typedef struct {
+    ax25_frame_pool_slot_t *slots;     ///< Slot array given to ax25_frame_pool_init()
+    size_t count;                      ///< Number of slots
+    ax25_frame_pool_slot_t *free_list; ///< First free slot, or NULL when all are in use
+    size_t in_use;                     ///< Slots currently holding a frame
+    size_t peak;                       ///< Largest value reached by in_use, to size the slot array
+    uint32_t fallbacks;                ///< Frames allocated from the heap instead of a slot
+} ax25_frame_pool_t;
+
+/**
+ * @brief Lightweight read-only view over an encoded AX.25 frame.
+ *
+ * Created by ax25_frame_view_init(), which only locates the end of the address field.
+ * Addresses, control, PID and information are then read on demand from the original bytes
+ * by the ax25_frame_view_* accessors, without decoding or allocating anything. The view is
+ * valid as long as the frame bytes are.
+ *
+ * Addresses are numbered 0 (destination), 1 (source) and 2.. (repeaters).
+ */
+typedef struct {
+    const uint8_t *data;   ///< Frame bytes, without FCS
+    size_t len;            ///< Length of the frame in bytes
+    int num_addresses;     ///< Number of addresses in the address field (2 to 2 + MAX_REPEATERS)
+} ax25_frame_view_t;
+
 /**
  * @brief Structure to hold raw parameter data for XID parameters.
  *
@@ -613,6 +749,24 @@ void ax25_xid_deinit_defaults(uint8_t *err);
  */
 uint8_t* ax25_frame_encode(const ax25_frame_t *frame, size_t *len, uint8_t *err);
 
+/**
+ * @brief Encodes an AX.25 frame directly into a caller-provided buffer.
+ *
+ * Produces the same bytes as ax25_frame_encode(), writing the address field, control, PID
+ * and information fields in place with no intermediate buffers. Call it with buf set to NULL
+ * to query the required size. The frame has no FCS, so buf may be passed as is to
+ * hdlc_frame_encode() or hdlc_frame_encode_fast().
+ *
+ * @param frame Pointer to the AX.25 frame to encode.
+ * @param buf Pointer to the output buffer, or NULL to only compute the encoded length.
+ * @param size Size of buf in bytes.
+ * @param err Pointer to store error code (0 on success, 2 for an unknown frame type,
+ *            3 if an XID parameter fails to encode, 5 if buf is too small, in which case
+ *            nothing is written apart from possibly part of an XID information field).
+ * @return Length of the encoded frame in bytes, or 0 for an unknown frame type or a failed XID parameter.
+ */
+size_t ax25_frame_encode_into(const ax25_frame_t *frame, uint8_t *buf, size_t size, uint8_t *err);
+
 /**
  * @brief Decodes an AX.25 frame from binary data based on the specified modulo setting.
  *
@@ -626,11 +780,129 @@ uint8_t* ax25_frame_encode(const ax25_frame_t *frame, size_t *len, uint8_t *err)
  *                  - MODULO128_NONE (-1): Returns a raw frame with unparsed payload.
  *                  - MODULO128_FALSE (0): Decodes using 8-bit control field.
  *                  - MODULO128_TRUE (1): Decodes using 16-bit control field.
- * @param err Pointer to store error code (0 on success, non-zero on failure).
+ * @param err Pointer to store error code (0 on success, 8 if an allocation fails, other
+ *            non-zero values for a malformed frame).
  * @return Pointer to the decoded AX.25 frame (must be freed with ax25_frame_free).
  */
 ax25_frame_t* ax25_frame_decode(const uint8_t *data, size_t len, int modulo128, uint8_t *err);
 
+/**
+ * @brief Decodes an AX.25 frame with every allocation taken from an arena.
+ *
+ * Same decoding rules, error codes and frame layout as ax25_frame_decode(), including XID
+ * frames and null-terminated UI payloads, but the frame, its payload and its XID parameters
+ * are allocated with mem_arena_alloc(). The frame must not be passed to ax25_frame_free():
+ * it is released, together with everything else decoded into the arena, by
+ * mem_arena_reset(). A failed decode may leave unused blocks in the arena until the next
+ * reset.
+ *
+ * @param data Pointer to the binary data containing the frame.
+ * @param len Length of the input data in bytes.
+ * @param modulo128 Same as for ax25_frame_decode().
+ * @param arena Pointer to the arena to allocate from, or NULL to use the heap exactly as
+ *              ax25_frame_decode() does.
+ * @param err Pointer to store error code (0 on success, non-zero on failure, as in
+ *            ax25_frame_decode(); error 8 also reports an exhausted arena).
+ * @return Pointer to the decoded AX.25 frame inside the arena, or NULL on failure.
+ */
+ax25_frame_t* ax25_frame_decode_arena(const uint8_t *data, size_t len, int modulo128, mem_arena_t *arena, uint8_t *err);
+
+/**
+ * @brief Decodes an AX.25 frame into caller-provided storage without any heap allocation.
+ *
+ * Same decoding rules and error codes as ax25_frame_decode(), but the frame is written into
+ * storage and payload pointers (raw, UI, TEST and I-frames) point into data instead of a
+ * copy. The decoded frame is therefore only valid as long as data is, the payload is not
+ * null-terminated, and the frame must not be passed to ax25_frame_free().
+ *
+ * @param data Pointer to the binary data containing the frame.
+ * @param len Length of the input data in bytes.
+ * @param modulo128 Same as for ax25_frame_decode().
+ * @param storage Pointer to the storage that receives the decoded frame.
+ * @param err Pointer to store error code (0 on success, 7 for XID frames, which need
+ *            ax25_frame_decode(), other non-zero values as in ax25_frame_decode()).
+ * @return Pointer to the decoded frame inside storage, or NULL on failure.
+ */
+ax25_frame_t* ax25_frame_decode_into(const uint8_t *data, size_t len, int modulo128, ax25_frame_storage_t *storage, uint8_t *err);
+
+/**
+ * @brief Initializes a view over an encoded AX.25 frame.
+ *
+ * Walks the address field to find its end and checks that a control field follows. Nothing
+ * else is decoded.
+ *
+ * @param view Pointer to the view to initialize.
+ * @param data Pointer to the frame bytes, without FCS.
+ * @param len Length of the frame in bytes.
+ * @param err Pointer to store error code (0 on success, 1 if the frame is shorter than two
+ *            addresses, 3 if there is no control field, 5 if the address field is not terminated).
+ * @return true on success, false if the frame is not a valid AX.25 frame.
+ */
+bool ax25_frame_view_init(ax25_frame_view_t *view, const uint8_t *data, size_t len, uint8_t *err);
+
+/**
+ * @brief Returns the SSID of address n of a frame view, or -1 if n is out of range.
+ */
+int ax25_frame_view_ssid(const ax25_frame_view_t *view, int n);
+
+/**
+ * @brief Returns the C bit (destination, source) or H bit (repeaters) of address n of a frame view.
+ */
+bool ax25_frame_view_ch(const ax25_frame_view_t *view, int n);
+
+/**
+ * @brief Copies the callsign of address n of a frame view, without padding.
+ *
+ * @param view Pointer to an initialized view.
+ * @param n Address number.
+ * @param callsign Output buffer of CALLSIGN_MAX bytes, always null-terminated.
+ * @return Length of the callsign, or 0 if n is out of range.
+ */
+size_t ax25_frame_view_callsign(const ax25_frame_view_t *view, int n, char *callsign);
+
+/**
+ * @brief Compares address n of a frame view with a callsign and SSID in place.
+ *
+ * @param view Pointer to an initialized view.
+ * @param n Address number.
+ * @param callsign Callsign to compare with, up to 6 characters, without SSID.
+ * @param ssid SSID to compare with, or -1 to match any SSID.
+ * @return true if the address matches.
+ */
+bool ax25_frame_view_address_equals(const ax25_frame_view_t *view, int n, const char *callsign, int ssid);
+
+/**
+ * @brief Returns address n of a frame view in packed form, or 0 if n is out of range.
+ */
+ax25_packed_address_t ax25_frame_view_packed_address(const ax25_frame_view_t *view, int n);
+
+/**
+ * @brief Returns the first control byte of a frame view.
+ */
+uint8_t ax25_frame_view_control(const ax25_frame_view_t *view);
+
+/**
+ * @brief Returns the PID of a frame view.
+ *
+ * @param view Pointer to an initialized view.
+ * @param modulo128 How to size the control field of I-frames, as for ax25_frame_decode().
+ *                  With MODULO128_NONE, I and S-frames are raw frames without a PID.
+ * @return The PID for UI and I-frames, or -1 if the frame carries no PID.
+ */
+int ax25_frame_view_pid(const ax25_frame_view_t *view, int modulo128);
+
+/**
+ * @brief Returns the information field of a frame view.
+ *
+ * @param view Pointer to an initialized view.
+ * @param modulo128 Same as for ax25_frame_view_pid(). With MODULO128_NONE, the information
+ *                  field of I and S-frames is everything after the control byte, as for the
+ *                  payload of a raw frame.
+ * @param info_len Pointer where the length of the information field is stored (0 if none).
+ * @return Pointer into the frame bytes, or NULL if the frame carries no information field.
+ */
+const uint8_t* ax25_frame_view_info(const ax25_frame_view_t *view, int modulo128, size_t *info_len);
+
 /**
  * @brief Frees an AX.25 frame and its associated resources.
  *
@@ -652,11 +924,70 @@ void ax25_frame_free(ax25_frame_t *frame, uint8_t *err);
  *
  * @param type The type of frame to create (e.g., AX25_FRAME_INFORMATION_8BIT).
  * @param header The frame header containing address information.
- * @param err Pointer to store error code (0 on success, non-zero on failure).
- * @return Pointer to the new AX.25 frame (must be freed with ax25_frame_free).
+ * @param err Pointer to store error code (0 on success, 2 for an unknown frame type, 4 if
+ *            memory allocation fails).
+ * @return Pointer to the new AX.25 frame, zeroed except for type and header (must be freed
+ *         with ax25_frame_free), or NULL on failure.
  */
 ax25_frame_t* ax25_frame_create(ax25_frame_type_t type, const ax25_frame_header_t *header, uint8_t *err);
 
+/**
+ * @brief Initializes a frame pool over an array of slots.
+ *
+ * @param pool Pointer to the pool to initialize.
+ * @param slots Pointer to the slot array. It must outlive every frame taken from the pool.
+ * @param count Number of slots in the array.
+ */
+void ax25_frame_pool_init(ax25_frame_pool_t *pool, ax25_frame_pool_slot_t *slots, size_t count);
+
+/**
+ * @brief Decodes an AX.25 frame into a pool slot.
+ *
+ * Same decoding rules, error codes and frame layout as ax25_frame_decode(). The frame and its
+ * payload are placed in a single slot when they fit, otherwise on the heap. A malformed frame
+ * fails straight away, without a heap decode.
+ *
+ * @param pool Pointer to an initialized pool.
+ * @param data Pointer to the binary data containing the frame.
+ * @param len Length of the input data in bytes.
+ * @param modulo128 Same as for ax25_frame_decode().
+ * @param err Pointer to store error code (0 on success, non-zero on failure, as in ax25_frame_decode()).
+ * @return Pointer to the decoded AX.25 frame (must be freed with ax25_frame_pool_free), or NULL on failure.
+ */
+ax25_frame_t* ax25_frame_pool_decode(ax25_frame_pool_t *pool, const uint8_t *data, size_t len, int modulo128, uint8_t *err);
+
+/**
+ * @brief Creates a new AX.25 frame in a pool slot.
+ *
+ * As ax25_frame_create(), but the frame is taken from the pool and, for frame types with an
+ * information field (raw, UI, TEST and I-frames), payload_len bytes of payload storage are
+ * reserved next to it and set as the frame payload. UI payloads get an extra null
+ * terminator, as when decoded.
+ *
+ * @param pool Pointer to an initialized pool.
+ * @param type The type of frame to create.
+ * @param header The frame header containing address information.
+ * @param payload_len Payload bytes to reserve, ignored for frame types without a payload.
+ * @param err Pointer to store error code (0 on success, 2 for an unknown frame type, 4 if
+ *            memory allocation fails).
+ * @return Pointer to the new AX.25 frame (must be freed with ax25_frame_pool_free), or NULL on failure.
+ */
+ax25_frame_t* ax25_frame_pool_create(ax25_frame_pool_t *pool, ax25_frame_type_t type, const ax25_frame_header_t *header, size_t payload_len,
+        uint8_t *err);
+
+/**
+ * @brief Frees a frame returned by ax25_frame_pool_decode() or ax25_frame_pool_create().
+ *
+ * Slot frames go back to the pool; heap fallbacks are freed with ax25_frame_free(). XID
+ * parameters, and any payload or parameter list the caller attached outside the slot, are
+ * freed as by ax25_frame_free().
+ *
+ * @param pool Pointer to the pool the frame was taken from.
+ * @param frame Pointer to the frame to free.
+ * @param err Pointer to store error code (0 on success, non-zero on failure).
+ */
+void ax25_frame_pool_free(ax25_frame_pool_t *pool, ax25_frame_t *frame, uint8_t *err);
+
 /**
  * @brief Encodes an AX.25 address into a 7-byte binary array.
  *
@@ -694,6 +1025,50 @@ ax25_address_t* ax25_address_decode(const uint8_t *data, uint8_t *err);
  */
 ax25_address_t* ax25_address_from_string(const char *str, uint8_t *err);
 
+/**
+ * @brief Packs 7 address bytes in wire format into a packed address.
+ *
+ * @param data Pointer to the 7 address bytes.
+ * @return The packed address.
+ */
+ax25_packed_address_t ax25_address_pack_wire(const uint8_t *data);
+
+/**
+ * @brief Writes a packed address as 7 address bytes in wire format.
+ *
+ * @param packed The packed address.
+ * @param data Pointer to a 7-byte output buffer.
+ */
+void ax25_address_unpack_wire(ax25_packed_address_t packed, uint8_t *data);
+
+/**
+ * @brief Packs an AX.25 address structure.
+ *
+ * @param addr Pointer to the address.
+ * @return The packed address, identical to packing the output of ax25_address_encode().
+ */
+ax25_packed_address_t ax25_address_pack(const ax25_address_t *addr);
+
+/**
+ * @brief Unpacks a packed address into an AX.25 address structure.
+ *
+ * @param packed The packed address.
+ * @param addr Pointer to the address to fill in.
+ */
+void ax25_address_unpack(ax25_packed_address_t packed, ax25_address_t *addr);
+
+/**
+ * @brief Creates a packed address from a string representation.
+ *
+ * Accepts the same syntax and returns the same error codes as ax25_address_from_string(),
+ * without allocating memory.
+ *
+ * @param str String such as "NOCALL-7" or "WIDE1-1*".
+ * @param err Pointer to store error code (0 on success, non-zero on failure).
+ * @return The packed address, or 0 on failure.
+ */
+ax25_packed_address_t ax25_address_pack_string(const char *str, uint8_t *err);
+
 /**
  * @brief Creates a deep copy of an AX.25 address.
  *
@@ -1157,6 +1532,43 @@ uint8_t* ax25_reassemble_info_fields(ax25_segmented_info_t *info_fields, size_t
  */
 void ax25_free_segmented_info(ax25_segmented_info_t *segments, size_t num_segments);
 
+/**
+ * @brief Initializes a streaming segment reassembler.
+ *
+ * @param reassembler Pointer to the reassembler to initialize.
+ * @param buffer Pointer to the buffer receiving the payload. AX25_REASSEMBLY_MAX_LEN bytes
+ *               take any payload; smaller buffers reject the payloads that do not fit.
+ * @param capacity Size of the buffer in bytes.
+ */
+void ax25_reassembler_init(ax25_reassembler_t *reassembler, uint8_t *buffer, size_t capacity);
+
+/**
+ * @brief Drops a partially reassembled payload. Statistics are preserved.
+ *
+ * @param reassembler Pointer to the reassembler.
+ */
+void ax25_reassembler_reset(ax25_reassembler_t *reassembler);
+
+/**
+ * @brief Places one segment into the payload buffer.
+ *
+ * The segment is an information field with PID 0x08, from the control byte on: the PID
+ * itself is not included (for the fields of ax25_segment_info_fields(), pass info_field + 1).
+ * A first segment while another payload is in progress starts a new payload, abandoning the
+ * old one. Once complete, the payload is in the buffer until the next push.
+ *
+ * @param reassembler Pointer to an initialized reassembler.
+ * @param segment Pointer to the segment.
+ * @param len Length of the segment in bytes.
+ * @param err Pointer to store error code: 0 on success, 1 if the segment is too short or its
+ *            control byte inconsistent, 2 if the payload does not fit the buffer, 3 if the
+ *            segment size disagrees with the other segments, 4 if two segments carry the end
+ *            flag or a segment lies beyond the one carrying it, 5 if the complete payload does not add up to the announced length (the
+ *            payload is then abandoned).
+ * @return 1 if the payload is complete, 0 if the segment was placed or was a duplicate, -1 on error.
+ */
+int ax25_reassembler_push(ax25_reassembler_t *reassembler, const uint8_t *segment, size_t len, uint8_t *err);
+
 /**
  * @brief Determines if modulo 128 sequence numbering is used.
  *
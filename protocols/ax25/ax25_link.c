@@ -0,0 +1,1021 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ax25_link.h"
+
+// Unnumbered frame modifiers, P/F bit clear
+#define U_SABM  0x2F
+#define U_SABME 0x6F
+#define U_DISC  0x43
+#define U_DM    0x0F
+#define U_UA    0x63
+
+// Supervisory codes, as stored in ax25_supervisory_frame_t
+#define S_RR   0x00
+#define S_RNR  0x04
+#define S_REJ  0x08
+#define S_SREJ 0x0C
+
+#define COMMAND  true
+#define RESPONSE false
+
+static inline uint8_t seq_mask(const ax25_link_t *link) {
+    return link->modulo128 ? 0x7F : 0x07;
+}
+
+static inline uint8_t seq_add(const ax25_link_t *link, uint8_t a, uint8_t b) {
+    return (a + b) & seq_mask(link);
+}
+
+// Distance from b forward to a
+static inline uint8_t seq_diff(const ax25_link_t *link, uint8_t a, uint8_t b) {
+    return (a - b) & seq_mask(link);
+}
+
+static inline bool time_reached(uint32_t now, uint32_t t) {
+    return (int32_t) (now - t) >= 0;
+}
+
+// Bitmaps of 128 bits indexed by sequence number
+static inline bool seq_bit(const uint64_t *bits, uint8_t n) {
+    return (bits[n >> 6] >> (n & 63)) & 1;
+}
+
+static inline void seq_bit_set(uint64_t *bits, uint8_t n) {
+    bits[n >> 6] |= 1ULL << (n & 63);
+}
+
+static inline void seq_bit_clear(uint64_t *bits, uint8_t n) {
+    bits[n >> 6] &= ~(1ULL << (n & 63));
+}
+
+static size_t link_window(const ax25_link_t *link) {
+    size_t k = link->config.k;
+    if (!link->modulo128 && k > 7)
+        k = 7;
+    // A peer holding frames for SREJ tells new frames from old copies only within its reorder span
+    if (link->modulo128 && link->config.srej && k > AX25_LINK_MAX_REORDER)
+        k = AX25_LINK_MAX_REORDER;
+    return k;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Timers
+
+static void t1_start(ax25_link_t *link) {
+    link->t1_running = true;
+    link->t1_started = link->now;
+    link->t1_expiry = link->now + link->t1v;
+    if (link->wheel)
+        timer_wheel_arm(link->wheel, &link->t1_timer, link->t1v);
+}
+
+static void t1_stop(ax25_link_t *link) {
+    // How long the acknowledgement took, for select_t1_value()
+    link->t1_measured = link->t1_running;
+    link->t1_elapsed = link->now - link->t1_started;
+    link->t1_running = false;
+    if (link->wheel)
+        timer_wheel_cancel(link->wheel, &link->t1_timer);
+}
+
+static void t2_start(ax25_link_t *link) {
+    link->t2_running = true;
+    link->t2_expiry = link->now + link->config.t2;
+    if (link->wheel)
+        timer_wheel_arm(link->wheel, &link->t2_timer, link->config.t2);
+}
+
+static void t2_stop(ax25_link_t *link) {
+    link->t2_running = false;
+    if (link->wheel)
+        timer_wheel_cancel(link->wheel, &link->t2_timer);
+}
+
+static void t3_start(ax25_link_t *link) {
+    link->t3_running = true;
+    link->t3_expiry = link->now + link->config.t3;
+    if (link->wheel)
+        timer_wheel_arm(link->wheel, &link->t3_timer, link->config.t3);
+}
+
+static void t3_stop(ax25_link_t *link) {
+    link->t3_running = false;
+    if (link->wheel)
+        timer_wheel_cancel(link->wheel, &link->t3_timer);
+}
+
+static void t1_reset_value(ax25_link_t *link) {
+    link->t1v = link->config.t1;
+    link->srt = link->config.t1 / 2;
+    link->t1_measured = false;
+}
+
+// Select T1 value (Section C4.4): SRT = 7/8 SRT + 1/8 of the round trip measured by the T1 run
+// just stopped, and T1 = 2 SRT; while retrying, T1 = 2^(RC+1) SRT. Retried frames give no
+// sample, as their acknowledgement may answer any of the copies.
+static void select_t1_value(ax25_link_t *link) {
+    uint64_t t1v;
+
+    if (link->rc == 0) {
+        if (link->t1_measured) {
+            uint32_t rtt = (link->t1_elapsed < link->t1v) ? link->t1_elapsed : link->t1v;
+            link->srt = (uint32_t) ((7 * (uint64_t) link->srt + rtt) / 8);
+            link->t1_measured = false;
+        }
+        t1v = 2 * (uint64_t) link->srt;
+    } else {
+        t1v = (uint64_t) link->srt << ((link->rc < 16) ? link->rc + 1 : 16);
+    }
+
+    if (t1v < link->config.t1_min)
+        t1v = link->config.t1_min;
+    if (t1v > link->config.t1_max)
+        t1v = link->config.t1_max;
+    link->t1v = t1v ? (uint32_t) t1v : 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Output
+
+static void link_event(ax25_link_t *link, ax25_link_event_t event, ax25_link_error_t error) {
+    if (link->callbacks.event)
+        link->callbacks.event(event, error, link->ctx);
+}
+
+static void link_error(ax25_link_t *link, ax25_link_error_t error) {
+    link_event(link, AX25_LINK_ERROR, error);
+}
+
+static void link_transmit(ax25_link_t *link, ax25_frame_storage_t *frame, bool command) {
+    uint8_t buf[7 * (2 + MAX_REPEATERS) + 3 + AX25_LINK_MAX_N1];
+    uint8_t err;
+
+    frame->base.header = link->header;
+    frame->base.header.cr = command;
+    size_t len = ax25_frame_encode_into(&frame->base, buf, sizeof(buf), &err);
+    if (err != 0)
+        return;
+
+    link->frames_sent++;
+    if (link->callbacks.send)
+        link->callbacks.send(buf, len, link->ctx);
+}
+
+static void send_u(ax25_link_t *link, ax25_frame_type_t type, uint8_t modifier, bool pf, bool command) {
+    ax25_frame_storage_t frame;
+
+    frame.base.type = type;
+    frame.unnumbered.modifier = modifier;
+    frame.unnumbered.pf = pf;
+    link_transmit(link, &frame, command);
+}
+
+static void send_s(ax25_link_t *link, uint8_t code, uint8_t nr, bool pf, bool command) {
+    static const ax25_frame_type_t s_types[2][4] = {
+            { AX25_FRAME_SUPERVISORY_RR_8BIT, AX25_FRAME_SUPERVISORY_RNR_8BIT, AX25_FRAME_SUPERVISORY_REJ_8BIT, AX25_FRAME_SUPERVISORY_SREJ_8BIT },
+            { AX25_FRAME_SUPERVISORY_RR_16BIT, AX25_FRAME_SUPERVISORY_RNR_16BIT, AX25_FRAME_SUPERVISORY_REJ_16BIT, AX25_FRAME_SUPERVISORY_SREJ_16BIT } };
+    ax25_frame_storage_t frame;
+
+    frame.base.type = s_types[link->modulo128][code >> 2];
+    frame.supervisory.code = code;
+    frame.supervisory.nr = nr;
+    frame.supervisory.pf = pf;
+    link_transmit(link, &frame, command);
+}
+
+static void send_sabm(ax25_link_t *link) {
+    if (link->modulo128)
+        send_u(link, AX25_FRAME_UNNUMBERED_SABME, U_SABME, true, COMMAND);
+    else
+        send_u(link, AX25_FRAME_UNNUMBERED_SABM, U_SABM, true, COMMAND);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Transmit queue. The slot of the I-frame numbered V(A) is tx_head; the frames up to V(S) have
+// been sent, the rest are waiting for the window.
+
+static size_t tx_slot(const ax25_link_t *link, uint8_t ns) {
+    return (link->tx_head + seq_diff(link, ns, link->va)) % AX25_LINK_MAX_QUEUE;
+}
+
+static void tx_discard(ax25_link_t *link) {
+    link->tx_head = 0;
+    link->tx_count = 0;
+}
+
+// V(A) = N(R), releasing the acknowledged frames
+static void tx_acknowledge(ax25_link_t *link, uint8_t nr) {
+    size_t acked = seq_diff(link, nr, link->va);
+
+    link->tx_head = (link->tx_head + acked) % AX25_LINK_MAX_QUEUE;
+    link->tx_count -= acked;
+    link->va = nr;
+}
+
+static void send_i(ax25_link_t *link, uint8_t ns, bool pf) {
+    ax25_frame_storage_t frame;
+    size_t slot = tx_slot(link, ns);
+
+    frame.base.type = link->modulo128 ? AX25_FRAME_INFORMATION_16BIT : AX25_FRAME_INFORMATION_8BIT;
+    frame.information.nr = link->vr;
+    frame.information.ns = ns;
+    frame.information.pf = pf;
+    frame.information.pid = link->tx_pid[slot];
+    frame.information.payload = link->tx_data[slot];
+    frame.information.payload_len = link->tx_len[slot];
+    link_transmit(link, &frame, COMMAND);
+    link->ack_pending = false;
+}
+
+// Sends queued I-frames while the window is open (I frame pops off queue)
+static void link_push(ax25_link_t *link) {
+    if ((link->state != AX25_LINK_CONNECTED && link->state != AX25_LINK_TIMER_RECOVERY) || link->peer_busy)
+        return;
+
+    size_t window = link_window(link);
+    for (;;) {
+        size_t outstanding = seq_diff(link, link->vs, link->va);
+        if (outstanding >= window || outstanding >= link->tx_count)
+            break;
+        send_i(link, link->vs, false);
+        link->vs = seq_add(link, link->vs, 1);
+        if (!link->t1_running) {
+            t3_stop(link);
+            t1_start(link);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Subroutines of AX.25 2.2 Section C4.4
+
+static void clear_exception_conditions(ax25_link_t *link) {
+    link->peer_busy = false;
+    link->reject_exception = false;
+    link->own_busy = false;
+    link->ack_pending = false;
+}
+
+static void establish_data_link(ax25_link_t *link) {
+    clear_exception_conditions(link);
+    link->rc = 0;
+    send_sabm(link);
+    t3_stop(link);
+    t1_start(link);
+}
+
+static void transmit_enquiry(ax25_link_t *link) {
+    send_s(link, link->own_busy ? S_RNR : S_RR, link->vr, true, COMMAND);
+    link->ack_pending = false;
+    t1_start(link);
+}
+
+static void enquiry_response(ax25_link_t *link, bool f) {
+    if (f && !link->own_busy && link->rx_held_count > 0) {
+        // Frames are missing: ask for the first one rather than have the sender go back N
+        send_s(link, S_SREJ, link->vr, true, RESPONSE);
+        seq_bit_set(link->rx_requested, link->vr);
+    } else {
+        send_s(link, link->own_busy ? S_RNR : S_RR, link->vr, f, RESPONSE);
+    }
+    link->ack_pending = false;
+}
+
+// Rewinds V(S) so that link_push() sends the unacknowledged frames again
+static void invoke_retransmission(ax25_link_t *link, uint8_t nr) {
+    link->retransmissions += seq_diff(link, link->vs, nr);
+    link->vs = nr;
+}
+
+static bool nr_valid(const ax25_link_t *link, uint8_t nr) {
+    return seq_diff(link, nr, link->va) <= seq_diff(link, link->vs, link->va);
+}
+
+static void nr_error_recovery(ax25_link_t *link) {
+    link_error(link, AX25_LINK_ERROR_J);
+    establish_data_link(link);
+    link->layer3_initiated = false;
+    link->state = AX25_LINK_AWAITING_CONNECTION;
+}
+
+static void check_iframe_acked(ax25_link_t *link, uint8_t nr) {
+    if (link->peer_busy) {
+        tx_acknowledge(link, nr);
+        t3_start(link);
+        if (!link->t1_running)
+            t1_start(link);
+    } else if (nr == link->vs) {
+        tx_acknowledge(link, nr);
+        t1_stop(link);
+        t3_start(link);
+        select_t1_value(link);
+    } else if (nr != link->va) {
+        tx_acknowledge(link, nr);
+        t1_start(link);
+    }
+}
+
+static void check_need_for_response(ax25_link_t *link, bool command, bool pf) {
+    if (command && pf)
+        enquiry_response(link, true);
+    else if (!command && pf)
+        link_error(link, AX25_LINK_ERROR_A);
+}
+
+static void rx_reorder_clear(ax25_link_t *link) {
+    memset(link->rx_held, 0, sizeof(link->rx_held));
+    memset(link->rx_requested, 0, sizeof(link->rx_requested));
+    link->rx_held_count = 0;
+}
+
+static void link_reset_sequence(ax25_link_t *link) {
+    link->vs = 0;
+    link->vr = 0;
+    link->va = 0;
+    rx_reorder_clear(link);
+    if (link->reassembler)
+        ax25_reassembler_reset(link->reassembler);
+}
+
+static void link_disconnected(ax25_link_t *link, ax25_link_event_t event) {
+    tx_discard(link);
+    t1_stop(link);
+    t2_stop(link);
+    t3_stop(link);
+    link->state = AX25_LINK_DISCONNECTED;
+    link_event(link, event, AX25_LINK_ERROR_NONE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Received frames
+
+static void rx_sabm(ax25_link_t *link, bool extended, bool pf) {
+    switch (link->state) {
+        case AX25_LINK_DISCONNECTED:
+            link->modulo128 = extended;
+            send_u(link, AX25_FRAME_UNNUMBERED_UA, U_UA, pf, RESPONSE);
+            clear_exception_conditions(link);
+            tx_discard(link);
+            link_reset_sequence(link);
+            t1_reset_value(link);
+            link->layer3_initiated = false;
+            t3_start(link);
+            link->state = AX25_LINK_CONNECTED;
+            link_event(link, AX25_LINK_CONNECT_INDICATION, AX25_LINK_ERROR_NONE);
+        break;
+        case AX25_LINK_AWAITING_CONNECTION:
+            send_u(link, AX25_FRAME_UNNUMBERED_UA, U_UA, pf, RESPONSE);
+        break;
+        case AX25_LINK_AWAITING_RELEASE:
+            send_u(link, AX25_FRAME_UNNUMBERED_DM, U_DM, pf, RESPONSE);
+        break;
+        default:
+            link->modulo128 = extended;
+            send_u(link, AX25_FRAME_UNNUMBERED_UA, U_UA, pf, RESPONSE);
+            clear_exception_conditions(link);
+            link_error(link, AX25_LINK_ERROR_F);
+            bool lost = (link->vs != link->va);
+            if (lost)
+                tx_discard(link);
+            t1_stop(link);
+            t3_start(link);
+            link_reset_sequence(link);
+            link->state = AX25_LINK_CONNECTED;
+            if (lost)
+                link_event(link, AX25_LINK_CONNECT_INDICATION, AX25_LINK_ERROR_NONE);
+        break;
+    }
+}
+
+static void rx_disc(ax25_link_t *link, bool pf) {
+    switch (link->state) {
+        case AX25_LINK_DISCONNECTED:
+        case AX25_LINK_AWAITING_CONNECTION:
+            send_u(link, AX25_FRAME_UNNUMBERED_DM, U_DM, pf, RESPONSE);
+        break;
+        case AX25_LINK_AWAITING_RELEASE:
+            send_u(link, AX25_FRAME_UNNUMBERED_UA, U_UA, pf, RESPONSE);
+        break;
+        default:
+            send_u(link, AX25_FRAME_UNNUMBERED_UA, U_UA, pf, RESPONSE);
+            link_disconnected(link, AX25_LINK_DISCONNECT_INDICATION);
+        break;
+    }
+}
+
+static void rx_ua(ax25_link_t *link, bool pf) {
+    switch (link->state) {
+        case AX25_LINK_DISCONNECTED:
+            link_error(link, AX25_LINK_ERROR_C);
+        break;
+        case AX25_LINK_AWAITING_CONNECTION:
+            if (!pf) {
+                link_error(link, AX25_LINK_ERROR_D);
+                break;
+            }
+            // A reset link cannot resend its unacknowledged frames under the new numbering
+            bool lost = !link->layer3_initiated && link->vs != link->va;
+            if (lost)
+                tx_discard(link);
+            t1_stop(link);
+            t3_start(link);
+            select_t1_value(link);
+            link->rc = 0;
+            link_reset_sequence(link);
+            link->state = AX25_LINK_CONNECTED;
+            if (link->layer3_initiated)
+                link_event(link, AX25_LINK_CONNECT_CONFIRM, AX25_LINK_ERROR_NONE);
+            else if (lost)
+                link_event(link, AX25_LINK_CONNECT_INDICATION, AX25_LINK_ERROR_NONE);
+        break;
+        case AX25_LINK_AWAITING_RELEASE:
+            if (!pf) {
+                link_error(link, AX25_LINK_ERROR_D);
+                break;
+            }
+            link_disconnected(link, AX25_LINK_DISCONNECT_CONFIRM);
+        break;
+        default:
+            link_error(link, AX25_LINK_ERROR_C);
+            establish_data_link(link);
+            link->layer3_initiated = false;
+            link->state = AX25_LINK_AWAITING_CONNECTION;
+        break;
+    }
+}
+
+static void rx_dm(ax25_link_t *link, bool pf) {
+    switch (link->state) {
+        case AX25_LINK_DISCONNECTED:
+        break;
+        case AX25_LINK_AWAITING_CONNECTION:
+            if (pf)
+                link_disconnected(link, AX25_LINK_DISCONNECT_INDICATION);
+        break;
+        case AX25_LINK_AWAITING_RELEASE:
+            if (pf)
+                link_disconnected(link, AX25_LINK_DISCONNECT_CONFIRM);
+        break;
+        default:
+            link_error(link, AX25_LINK_ERROR_E);
+            link_disconnected(link, AX25_LINK_DISCONNECT_INDICATION);
+        break;
+    }
+}
+
+static void rx_frmr(ax25_link_t *link) {
+    switch (link->state) {
+        case AX25_LINK_AWAITING_CONNECTION:
+            // A version 2.0 station rejecting SABME: fall back to modulo 8
+            if (link->modulo128) {
+                link->modulo128 = false;
+                establish_data_link(link);
+            }
+        break;
+        case AX25_LINK_CONNECTED:
+        case AX25_LINK_TIMER_RECOVERY:
+            link_error(link, AX25_LINK_ERROR_K);
+            establish_data_link(link);
+            link->layer3_initiated = false;
+            link->state = AX25_LINK_AWAITING_CONNECTION;
+        break;
+        default:
+        break;
+    }
+}
+
+// I or S frame outside the information transfer states. Returns true if it was handled here.
+static bool rx_numbered_outside(ax25_link_t *link, bool command, bool pf) {
+    if (link->state == AX25_LINK_CONNECTED || link->state == AX25_LINK_TIMER_RECOVERY)
+        return false;
+    if (link->state != AX25_LINK_AWAITING_CONNECTION && command && pf)
+        send_u(link, AX25_FRAME_UNNUMBERED_DM, U_DM, true, RESPONSE);
+    return true;
+}
+
+static void rx_srej(ax25_link_t *link, const ax25_supervisory_frame_t *s, bool command) {
+    uint8_t nr = s->nr;
+
+    if (!nr_valid(link, nr)) {
+        nr_error_recovery(link);
+        return;
+    }
+    // With F=1 the SREJ also acknowledges every frame before N(R) (Section 4.3.2.4)
+    if (link->state == AX25_LINK_TIMER_RECOVERY && !command && s->pf) {
+        // Answer to our enquiry: the peer holds what it got after N(R), resend only N(R)
+        t1_stop(link);
+        select_t1_value(link);
+        tx_acknowledge(link, nr);
+        link->rc = 0;
+        link->state = AX25_LINK_CONNECTED;
+        if (link->vs == link->va)
+            t3_start(link);
+    } else if (s->pf) {
+        if (link->state == AX25_LINK_CONNECTED)
+            check_iframe_acked(link, nr);
+        else
+            tx_acknowledge(link, nr);
+    }
+    if (nr != link->vs) {
+        send_i(link, nr, false);
+        link->retransmissions++;
+        if (!link->t1_running) {
+            t3_stop(link);
+            t1_start(link);
+        }
+    }
+}
+
+static void rx_supervisory(ax25_link_t *link, const ax25_supervisory_frame_t *s, bool command) {
+    uint8_t nr = s->nr;
+
+    if (rx_numbered_outside(link, command, s->pf))
+        return;
+
+    link->peer_busy = (s->code == S_RNR);
+    if (s->code == S_SREJ) {
+        rx_srej(link, s, command);
+        return;
+    }
+
+    if (link->state == AX25_LINK_TIMER_RECOVERY && !command && s->pf) {
+        // Answer to our enquiry
+        t1_stop(link);
+        select_t1_value(link);
+        if (!nr_valid(link, nr)) {
+            nr_error_recovery(link);
+            return;
+        }
+        tx_acknowledge(link, nr);
+        if (link->vs == link->va && !link->peer_busy) {
+            t3_start(link);
+            link->rc = 0;
+            link->state = AX25_LINK_CONNECTED;
+        } else {
+            // A busy peer is polled again on T1 until it clears or N2 runs out
+            if (link->vs != link->va)
+                invoke_retransmission(link, nr);
+            t3_stop(link);
+            t1_start(link);
+        }
+        return;
+    }
+
+    if (link->state == AX25_LINK_CONNECTED)
+        check_need_for_response(link, command, s->pf);
+    else if (command && s->pf)
+        enquiry_response(link, true);
+
+    if (!nr_valid(link, nr)) {
+        nr_error_recovery(link);
+        return;
+    }
+
+    if (s->code == S_REJ) {
+        tx_acknowledge(link, nr);
+        if (link->state == AX25_LINK_CONNECTED) {
+            t1_stop(link);
+            t3_stop(link);
+        }
+        invoke_retransmission(link, nr);
+        if (link->vs == link->va && !link->t1_running)
+            t3_start(link);
+    } else if (link->state == AX25_LINK_CONNECTED) {
+        check_iframe_acked(link, nr);
+    } else {
+        tx_acknowledge(link, nr);
+    }
+}
+
+// Passes the I-frame numbered V(R) to the user. Returns false if the callback released the link.
+static bool rx_deliver(ax25_link_t *link, uint8_t pid, const uint8_t *data, size_t len) {
+    seq_bit_clear(link->rx_requested, link->vr);
+    link->vr = seq_add(link, link->vr, 1);
+    if (pid == PID_SEGMENTATION && link->reassembler) {
+        ax25_reassembler_t *reassembler = link->reassembler;
+        uint8_t err;
+        if (ax25_reassembler_push(reassembler, data, len, &err) == 1 && link->callbacks.data)
+            link->callbacks.data(PID_SEGMENTATION, reassembler->buffer, reassembler->total_length, link->ctx);
+    } else if (link->callbacks.data) {
+        link->callbacks.data(pid, data, len, link->ctx);
+    }
+    return link->state == AX25_LINK_CONNECTED || link->state == AX25_LINK_TIMER_RECOVERY;
+}
+
+// Delivers the held I-frames that are now in sequence, then requests the next missing one
+static bool rx_release(ax25_link_t *link) {
+    while (seq_bit(link->rx_held, link->vr)) {
+        size_t slot = link->vr % AX25_LINK_MAX_REORDER;
+        seq_bit_clear(link->rx_held, link->vr);
+        link->rx_held_count--;
+        if (!rx_deliver(link, link->rx_pid[slot], link->rx_data[slot], link->rx_len[slot]))
+            return false;
+    }
+    if (link->rx_held_count > 0 && !seq_bit(link->rx_requested, link->vr)) {
+        send_s(link, S_SREJ, link->vr, false, RESPONSE);
+        seq_bit_set(link->rx_requested, link->vr);
+    }
+    return true;
+}
+
+// Holds an I-frame received ahead of V(R) and requests with SREJ the frames missing before it
+static void rx_hold(ax25_link_t *link, const ax25_information_frame_t *i) {
+    // Further ahead is beyond the ring or an old copy; a frame already held is a copy too
+    if (seq_diff(link, i->ns, link->vr) >= AX25_LINK_MAX_REORDER || seq_bit(link->rx_held, i->ns))
+        return;
+
+    size_t slot = i->ns % AX25_LINK_MAX_REORDER;
+    link->rx_pid[slot] = i->pid;
+    link->rx_len[slot] = (uint16_t) i->payload_len;
+    if (i->payload_len)
+        memcpy(link->rx_data[slot], i->payload, i->payload_len);
+    seq_bit_set(link->rx_held, i->ns);
+    seq_bit_clear(link->rx_requested, i->ns);
+    link->rx_held_count++;
+
+    for (uint8_t n = link->vr; n != i->ns; n = seq_add(link, n, 1)) {
+        if (!seq_bit(link->rx_held, n) && !seq_bit(link->rx_requested, n)) {
+            send_s(link, S_SREJ, n, false, RESPONSE);
+            seq_bit_set(link->rx_requested, n);
+        }
+    }
+}
+
+static void rx_information(ax25_link_t *link, const ax25_information_frame_t *i, bool command) {
+    uint8_t nr = i->nr;
+
+    if (rx_numbered_outside(link, command, i->pf))
+        return;
+
+    if (!command) {
+        link_error(link, AX25_LINK_ERROR_S);
+        return;
+    }
+    if (i->payload_len > link->config.n1) {
+        link_error(link, AX25_LINK_ERROR_O);
+        establish_data_link(link);
+        link->layer3_initiated = false;
+        link->state = AX25_LINK_AWAITING_CONNECTION;
+        return;
+    }
+    if (!nr_valid(link, nr)) {
+        nr_error_recovery(link);
+        return;
+    }
+
+    if (link->state == AX25_LINK_CONNECTED)
+        check_iframe_acked(link, nr);
+    else
+        tx_acknowledge(link, nr);
+
+    if (link->own_busy) {
+        // Discarded; the peer will send it again once we are no longer busy
+        if (i->pf)
+            enquiry_response(link, true);
+        return;
+    }
+
+    if (i->ns == link->vr) {
+        link->reject_exception = false;
+        if (!rx_deliver(link, i->pid, i->payload, i->payload_len) || (link->rx_held_count > 0 && !rx_release(link)))
+            return; // Released from the callback
+        if (i->pf)
+            enquiry_response(link, true);
+        else
+            link->ack_pending = true;
+    } else if (link->modulo128 && link->config.srej) {
+        rx_hold(link, i);
+        if (i->pf)
+            enquiry_response(link, true);
+    } else if (link->reject_exception) {
+        if (i->pf)
+            enquiry_response(link, true);
+    } else {
+        link->reject_exception = true;
+        send_s(link, S_REJ, link->vr, i->pf, RESPONSE);
+        link->ack_pending = false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Timer expiry
+
+static void t1_expired(ax25_link_t *link) {
+    switch (link->state) {
+        case AX25_LINK_AWAITING_CONNECTION:
+            if (link->rc == link->config.n2) {
+                link_error(link, AX25_LINK_ERROR_G);
+                link_disconnected(link, AX25_LINK_DISCONNECT_INDICATION);
+            } else {
+                link->rc++;
+                send_sabm(link);
+                select_t1_value(link);
+                t1_start(link);
+            }
+        break;
+        case AX25_LINK_AWAITING_RELEASE:
+            if (link->rc == link->config.n2) {
+                link_error(link, AX25_LINK_ERROR_H);
+                link_disconnected(link, AX25_LINK_DISCONNECT_CONFIRM);
+            } else {
+                link->rc++;
+                send_u(link, AX25_FRAME_UNNUMBERED_DISC, U_DISC, true, COMMAND);
+                select_t1_value(link);
+                t1_start(link);
+            }
+        break;
+        case AX25_LINK_CONNECTED:
+            link->rc = 1;
+            select_t1_value(link);
+            transmit_enquiry(link);
+            link->state = AX25_LINK_TIMER_RECOVERY;
+        break;
+        case AX25_LINK_TIMER_RECOVERY:
+            if (link->rc == link->config.n2) {
+                if (link->va != link->vs)
+                    link_error(link, AX25_LINK_ERROR_I);
+                else
+                    link_error(link, link->peer_busy ? AX25_LINK_ERROR_U : AX25_LINK_ERROR_T);
+                send_u(link, AX25_FRAME_UNNUMBERED_DM, U_DM, false, RESPONSE);
+                link_disconnected(link, AX25_LINK_DISCONNECT_INDICATION);
+            } else {
+                link->rc++;
+                select_t1_value(link);
+                transmit_enquiry(link);
+            }
+        break;
+        default:
+        break;
+    }
+}
+
+// The delayed acknowledgement, unless an I-frame or an enquiry response already carried it
+static void t2_expired(ax25_link_t *link) {
+    if (link->ack_pending && (link->state == AX25_LINK_CONNECTED || link->state == AX25_LINK_TIMER_RECOVERY))
+        enquiry_response(link, false);
+}
+
+static void t3_expired(ax25_link_t *link) {
+    if (link->state == AX25_LINK_CONNECTED) {
+        link->rc = 0;
+        transmit_enquiry(link);
+        link->state = AX25_LINK_TIMER_RECOVERY;
+    }
+}
+
+// Wheel callbacks: the wheel time is the expiry time
+static void t1_fired(void *ctx) {
+    ax25_link_t *link = ctx;
+    link->now = link->wheel->now;
+    link->t1_running = false;
+    t1_expired(link);
+}
+
+static void t2_fired(void *ctx) {
+    ax25_link_t *link = ctx;
+    link->now = link->wheel->now;
+    link->t2_running = false;
+    t2_expired(link);
+}
+
+static void t3_fired(void *ctx) {
+    ax25_link_t *link = ctx;
+    link->now = link->wheel->now;
+    link->t3_running = false;
+    t3_expired(link);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public interface
+
+void ax25_link_config_default(ax25_link_config_t *config) {
+    config->n1 = 256;
+    config->k = 7;
+    config->n2 = 10;
+    config->t1 = 3000;
+    config->t1_min = 1000;
+    config->t1_max = 30000;
+    config->t2 = 0;
+    config->t3 = 300000;
+    config->modulo128 = false;
+    config->srej = true;
+}
+
+int ax25_link_init(ax25_link_t *link, const ax25_link_config_t *config, const ax25_address_t *local, const ax25_address_t *peer, const ax25_path_t *path,
+        const ax25_link_callbacks_t *callbacks, void *ctx) {
+    if (config->n1 == 0 || config->n1 > AX25_LINK_MAX_N1 || config->k == 0 || config->k > 127 || config->k > AX25_LINK_MAX_QUEUE || config->t1 == 0
+            || config->t1 < config->t1_min || config->t1 > config->t1_max || (path && path->num_repeaters > MAX_REPEATERS))
+        return -1;
+
+    memset(link, 0, offsetof(ax25_link_t, tx_pid));
+    link->frames_sent = 0;
+    link->frames_received = 0;
+    link->retransmissions = 0;
+
+    link->config = *config;
+    if (callbacks)
+        link->callbacks = *callbacks;
+    link->ctx = ctx;
+    link->state = AX25_LINK_DISCONNECTED;
+    link->modulo128 = config->modulo128;
+    t1_reset_value(link);
+    timer_wheel_entry_init(&link->t1_timer, t1_fired, link);
+    timer_wheel_entry_init(&link->t2_timer, t2_fired, link);
+    timer_wheel_entry_init(&link->t3_timer, t3_fired, link);
+
+    link->header.destination = *peer;
+    link->header.source = *local;
+    if (path)
+        link->header.repeaters = *path;
+    // Reserved address bits are sent as 1 (Section 3.12.2), H bits clear
+    link->header.destination.res0 = link->header.destination.res1 = true;
+    link->header.source.res0 = link->header.source.res1 = true;
+    for (int r = 0; r < link->header.repeaters.num_repeaters; r++) {
+        link->header.repeaters.repeaters[r].ch = false;
+        link->header.repeaters.repeaters[r].res0 = link->header.repeaters.repeaters[r].res1 = true;
+    }
+
+    return 0;
+}
+
+int ax25_link_connect(ax25_link_t *link, uint32_t now) {
+    link->now = now;
+    if (link->state != AX25_LINK_DISCONNECTED)
+        return -1;
+
+    link->modulo128 = link->config.modulo128;
+    t1_reset_value(link);
+    link_reset_sequence(link);
+    establish_data_link(link);
+    link->layer3_initiated = true;
+    link->state = AX25_LINK_AWAITING_CONNECTION;
+    return 0;
+}
+
+int ax25_link_disconnect(ax25_link_t *link, uint32_t now) {
+    link->now = now;
+    if (link->state == AX25_LINK_DISCONNECTED || link->state == AX25_LINK_AWAITING_RELEASE)
+        return -1;
+
+    tx_discard(link);
+    link->rc = 0;
+    send_u(link, AX25_FRAME_UNNUMBERED_DISC, U_DISC, true, COMMAND);
+    t3_stop(link);
+    t1_start(link);
+    link->state = AX25_LINK_AWAITING_RELEASE;
+    return 0;
+}
+
+int ax25_link_send(ax25_link_t *link, uint8_t pid, const uint8_t *data, size_t len, uint32_t now) {
+    link->now = now;
+    if (link->state != AX25_LINK_CONNECTED && link->state != AX25_LINK_TIMER_RECOVERY && link->state != AX25_LINK_AWAITING_CONNECTION)
+        return -1;
+    if (len > link->config.n1 || link->tx_count == AX25_LINK_MAX_QUEUE)
+        return -1;
+
+    size_t slot = (link->tx_head + link->tx_count) % AX25_LINK_MAX_QUEUE;
+    link->tx_pid[slot] = pid;
+    link->tx_len[slot] = (uint16_t) len;
+    if (len)
+        memcpy(link->tx_data[slot], data, len);
+    link->tx_count++;
+
+    link_push(link);
+    return 0;
+}
+
+int ax25_link_receive(ax25_link_t *link, const uint8_t *frame, size_t len, uint32_t now) {
+    ax25_frame_storage_t storage;
+    uint8_t err;
+
+    link->now = now;
+    ax25_frame_t *decoded = ax25_frame_decode_into(frame, len, link->modulo128 ? MODULO128_TRUE : MODULO128_FALSE, &storage, &err);
+    if (!decoded)
+        return -1;
+    if (!AX25_PACKED_ADDRESS_EQUALS(ax25_address_pack(&decoded->header.source), ax25_address_pack(&link->header.destination))
+            || !AX25_PACKED_ADDRESS_EQUALS(ax25_address_pack(&decoded->header.destination), ax25_address_pack(&link->header.source)))
+        return -1;
+
+    bool command = decoded->header.cr;
+    switch (decoded->type) {
+        case AX25_FRAME_UNNUMBERED_SABM:
+        case AX25_FRAME_UNNUMBERED_SABME:
+            rx_sabm(link, decoded->type == AX25_FRAME_UNNUMBERED_SABME, storage.unnumbered.pf);
+        break;
+        case AX25_FRAME_UNNUMBERED_DISC:
+            rx_disc(link, storage.unnumbered.pf);
+        break;
+        case AX25_FRAME_UNNUMBERED_UA:
+            rx_ua(link, storage.unnumbered.pf);
+        break;
+        case AX25_FRAME_UNNUMBERED_DM:
+            rx_dm(link, storage.unnumbered.pf);
+        break;
+        case AX25_FRAME_UNNUMBERED_FRMR:
+            rx_frmr(link);
+        break;
+        case AX25_FRAME_INFORMATION_8BIT:
+        case AX25_FRAME_INFORMATION_16BIT:
+            rx_information(link, &storage.information, command);
+        break;
+        case AX25_FRAME_UNNUMBERED_INFORMATION:
+        case AX25_FRAME_UNNUMBERED_TEST:
+        case AX25_FRAME_RAW:
+            return -1;
+        default:
+            rx_supervisory(link, &storage.supervisory, command);
+        break;
+    }
+    link->frames_received++;
+
+    // New I-frames carry the acknowledgement; otherwise it is sent on its own, at once or when
+    // T2 expires so that it can cover the next I-frames of a burst
+    link_push(link);
+    if (link->ack_pending && (link->state == AX25_LINK_CONNECTED || link->state == AX25_LINK_TIMER_RECOVERY)) {
+        if (link->config.t2 == 0)
+            enquiry_response(link, false);
+        else if (!link->t2_running)
+            t2_start(link);
+    }
+
+    return 0;
+}
+
+void ax25_link_tick(ax25_link_t *link, uint32_t now) {
+    link->now = now;
+    if (link->wheel)
+        return;
+
+    if (link->t1_running && time_reached(now, link->t1_expiry)) {
+        link->t1_running = false;
+        t1_expired(link);
+    }
+    if (link->t2_running && time_reached(now, link->t2_expiry)) {
+        link->t2_running = false;
+        t2_expired(link);
+    }
+    if (link->t3_running && time_reached(now, link->t3_expiry)) {
+        link->t3_running = false;
+        t3_expired(link);
+    }
+}
+
+int ax25_link_set_wheel(ax25_link_t *link, timer_wheel_t *wheel) {
+    if (link->t1_running || link->t2_running || link->t3_running)
+        return -1;
+
+    link->wheel = wheel;
+    return 0;
+}
+
+void ax25_link_set_reassembler(ax25_link_t *link, ax25_reassembler_t *reassembler) {
+    link->reassembler = reassembler;
+}
+
+void ax25_link_set_busy(ax25_link_t *link, bool busy, uint32_t now) {
+    link->now = now;
+    if (busy == link->own_busy)
+        return;
+
+    link->own_busy = busy;
+    if (link->state != AX25_LINK_CONNECTED && link->state != AX25_LINK_TIMER_RECOVERY)
+        return;
+
+    if (busy) {
+        send_s(link, S_RNR, link->vr, false, RESPONSE);
+        link->ack_pending = false;
+    } else {
+        // Poll the peer so that it resumes at once
+        send_s(link, S_RR, link->vr, true, COMMAND);
+        link->ack_pending = false;
+        if (!link->t1_running) {
+            t3_stop(link);
+            t1_start(link);
+        }
+    }
+}
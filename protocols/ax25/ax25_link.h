@@ -0,0 +1,355 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AX25_LINK_H_
+#define AX25_LINK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ax25.h"
+#include "timer_wheel.h"
+
+/**
+ * @defgroup Ax25LinkLimits AX.25 Link Limits
+ * @{
+ * All may be overridden at compile time. The transmit queue takes
+ * AX25_LINK_MAX_QUEUE * AX25_LINK_MAX_N1 bytes in every ax25_link_t, the receive reorder
+ * buffer AX25_LINK_MAX_REORDER * AX25_LINK_MAX_N1 bytes.
+ */
+#ifndef AX25_LINK_MAX_N1
+#define AX25_LINK_MAX_N1    256 ///< Largest information field sent or accepted, in bytes
+#endif
+#ifndef AX25_LINK_MAX_QUEUE
+#define AX25_LINK_MAX_QUEUE 127 ///< I-frames queued for transmission, sent and unacknowledged included
+#endif
+#ifndef AX25_LINK_MAX_REORDER
+#define AX25_LINK_MAX_REORDER 64 ///< Span of N(S) ahead of V(R) held for SREJ recovery, a power of two up to 64
+#endif
+#if AX25_LINK_MAX_REORDER < 1 || AX25_LINK_MAX_REORDER > 64 || (AX25_LINK_MAX_REORDER & (AX25_LINK_MAX_REORDER - 1))
+#error "AX25_LINK_MAX_REORDER must be a power of two up to 64"
+#endif
+/** @} */
+
+/**
+ * @brief Data-link states (AX.25 2.2, Section C4.3).
+ */
+typedef enum {
+    AX25_LINK_DISCONNECTED = 0,        ///< No connection
+    AX25_LINK_AWAITING_CONNECTION = 1, ///< SABM or SABME sent, waiting for UA
+    AX25_LINK_AWAITING_RELEASE = 2,    ///< DISC sent, waiting for UA
+    AX25_LINK_CONNECTED = 3,           ///< Information transfer
+    AX25_LINK_TIMER_RECOVERY = 4,      ///< Polling the peer after T1 or T3 expired
+} ax25_link_state_t;
+
+/**
+ * @brief Events reported to the data-link user (the DL primitives of AX.25 2.2).
+ */
+typedef enum {
+    AX25_LINK_CONNECT_CONFIRM,       ///< Connection requested with ax25_link_connect() is up (DL-CONNECT confirm)
+    AX25_LINK_CONNECT_INDICATION,    ///< Peer connected, or reset a link with data outstanding (DL-CONNECT indication)
+    AX25_LINK_DISCONNECT_CONFIRM,    ///< Disconnection requested with ax25_link_disconnect() is done (DL-DISCONNECT confirm)
+    AX25_LINK_DISCONNECT_INDICATION, ///< Peer disconnected or the link failed (DL-DISCONNECT indication)
+    AX25_LINK_ERROR,                 ///< Protocol error, the code is an ax25_link_error_t (DL-ERROR indication)
+} ax25_link_event_t;
+
+/**
+ * @brief DL-ERROR codes, named after the letters of AX.25 2.2 Section C4.3.
+ */
+typedef enum {
+    AX25_LINK_ERROR_NONE = 0,
+    AX25_LINK_ERROR_A,     ///< F=1 received but P=1 not outstanding
+    AX25_LINK_ERROR_B,     ///< Unexpected DM with F=1 while connected
+    AX25_LINK_ERROR_C,     ///< Unexpected UA while connected
+    AX25_LINK_ERROR_D,     ///< UA received without F=1 after SABM or DISC with P=1
+    AX25_LINK_ERROR_E,     ///< DM received while connected
+    AX25_LINK_ERROR_F,     ///< Data link reset by the peer (SABM while connected)
+    AX25_LINK_ERROR_G,     ///< Connection timed out after N2 retries
+    AX25_LINK_ERROR_H,     ///< Disconnection timed out after N2 retries
+    AX25_LINK_ERROR_I,     ///< N2 timeouts with unacknowledged data
+    AX25_LINK_ERROR_J,     ///< N(R) sequence error
+    AX25_LINK_ERROR_K,     ///< Unexpected frame received (FRMR)
+    AX25_LINK_ERROR_L,     ///< Control field invalid or not implemented
+    AX25_LINK_ERROR_M,     ///< Information field received in a U or S frame
+    AX25_LINK_ERROR_N,     ///< Frame length incorrect for the frame type
+    AX25_LINK_ERROR_O,     ///< I-frame longer than N1
+    AX25_LINK_ERROR_S,     ///< I-frame received as a response
+    AX25_LINK_ERROR_T,     ///< N2 timeouts, no response to enquiry
+    AX25_LINK_ERROR_U,     ///< N2 timeouts, extended peer busy condition
+} ax25_link_error_t;
+
+/**
+ * @brief Called for every frame the link transmits.
+ *
+ * @param frame Pointer to the frame bytes, address field to information field, without FCS,
+ *              ready for hdlc_frame_encode() or kiss_frame_encode(). Only valid during the call.
+ * @param len Length of the frame in bytes.
+ * @param ctx User context pointer given to ax25_link_init().
+ */
+typedef void (*ax25_link_send_callback_t)(const uint8_t *frame, size_t len, void *ctx);
+
+/**
+ * @brief Called for every in-sequence I-frame received (DL-DATA indication).
+ *
+ * @param pid Protocol identifier of the I-frame.
+ * @param data Pointer to the information field. Only valid during the call.
+ * @param len Length of the information field in bytes.
+ * @param ctx User context pointer given to ax25_link_init().
+ */
+typedef void (*ax25_link_data_callback_t)(uint8_t pid, const uint8_t *data, size_t len, void *ctx);
+
+/**
+ * @brief Called for connection events and errors.
+ *
+ * @param event The event, an ax25_link_event_t value.
+ * @param error For AX25_LINK_ERROR, an ax25_link_error_t value; otherwise 0.
+ * @param ctx User context pointer given to ax25_link_init().
+ */
+typedef void (*ax25_link_event_callback_t)(int event, int error, void *ctx);
+
+/**
+ * @brief Callbacks connecting a link to the radio and to its user. Any of them may be NULL.
+ */
+typedef struct {
+    ax25_link_send_callback_t send;   ///< Frame to transmit
+    ax25_link_data_callback_t data;   ///< Information received
+    ax25_link_event_callback_t event; ///< Connection events and errors
+} ax25_link_callbacks_t;
+
+/**
+ * @brief Data-link parameters (AX.25 2.2, Section 6.7.2).
+ */
+typedef struct {
+    uint16_t n1;     ///< Maximum information field length in bytes, up to AX25_LINK_MAX_N1
+    uint8_t k;       ///< Window size: I-frames outstanding, capped at 7 on modulo 8 links and at AX25_LINK_MAX_REORDER with SREJ
+    uint8_t n2;      ///< Maximum number of retries
+    uint32_t t1;     ///< Initial T1 (acknowledgement timer) in milliseconds
+    uint32_t t1_min; ///< Lower bound of the adaptive T1 in milliseconds
+    uint32_t t1_max; ///< Upper bound of the adaptive T1 in milliseconds
+    uint32_t t2;     ///< T2 (response delay timer) in milliseconds, 0 to acknowledge at once
+    uint32_t t3;     ///< T3 (idle link poll timer) in milliseconds
+    bool modulo128;  ///< Connect with SABME and modulo 128 sequence numbers
+    bool srej;       ///< Recover lost I-frames with SREJ on modulo 128 links, REJ otherwise
+} ax25_link_config_t;
+
+/**
+ * @brief State of one AX.25 connected-mode data link.
+ *
+ * Implements the data-link state machine of AX.25 2.2 (Section C4) for one local station and
+ * one peer: connection setup and release, the V(S), V(R) and V(A) state variables, a sliding
+ * window of up to 127 I-frames, T1, T2 and T3 with N2 retries, REJ and SREJ recovery.
+ * Frames in and out are plain byte buffers without FCS.
+ *
+ * With selective reject (modulo 128 links with config.srej), I-frames received out of
+ * sequence are held in a reorder ring indexed by N(S), up to AX25_LINK_MAX_REORDER ahead of
+ * V(R) (at most half the sequence space, so that new frames are told from old copies), and
+ * each missing frame is requested once with SREJ. When the missing frame arrives,
+ * it and the frames held behind it are delivered in order. A poll answered while frames are
+ * missing is answered with SREJ F=1, so that the sender resends only the first missing frame
+ * rather than the whole window. Modulo 8 links, which may be version 2.0 peers, use REJ.
+ *
+ * T1 adapts to the link: it is set to twice the smoothed round trip time measured on
+ * acknowledged frames and doubled on every retry (Section C4.4, select T1 value), within
+ * config.t1_min and config.t1_max.
+ *
+ * The link has no clock of its own: every call takes the current time in milliseconds from
+ * any monotonic source. Timers are either polled with ax25_link_tick(), or armed on a
+ * timer_wheel_t shared by many links (see ax25_link_set_wheel()). Timer arithmetic is
+ * wrap-safe. The structure requires no dynamic memory; it is not thread safe.
+ */
+typedef struct {
+    ax25_link_config_t config;       ///< Parameters given to ax25_link_init()
+    ax25_link_callbacks_t callbacks; ///< Callbacks given to ax25_link_init()
+    void *ctx;                       ///< User context passed to the callbacks
+    ax25_frame_header_t header;      ///< Address field of transmitted frames
+    ax25_link_state_t state;         ///< Current state
+    bool modulo128;                  ///< Sequence numbers in use are modulo 128
+    uint8_t vs;                      ///< V(S), send state variable
+    uint8_t vr;                      ///< V(R), receive state variable
+    uint8_t va;                      ///< V(A), acknowledge state variable
+    uint8_t rc;                      ///< Retry count
+    bool peer_busy;                  ///< Peer receiver busy (RNR received)
+    bool own_busy;                   ///< Own receiver busy, set by ax25_link_set_busy()
+    bool reject_exception;           ///< REJ sent and not yet cleared
+    bool ack_pending;                ///< I-frames received and not yet acknowledged
+    bool layer3_initiated;           ///< Connection requested by the user rather than the peer
+    bool t1_running;                 ///< T1 is running
+    bool t2_running;                 ///< T2 is running
+    bool t3_running;                 ///< T3 is running
+    bool t1_measured;                ///< T1 was running when last stopped, t1_elapsed is a round trip sample
+    uint32_t t1_expiry;              ///< Time at which T1 expires
+    uint32_t t2_expiry;              ///< Time at which T2 expires
+    uint32_t t3_expiry;              ///< Time at which T3 expires
+    uint32_t t1_started;             ///< Time at which T1 was last started
+    uint32_t t1_elapsed;             ///< Time T1 ran before it was last stopped
+    uint64_t rx_held[2];             ///< Bit N(S) set when I-frame N(S) is held out of sequence
+    uint64_t rx_requested[2];        ///< Bit N(S) set when I-frame N(S) was requested with SREJ
+    uint8_t rx_held_count;           ///< I-frames held out of sequence
+    uint32_t t1v;                    ///< Current T1 value in milliseconds
+    uint32_t srt;                    ///< Smoothed round trip time in milliseconds
+    timer_wheel_t *wheel;            ///< Wheel the timers are armed on, NULL when polled with ax25_link_tick()
+    timer_wheel_entry_t t1_timer;    ///< T1 on the wheel
+    timer_wheel_entry_t t2_timer;    ///< T2 on the wheel
+    timer_wheel_entry_t t3_timer;    ///< T3 on the wheel
+    ax25_reassembler_t *reassembler; ///< Reassembler of PID 0x08 segments, NULL to deliver them as received
+    uint32_t now;                    ///< Time given to the last call
+    size_t tx_head;                  ///< Queue slot of the I-frame numbered V(A)
+    size_t tx_count;                 ///< I-frames queued, sent and unacknowledged included
+    uint8_t tx_pid[AX25_LINK_MAX_QUEUE];                   ///< PID of each queued I-frame
+    uint16_t tx_len[AX25_LINK_MAX_QUEUE];                  ///< Information length of each queued I-frame
+    uint8_t tx_data[AX25_LINK_MAX_QUEUE][AX25_LINK_MAX_N1]; ///< Information field of each queued I-frame
+    uint32_t frames_sent;            ///< Frames transmitted
+    uint32_t frames_received;        ///< Frames accepted by ax25_link_receive()
+    uint32_t retransmissions;        ///< I-frames sent more than once
+    uint8_t rx_pid[AX25_LINK_MAX_REORDER];                   ///< PID of each held I-frame
+    uint16_t rx_len[AX25_LINK_MAX_REORDER];                  ///< Information length of each held I-frame
+    uint8_t rx_data[AX25_LINK_MAX_REORDER][AX25_LINK_MAX_N1]; ///< Information field of each held I-frame
+} ax25_link_t;
+
+/**
+ * @brief Fills a configuration with the AX.25 2.2 defaults.
+ *
+ * N1 256, k 7, N2 10, T1 3 s adapting between 1 s and 30 s, T2 0 (immediate
+ * acknowledgement), T3 300 s, modulo 8, SREJ enabled.
+ *
+ * @param config Pointer to the configuration to fill.
+ */
+void ax25_link_config_default(ax25_link_config_t *config);
+
+/**
+ * @brief Initializes a link in the disconnected state.
+ *
+ * Must not be called on a link whose timers are armed on a wheel: disconnect it first.
+ *
+ * @param link Pointer to the link to initialize.
+ * @param config Pointer to the link parameters, copied into the link.
+ * @param local Local station address.
+ * @param peer Peer station address.
+ * @param path Digipeater path to the peer, or NULL for a direct link.
+ * @param callbacks Pointer to the callbacks, copied into the link.
+ * @param ctx User context pointer passed unchanged to the callbacks.
+ * @return 0 on success, -1 if a parameter is out of range or config.t1 is outside
+ *         config.t1_min to config.t1_max.
+ */
+int ax25_link_init(ax25_link_t *link, const ax25_link_config_t *config, const ax25_address_t *local, const ax25_address_t *peer, const ax25_path_t *path,
+        const ax25_link_callbacks_t *callbacks, void *ctx);
+
+/**
+ * @brief Requests a connection (DL-CONNECT request).
+ *
+ * Sends SABM, or SABME with config.modulo128, and waits for UA. A peer answering SABME with
+ * FRMR is retried with SABM. AX25_LINK_CONNECT_CONFIRM is reported once connected.
+ *
+ * @param link Pointer to a disconnected link.
+ * @param now Current time in milliseconds.
+ * @return 0 on success, -1 if the link is not disconnected.
+ */
+int ax25_link_connect(ax25_link_t *link, uint32_t now);
+
+/**
+ * @brief Requests a disconnection (DL-DISCONNECT request).
+ *
+ * Queued data is discarded, DISC is sent and AX25_LINK_DISCONNECT_CONFIRM is reported once
+ * the peer answers with UA or DM, or after N2 retries.
+ *
+ * @param link Pointer to the link.
+ * @param now Current time in milliseconds.
+ * @return 0 on success, -1 if the link is already disconnected or releasing.
+ */
+int ax25_link_disconnect(ax25_link_t *link, uint32_t now);
+
+/**
+ * @brief Queues an information field for transmission (DL-DATA request).
+ *
+ * The data is copied. I-frames go out as soon as the window and the peer allow.
+ *
+ * @param link Pointer to a connected link, or one awaiting its connection.
+ * @param pid Protocol identifier.
+ * @param data Pointer to the information field.
+ * @param len Length of the information field, up to config.n1 bytes.
+ * @param now Current time in milliseconds.
+ * @return 0 on success, -1 if the link is not connected, the field is too long or the queue is full.
+ */
+int ax25_link_send(ax25_link_t *link, uint8_t pid, const uint8_t *data, size_t len, uint32_t now);
+
+/**
+ * @brief Processes a frame received from the peer.
+ *
+ * The frame must have its FCS removed. Frames not addressed from the peer to the local
+ * station, UI frames and frames that fail to decode are ignored.
+ *
+ * @param link Pointer to the link.
+ * @param frame Pointer to the frame bytes.
+ * @param len Length of the frame in bytes.
+ * @param now Current time in milliseconds.
+ * @return 0 if the frame was processed, -1 if it was ignored.
+ */
+int ax25_link_receive(ax25_link_t *link, const uint8_t *frame, size_t len, uint32_t now);
+
+/**
+ * @brief Handles expired timers.
+ *
+ * Does nothing for a link whose timers are on a wheel: they expire from timer_wheel_advance().
+ *
+ * @param link Pointer to the link.
+ * @param now Current time in milliseconds.
+ */
+void ax25_link_tick(ax25_link_t *link, uint32_t now);
+
+/**
+ * @brief Moves the timers of a link to a timer wheel.
+ *
+ * From then on T1, T2 and T3 are armed and cancelled on the wheel without any allocation, and
+ * expire from timer_wheel_advance(), which must be driven by the clock given to the other
+ * calls. One wheel serves any number of links. A NULL wheel goes back to ax25_link_tick().
+ *
+ * @param link Pointer to a link with no timer running, typically just initialized.
+ * @param wheel Pointer to the wheel, or NULL.
+ * @return 0 on success, -1 if a timer is running.
+ */
+int ax25_link_set_wheel(ax25_link_t *link, timer_wheel_t *wheel);
+
+/**
+ * @brief Reassembles the segmented payloads received on a link.
+ *
+ * I-frames with PID 0x08 are pushed into the reassembler as they arrive instead of being
+ * delivered, and each complete payload is delivered through the data callback in one call,
+ * with PID_SEGMENTATION as its PID. Segments in error are dropped and counted in the
+ * reassembler. A new connection drops a partial payload. Each link needs its own reassembler.
+ *
+ * @param link Pointer to the link.
+ * @param reassembler Pointer to an initialized reassembler, or NULL to deliver segments as received.
+ */
+void ax25_link_set_reassembler(ax25_link_t *link, ax25_reassembler_t *reassembler);
+
+/**
+ * @brief Sets or clears the own receiver busy condition (DL-FLOW-OFF and DL-FLOW-ON).
+ *
+ * While busy, received I-frames are discarded and answered with RNR.
+ *
+ * @param link Pointer to the link.
+ * @param busy True to stop the peer, false to let it resume.
+ * @param now Current time in milliseconds.
+ */
+void ax25_link_set_busy(ax25_link_t *link, bool busy, uint32_t now);
+
+#endif /* AX25_LINK_H_ */
@@ -44,6 +44,71 @@ char* my_strdup(const char *s) {
     return dup;
 }
 
+void mem_arena_init(mem_arena_t *arena, void *buffer, size_t size) {
+    arena->buffer = (unsigned char*) buffer;
+    arena->size = size;
+    arena->used = 0;
+    arena->peak = 0;
+}
+
+void* mem_arena_alloc(mem_arena_t *arena, size_t size) {
+    // Align the address rather than the offset, the buffer itself may be unaligned
+    uintptr_t base = (uintptr_t) arena->buffer;
+    size_t start = (size_t) (((base + arena->used + MEM_ARENA_ALIGN - 1) & ~(uintptr_t) (MEM_ARENA_ALIGN - 1)) - base);
+
+    if (start > arena->size || size > arena->size - start)
+        return NULL;
+
+    arena->used = start + size;
+    if (arena->used > arena->peak)
+        arena->peak = arena->used;
+    return arena->buffer + start;
+}
+
+void mem_arena_reset(mem_arena_t *arena) {
+    arena->used = 0;
+}
+
+void* mem_alloc(mem_arena_t *arena, size_t size) {
+    return arena ? mem_arena_alloc(arena, size) : malloc(size);
+}
+
+void mem_free(mem_arena_t *arena, void *ptr) {
+    if (!arena)
+        free(ptr);
+}
+
+void* mem_realloc(mem_arena_t *arena, void *ptr, size_t oldSize, size_t newSize) {
+    if (!arena)
+        return realloc(ptr, newSize);
+
+    unsigned char *block = (unsigned char*) ptr;
+    if (block && block + oldSize == arena->buffer + arena->used && newSize <= arena->size - (size_t) (block - arena->buffer)) {
+        arena->used = (size_t) (block - arena->buffer) + newSize;
+        if (arena->used > arena->peak)
+            arena->peak = arena->used;
+        return block;
+    }
+
+    void *moved = mem_arena_alloc(arena, newSize);
+    if (moved && block)
+        memcpy(moved, block, oldSize < newSize ? oldSize : newSize);
+    return moved;
+}
+
+char* mem_strndup(mem_arena_t *arena, const char *s, size_t n) {
+    size_t len = 0;
+    while (len < n && s[len] != '\0')
+        len++;
+
+    char *dup = mem_alloc(arena, len + 1);
+    if (dup) {
+        memcpy(dup, s, len);
+        dup[len] = '\0';
+    }
+    return dup;
+}
+
 void trim_trailing_spaces(char *str) {
     size_t len = strlen(str);
     while (len > 0 && str[len - 1] == ' ') {
@@ -51,8 +116,7 @@ void trim_trailing_spaces(char *str) {
     }
 }
 
-uint16_t CRC(unsigned char *frame, int len) {
-    const uint16_t crcTable[256] = { 0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7, 0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE,
+static const uint16_t crcTable[256] = { 0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7, 0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE,
             0xF1EF, 0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6, 0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE, 0x2462,
             0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485, 0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D, 0x3653, 0x2672, 0x1611,
             0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4, 0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC, 0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840,
@@ -68,17 +132,409 @@ uint16_t CRC(unsigned char *frame, int len) {
             0x8DC9, 0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1, 0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8, 0x6E17,
             0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0 };
 
-    uint16_t crc = 0xFFFF;
+// crcSliceTable[k][b] is the CRC register after feeding byte b followed by k zero bytes,
+// starting from a zero register. crcSliceTable[0] is crcTable.
+static uint16_t crcSliceTable[8][256];
+
+// crcReflTable[k][b] is the same for the bit-reflected CRC-CCITT (polynomial 0x8408) used by
+// the streaming context API, which works on AX.25 bytes in normal bit order.
+static uint16_t crcReflTable[8][256];
+
+static bool crcTablesReady = false;
+static uint16_t (*crcKernel)(uint16_t crc, const unsigned char *data, size_t len) = NULL;
+static crc_kernel_t crcKernelId = CRC_KERNEL_AUTO;
+
+static uint16_t crc_kernel_table(uint16_t crc, const unsigned char *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc = crcTable[(data[i] ^ (crc >> 8)) & 0xFF] ^ (crc << 8);
+    }
+    return crc;
+}
+
+static uint16_t crc_kernel_slice8(uint16_t crc, const unsigned char *data, size_t len) {
+    while (len >= 8) {
+        crc = crcSliceTable[7][data[0] ^ (crc >> 8)] ^ crcSliceTable[6][data[1] ^ (crc & 0xFF)] ^ crcSliceTable[5][data[2]]
+                ^ crcSliceTable[4][data[3]] ^ crcSliceTable[3][data[4]] ^ crcSliceTable[2][data[5]] ^ crcSliceTable[1][data[6]]
+                ^ crcSliceTable[0][data[7]];
+        data += 8;
+        len -= 8;
+    }
+    return crc_kernel_table(crc, data, len);
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRC_HAVE_PCLMUL 1
+#include <immintrin.h>
+
+// Folding constants x^n mod P(x), P(x) = x^16 + x^12 + x^5 + 1
+static uint64_t crcFold128Hi, crcFold128Lo, crcFold512Hi, crcFold512Lo;
+
+static uint64_t crc_xpow_mod(int n) {
+    uint32_t r = 1;
+    for (int i = 0; i < n; i++) {
+        r <<= 1;
+        if (r & 0x10000)
+            r ^= 0x11021;
+    }
+    return r;
+}
+
+__attribute__((target("pclmul,ssse3")))
+static inline __m128i crc_fold(__m128i x, __m128i k, __m128i next) {
+    return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00)), next);
+}
+
+// Carry-less multiply folding. Blocks are loaded big-endian so that the first message bit is
+// the highest coefficient. A 128-bit block X = H*x^64 + L followed by n more bits is congruent
+// to H*(x^(n+64) mod P) + L*(x^n mod P), which keeps the running value at 128 bits. Since the
+// folded value is congruent to the message modulo P, its CRC with a zero register is the CRC
+// of the message, so the final reduction is done by the table kernel on 16 bytes.
+__attribute__((target("pclmul,ssse3")))
+static uint16_t crc_kernel_pclmul(uint16_t crc, const unsigned char *data, size_t len) {
+    if (len < 64)
+        return crc_kernel_slice8(crc, data, len);
+
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m128i k128 = _mm_set_epi64x((long long) crcFold128Hi, (long long) crcFold128Lo);
+    const __m128i k512 = _mm_set_epi64x((long long) crcFold512Hi, (long long) crcFold512Lo);
+
+    // The current register is equivalent to its value XORed into the first 16 message bits
+    __m128i x0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) data), bswap);
+    __m128i x1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 16)), bswap);
+    __m128i x2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 32)), bswap);
+    __m128i x3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 48)), bswap);
+    x0 = _mm_xor_si128(x0, _mm_set_epi64x((long long) ((uint64_t) crc << 48), 0));
+    data += 64;
+    len -= 64;
+
+    while (len >= 64) {
+        x0 = crc_fold(x0, k512, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) data), bswap));
+        x1 = crc_fold(x1, k512, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 16)), bswap));
+        x2 = crc_fold(x2, k512, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 32)), bswap));
+        x3 = crc_fold(x3, k512, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 48)), bswap));
+        data += 64;
+        len -= 64;
+    }
+
+    x0 = crc_fold(crc_fold(crc_fold(x0, k128, x1), k128, x2), k128, x3);
+
+    while (len >= 16) {
+        x0 = crc_fold(x0, k128, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) data), bswap));
+        data += 16;
+        len -= 16;
+    }
+
+    unsigned char folded[16];
+    _mm_storeu_si128((__m128i*) folded, _mm_shuffle_epi8(x0, bswap));
+    crc = crc_kernel_slice8(0, folded, 16);
+
+    return crc_kernel_slice8(crc, data, len);
+}
+#endif
+
+void crc_tables_init(void) {
+    if (crcTablesReady)
+        return;
+
+    for (int b = 0; b < 256; b++) {
+        crcSliceTable[0][b] = crcTable[b];
+        uint16_t r = b;
+        for (int k = 0; k < 8; k++) {
+            r = (r & 0x0001) ? (r >> 1) ^ 0x8408 : r >> 1;
+        }
+        crcReflTable[0][b] = r;
+    }
+    for (int k = 1; k < 8; k++) {
+        for (int b = 0; b < 256; b++) {
+            uint16_t r = crcSliceTable[k - 1][b];
+            crcSliceTable[k][b] = crcTable[r >> 8] ^ (uint16_t) (r << 8);
+            r = crcReflTable[k - 1][b];
+            crcReflTable[k][b] = crcReflTable[0][r & 0xFF] ^ (r >> 8);
+        }
+    }
+
+#ifdef CRC_HAVE_PCLMUL
+    crcFold128Hi = crc_xpow_mod(128 + 64);
+    crcFold128Lo = crc_xpow_mod(128);
+    crcFold512Hi = crc_xpow_mod(512 + 64);
+    crcFold512Lo = crc_xpow_mod(512);
+#endif
+
+    crcTablesReady = true;
+    if (!crcKernel)
+        crc_set_kernel(CRC_KERNEL_AUTO);
+}
+
+bool crc_set_kernel(crc_kernel_t kernel) {
+    if (!crcTablesReady)
+        crc_tables_init();
 
-    for (int i = 0; i < len; i++) {
-        uint8_t j = (frame[i] ^ (crc >> 8)) & 0xFF;
-        crc = crcTable[j] ^ (crc << 8);
+    switch (kernel) {
+        case CRC_KERNEL_TABLE:
+            crcKernel = crc_kernel_table;
+        break;
+        case CRC_KERNEL_SLICE8:
+            crcKernel = crc_kernel_slice8;
+        break;
+        case CRC_KERNEL_PCLMUL:
+#ifdef CRC_HAVE_PCLMUL
+            __builtin_cpu_init();
+            if (!__builtin_cpu_supports("pclmul") || !__builtin_cpu_supports("ssse3"))
+                return false;
+            crcKernel = crc_kernel_pclmul;
+            break;
+#else
+            return false;
+#endif
+        case CRC_KERNEL_AUTO:
+        default:
+            if (!crc_set_kernel(CRC_KERNEL_PCLMUL)) {
+                crc_set_kernel(CRC_KERNEL_SLICE8);
+            }
+            return true;
     }
 
+    crcKernelId = kernel;
+    return true;
+}
+
+crc_kernel_t crc_get_kernel(void) {
+    if (!crcKernel)
+        crc_tables_init();
+    return crcKernelId;
+}
+
+uint16_t CRC(unsigned char *frame, int len) {
+    if (!crcKernel)
+        crc_tables_init();
+
+    uint16_t crc = crcKernel(0xFFFF, frame, len > 0 ? (size_t) len : 0);
+
     crc = (crc ^ 0xFFFF) & 0xFFFF;
     return crc;
 }
 
+void crc_init(crc_ctx_t *ctx) {
+    if (!crcTablesReady)
+        crc_tables_init();
+    ctx->crc = 0xFFFF;
+}
+
+void crc_update(crc_ctx_t *ctx, const unsigned char *data, size_t len) {
+    uint16_t crc = ctx->crc;
+
+    while (len >= 8) {
+        crc ^= data[0] | (data[1] << 8);
+        crc = crcReflTable[7][crc & 0xFF] ^ crcReflTable[6][crc >> 8] ^ crcReflTable[5][data[2]] ^ crcReflTable[4][data[3]]
+                ^ crcReflTable[3][data[4]] ^ crcReflTable[2][data[5]] ^ crcReflTable[1][data[6]] ^ crcReflTable[0][data[7]];
+        data += 8;
+        len -= 8;
+    }
+    for (size_t i = 0; i < len; i++) {
+        crc = crcReflTable[0][(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    ctx->crc = crc;
+}
+
+uint16_t crc_final(const crc_ctx_t *ctx) {
+    return ctx->crc ^ 0xFFFF;
+}
+
+#define RS_GF_POLY 0x11D
+
+// Antilog table doubled in length so that the sum of two logs never needs a modulo
+static uint8_t rsGfExp[512];
+static uint8_t rsGfLog[256];
+static bool rsTablesReady = false;
+
+static inline uint8_t rs_gf_mul(uint8_t a, uint8_t b) {
+    return (a && b) ? rsGfExp[rsGfLog[a] + rsGfLog[b]] : 0;
+}
+
+static inline uint8_t rs_gf_div(uint8_t a, uint8_t b) {
+    return a ? rsGfExp[rsGfLog[a] + 255 - rsGfLog[b]] : 0;
+}
+
+static void rs_tables_init(void) {
+    if (rsTablesReady)
+        return;
+
+    unsigned int x = 1;
+    for (int i = 0; i < 255; i++) {
+        rsGfExp[i] = x;
+        rsGfExp[i + 255] = x;
+        rsGfLog[x] = i;
+        x <<= 1;
+        if (x & 0x100)
+            x ^= RS_GF_POLY;
+    }
+    rsGfExp[510] = rsGfExp[0];
+    rsGfExp[511] = rsGfExp[1];
+    rsGfLog[0] = 0;
+
+    rsTablesReady = true;
+}
+
+bool rs_init(rs_code_t *rs, int fcr, int nroots) {
+    if (fcr < 0 || fcr > 254 || nroots < 1 || nroots > RS_MAX_ROOTS)
+        return false;
+
+    rs_tables_init();
+
+    // g(x) = (x + alpha^fcr)(x + alpha^(fcr + 1)) ... (x + alpha^(fcr + nroots - 1))
+    uint8_t poly[RS_MAX_ROOTS + 1] = { 1 };
+    for (int i = 0; i < nroots; i++) {
+        uint8_t root = rsGfExp[(fcr + i) % 255];
+        for (int j = i + 1; j > 0; j--) {
+            poly[j] = poly[j - 1] ^ rs_gf_mul(poly[j], root);
+        }
+        poly[0] = rs_gf_mul(poly[0], root);
+    }
+
+    memset(rs, 0, sizeof(rs_code_t));
+    rs->fcr = fcr;
+    rs->nroots = nroots;
+    for (int j = 0; j <= nroots; j++) {
+        rs->genLog[j] = rsGfLog[poly[j]];
+    }
+    return true;
+}
+
+void rs_encode(const rs_code_t *rs, const unsigned char *data, int k, unsigned char *check) {
+    int nroots = rs->nroots;
+    const uint8_t *gen = rs->genLog;
+
+    // Division by g(x) in a shift register, check[0] holding the highest degree
+    memset(check, 0, nroots);
+    for (int i = 0; i < k; i++) {
+        uint8_t feedback = data[i] ^ check[0];
+        if (feedback) {
+            unsigned int fb = rsGfLog[feedback];
+            for (int j = 1; j < nroots; j++) {
+                check[j] ^= rsGfExp[fb + gen[nroots - j]];
+            }
+            memmove(check, check + 1, nroots - 1);
+            check[nroots - 1] = rsGfExp[fb + gen[0]];
+        } else {
+            memmove(check, check + 1, nroots - 1);
+            check[nroots - 1] = 0;
+        }
+    }
+}
+
+int rs_decode(const rs_code_t *rs, unsigned char *block, int n) {
+    uint8_t syn[RS_MAX_ROOTS];
+    uint8_t lambda[RS_MAX_ROOTS + 1] = { 1 };
+    uint8_t prev[RS_MAX_ROOTS + 1] = { 1 };
+    uint8_t omega[RS_MAX_ROOTS];
+    int roots[RS_MAX_ROOTS / 2];
+    int nroots = rs->nroots;
+
+    if (n <= nroots || n > 255)
+        return -1;
+
+    // Syndromes S_j = r(alpha^(fcr + j)), evaluated with Horner's rule
+    bool clean = true;
+    for (int j = 0; j < nroots; j++) {
+        unsigned int power = (rs->fcr + j) % 255;
+        uint8_t s = 0;
+        for (int i = 0; i < n; i++) {
+            s = block[i] ^ (s ? rsGfExp[rsGfLog[s] + power] : 0);
+        }
+        syn[j] = s;
+        clean &= (s == 0);
+    }
+    if (clean)
+        return 0;
+
+    // Berlekamp-Massey: shortest LFSR lambda(x) generating the syndromes
+    int L = 0;
+    int m = 1;
+    uint8_t b = 1;
+    for (int r = 0; r < nroots; r++) {
+        uint8_t delta = syn[r];
+        for (int i = 1; i <= L; i++) {
+            delta ^= rs_gf_mul(lambda[i], syn[r - i]);
+        }
+        if (delta == 0) {
+            m++;
+            continue;
+        }
+
+        uint8_t scale = rs_gf_div(delta, b);
+        if (2 * L <= r) {
+            uint8_t saved[RS_MAX_ROOTS + 1];
+            memcpy(saved, lambda, sizeof(saved));
+            for (int i = m; i <= nroots; i++) {
+                lambda[i] ^= rs_gf_mul(scale, prev[i - m]);
+            }
+            memcpy(prev, saved, sizeof(prev));
+            L = r + 1 - L;
+            b = delta;
+            m = 1;
+        } else {
+            for (int i = m; i <= nroots; i++) {
+                lambda[i] ^= rs_gf_mul(scale, prev[i - m]);
+            }
+            m++;
+        }
+    }
+    if (L > nroots / 2)
+        return -1;
+
+    // Chien search over the degrees present in the (possibly shortened) block: the terms
+    // lambda_i * alpha^(-i * d) are kept in log form and stepped once per degree
+    int regs[RS_MAX_ROOTS / 2 + 1];
+    for (int i = 0; i <= L; i++) {
+        regs[i] = lambda[i] ? rsGfLog[lambda[i]] : -1;
+    }
+    int count = 0;
+    for (int d = 0; d < n && count < L; d++) {
+        uint8_t sum = 0;
+        for (int i = 0; i <= L; i++) {
+            if (regs[i] >= 0) {
+                sum ^= rsGfExp[regs[i]];
+                regs[i] = (regs[i] + 255 - i) % 255;
+            }
+        }
+        if (sum == 0)
+            roots[count++] = d;
+    }
+    if (count != L)
+        return -1;
+
+    // Forney: omega(x) = S(x) lambda(x) mod x^nroots, e = X^(1 - fcr) omega(X^-1) / lambda'(X^-1)
+    for (int i = 0; i < nroots; i++) {
+        uint8_t v = 0;
+        for (int j = 0; j <= i && j <= L; j++) {
+            v ^= rs_gf_mul(lambda[j], syn[i - j]);
+        }
+        omega[i] = v;
+    }
+    for (int k = 0; k < count; k++) {
+        int xinv = (255 - roots[k]) % 255;
+        uint8_t num = 0;
+        uint8_t den = 0;
+        for (int i = 0; i < nroots; i++) {
+            if (omega[i])
+                num ^= rsGfExp[(rsGfLog[omega[i]] + xinv * i) % 255];
+        }
+        for (int i = 1; i <= L; i += 2) {
+            if (lambda[i])
+                den ^= rsGfExp[(rsGfLog[lambda[i]] + xinv * (i - 1)) % 255];
+        }
+        if (den == 0)
+            return -1;
+        uint8_t e = rs_gf_div(num, den);
+        if (e && rs->fcr != 1)
+            e = rsGfExp[(rsGfLog[e] + (roots[k] * (255 + 1 - rs->fcr))) % 255];
+        block[n - 1 - roots[k]] ^= e;
+    }
+
+    return count;
+}
+
 // Custom strnlen replacement for portability
 size_t my_strnlen(const char *s, size_t maxlen) {
     if (!s) {
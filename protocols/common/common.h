@@ -24,8 +24,221 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief CRC-CCITT kernels available behind CRC().
+ */
+typedef enum {
+    CRC_KERNEL_AUTO,   ///< Fastest kernel supported by the running CPU
+    CRC_KERNEL_TABLE,  ///< Byte-at-a-time 256-entry table
+    CRC_KERNEL_SLICE8, ///< Slicing-by-8, eight bytes per step
+    CRC_KERNEL_PCLMUL, ///< Carry-less multiply folding (x86 PCLMULQDQ + SSSE3)
+} crc_kernel_t;
+
+/**
+ * @brief Builds the CRC lookup tables and selects the fastest kernel for the running CPU.
+ *
+ * Called automatically on first use. Applications that compute CRCs from several threads
+ * should call it once at startup, before any thread is started.
+ */
+void crc_tables_init(void);
+
+/**
+ * @brief Selects the kernel used by CRC().
+ *
+ * All kernels produce identical results; this is mainly useful for testing and benchmarking.
+ *
+ * @param kernel Kernel to use. CRC_KERNEL_AUTO picks PCLMUL when the CPU supports it, else SLICE8.
+ * @return true on success, false if the kernel is not supported on this CPU or build.
+ */
+bool crc_set_kernel(crc_kernel_t kernel);
+
+/**
+ * @brief Returns the kernel currently used by CRC().
+ */
+crc_kernel_t crc_get_kernel(void);
 
 uint16_t CRC(unsigned char *frame, int len);
+
+/**
+ * @brief Running state of an incremental AX.25 FCS computation.
+ *
+ * Unlike CRC(), which expects bit-reversed bytes, the context works on AX.25 bytes in normal
+ * bit order, so a frame may be checksummed directly from its header, control and payload
+ * fragments without concatenating or reversing them.
+ */
+typedef struct {
+    uint16_t crc; ///< Current CRC register
+} crc_ctx_t;
+
+/**
+ * @brief Starts a new FCS computation.
+ *
+ * @param ctx Pointer to the context to initialize.
+ */
+void crc_init(crc_ctx_t *ctx);
+
+/**
+ * @brief Feeds a fragment of the frame into the FCS computation.
+ *
+ * Fragments may have any length, including zero; the result only depends on the
+ * concatenation of all fragments.
+ *
+ * @param ctx Pointer to a context initialized with crc_init().
+ * @param data Pointer to the fragment, in normal AX.25 bit order.
+ * @param len Length of the fragment in bytes.
+ */
+void crc_update(crc_ctx_t *ctx, const unsigned char *data, size_t len);
+
+/**
+ * @brief Returns the FCS of all fragments fed so far.
+ *
+ * The low byte is transmitted first. The context is not modified, so more fragments may
+ * still be added afterwards. For a frame f, CRC() over the bit-reversed bytes of f returns
+ * ReverseBits(fcs & 0xFF) << 8 | ReverseBits(fcs >> 8).
+ *
+ * @param ctx Pointer to the context.
+ * @return The 16-bit FCS.
+ */
+uint16_t crc_final(const crc_ctx_t *ctx);
+
+#define RS_MAX_ROOTS 64 ///< Largest number of check bytes of a Reed-Solomon code
+
+/**
+ * @brief Reed-Solomon code over GF(256).
+ *
+ * The field is generated by x^8 + x^4 + x^3 + x^2 + 1 (0x11D) with alpha = x, and the
+ * generator polynomial has nroots consecutive roots alpha^fcr .. alpha^(fcr + nroots - 1).
+ * Codes may be shortened to any block length up to 255 bytes. Initialize with rs_init().
+ */
+typedef struct {
+    uint8_t fcr;                       ///< Power of alpha of the first generator root
+    uint8_t nroots;                    ///< Number of check bytes
+    uint8_t genLog[RS_MAX_ROOTS + 1];  ///< Generator polynomial coefficients in log form, lowest degree first
+} rs_code_t;
+
+/**
+ * @brief Builds a Reed-Solomon code.
+ *
+ * @param rs Pointer to the code to initialize.
+ * @param fcr Power of alpha of the first generator root (0 to 254).
+ * @param nroots Number of check bytes, from 1 to RS_MAX_ROOTS.
+ * @return true on success, false if a parameter is out of range.
+ */
+bool rs_init(rs_code_t *rs, int fcr, int nroots);
+
+/**
+ * @brief Computes the check bytes of a codeblock.
+ *
+ * Systematic encoding: the block is the k information bytes followed by the nroots check bytes,
+ * the first byte being the coefficient of the highest degree.
+ *
+ * @param rs Pointer to an initialized code.
+ * @param data Pointer to the information bytes.
+ * @param k Number of information bytes, at most 255 - nroots.
+ * @param check Pointer to the output buffer for the nroots check bytes.
+ */
+void rs_encode(const rs_code_t *rs, const unsigned char *data, int k, unsigned char *check);
+
+/**
+ * @brief Corrects a codeblock in place.
+ *
+ * The syndromes are computed with the log/antilog tables; a block with all syndromes zero is
+ * accepted without further work. Otherwise the error locator is found with Berlekamp-Massey,
+ * its roots with a Chien search limited to the positions of the (possibly shortened) block,
+ * and the error values with the Forney algorithm.
+ *
+ * @param rs Pointer to an initialized code.
+ * @param block Pointer to the codeblock: information bytes followed by the check bytes.
+ * @param n Length of the codeblock in bytes, from nroots + 1 to 255.
+ * @return Number of corrected bytes (at most nroots / 2), or -1 if the block cannot be corrected.
+ */
+int rs_decode(const rs_code_t *rs, unsigned char *block, int n);
+
+/**
+ * @defgroup MemArenaLimits Arena Alignment
+ * @{
+ * May be overridden at compile time.
+ */
+#ifndef MEM_ARENA_ALIGN
+#define MEM_ARENA_ALIGN 16 ///< Alignment of every block returned by mem_arena_alloc(), a power of two
+#endif
+/** @} */
+
+/**
+ * @brief Bump allocator over a caller-provided buffer.
+ *
+ * Blocks are carved one after the other from the buffer and are never freed individually:
+ * mem_arena_reset() releases all of them at once. A decoder given an arena makes no calls to
+ * malloc() or free(), so a receive loop can decode a packet, use it, reset the arena and go on
+ * to the next packet, with one arena per thread and no shared allocator state.
+ */
+typedef struct {
+    unsigned char *buffer; ///< Memory handed out by the arena
+    size_t size;           ///< Size of the buffer in bytes
+    size_t used;           ///< Bytes handed out since the last reset, including alignment padding
+    size_t peak;           ///< Largest value reached by used, to size the buffer
+} mem_arena_t;
+
+/**
+ * @brief Initializes an arena over a buffer.
+ *
+ * @param arena Pointer to the arena to initialize.
+ * @param buffer Pointer to the memory to hand out. It must outlive every block of the arena.
+ * @param size Size of the buffer in bytes.
+ */
+void mem_arena_init(mem_arena_t *arena, void *buffer, size_t size);
+
+/**
+ * @brief Allocates a block from an arena.
+ *
+ * @param arena Pointer to an initialized arena.
+ * @param size Size of the block in bytes.
+ * @return Pointer to the block, aligned to MEM_ARENA_ALIGN, or NULL if the arena is exhausted.
+ */
+void* mem_arena_alloc(mem_arena_t *arena, size_t size);
+
+/**
+ * @brief Releases every block of an arena.
+ *
+ * The peak statistic is preserved.
+ *
+ * @param arena Pointer to the arena to reset.
+ */
+void mem_arena_reset(mem_arena_t *arena);
+
+/**
+ * @brief Allocates from an arena, or from the heap when arena is NULL.
+ *
+ * Used by the decoders that take an optional arena.
+ */
+void* mem_alloc(mem_arena_t *arena, size_t size);
+
+/**
+ * @brief Frees a block from mem_alloc(): free() for heap blocks, nothing for arena blocks.
+ */
+void mem_free(mem_arena_t *arena, void *ptr);
+
+/**
+ * @brief Resizes a block from mem_alloc().
+ *
+ * Arena blocks are resized in place when they are the last block of the arena, otherwise
+ * copied to a new block.
+ *
+ * @param arena Arena the block comes from, or NULL for heap blocks.
+ * @param ptr Pointer to the block, or NULL.
+ * @param oldSize Current size of the block in bytes, only used for arena blocks.
+ * @param newSize New size of the block in bytes.
+ * @return Pointer to the resized block, or NULL on failure (the block is left untouched).
+ */
+void* mem_realloc(mem_arena_t *arena, void *ptr, size_t oldSize, size_t newSize);
+
+/**
+ * @brief Duplicates at most n characters of a string with mem_alloc(), always NUL-terminated.
+ */
+char* mem_strndup(mem_arena_t *arena, const char *s, size_t n);
+
 void trim_trailing_spaces(char *str);
 size_t my_strnlen(const char *s, size_t maxlen);
 char* my_strdup(const char *s);
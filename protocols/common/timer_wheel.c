@@ -0,0 +1,192 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "timer_wheel.h"
+
+#define SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+
+// Files an entry in the first level whose span covers its distance from the current tick.
+// The slot at that level is visited, and the entry moved down, no later than its expiry.
+static void wheel_place(timer_wheel_t *wheel, timer_wheel_entry_t *entry) {
+    uint32_t delta = entry->expiry - wheel->tick;
+    uint32_t when = entry->expiry;
+    int level = 0;
+
+    if (delta >= TIMER_WHEEL_RANGE) {
+        // Out of range: park it at the far end, it is filed again when that slot cascades
+        delta = TIMER_WHEEL_RANGE - 1;
+        when = wheel->tick + delta;
+    }
+    while (delta >= (1UL << (TIMER_WHEEL_BITS * (level + 1))))
+        level++;
+
+    int slot = (when >> (TIMER_WHEEL_BITS * level)) & SLOT_MASK;
+    timer_wheel_entry_t **head = &wheel->slots[level][slot];
+
+    entry->next = *head;
+    if (entry->next)
+        entry->next->pprev = &entry->next;
+    entry->pprev = head;
+    *head = entry;
+    wheel->occupied[level] |= 1ULL << slot;
+}
+
+// Unlinks an entry, clearing the occupied bit of its slot when it was the last one
+static void wheel_unlink(timer_wheel_t *wheel, timer_wheel_entry_t *entry) {
+    if (entry->next)
+        entry->next->pprev = entry->pprev;
+    *entry->pprev = entry->next;
+
+    // The owning slot is only known through pprev: find which one became empty
+    timer_wheel_entry_t **slots = &wheel->slots[0][0];
+    if (entry->pprev >= slots && entry->pprev < slots + TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS && *entry->pprev == NULL) {
+        size_t index = (size_t) (entry->pprev - slots);
+        wheel->occupied[index / TIMER_WHEEL_SLOTS] &= ~(1ULL << (index % TIMER_WHEEL_SLOTS));
+    }
+
+    entry->next = NULL;
+    entry->pprev = NULL;
+}
+
+// Takes all the entries of a slot off the wheel and returns them as a list headed by *list
+static void wheel_detach(timer_wheel_t *wheel, int level, int slot, timer_wheel_entry_t **list) {
+    *list = wheel->slots[level][slot];
+    wheel->slots[level][slot] = NULL;
+    wheel->occupied[level] &= ~(1ULL << slot);
+    if (*list)
+        (*list)->pprev = list;
+}
+
+// Ticks from the current one to the next that has work: an occupied level 0 slot, or the
+// wrap of level 0 where the upper levels cascade
+static uint32_t wheel_next_step(const timer_wheel_t *wheel) {
+    uint32_t index = (wheel->tick + 1) & SLOT_MASK;
+
+    if (index == 0)
+        return 1;
+    uint64_t ahead = wheel->occupied[0] >> index;
+    if (ahead == 0)
+        return TIMER_WHEEL_SLOTS - index + 1;
+    return (uint32_t) __builtin_ctzll(ahead) + 1;
+}
+
+// Processes the current tick: cascades the upper levels that wrapped, then fires level 0
+static int wheel_process(timer_wheel_t *wheel) {
+    timer_wheel_entry_t *list;
+    int fired = 0;
+
+    if ((wheel->tick & SLOT_MASK) == 0) {
+        int top = 1;
+        while (top < TIMER_WHEEL_LEVELS - 1 && (wheel->tick & ((1UL << (TIMER_WHEEL_BITS * (top + 1))) - 1)) == 0)
+            top++;
+        for (int level = top; level > 0; level--) {
+            wheel_detach(wheel, level, (wheel->tick >> (TIMER_WHEEL_BITS * level)) & SLOT_MASK, &list);
+            while (list) {
+                timer_wheel_entry_t *entry = list;
+                wheel_unlink(wheel, entry);
+                wheel_place(wheel, entry);
+            }
+        }
+    }
+
+    wheel_detach(wheel, 0, wheel->tick & SLOT_MASK, &list);
+    while (list) {
+        timer_wheel_entry_t *entry = list;
+        // Callbacks may cancel entries still on this list: wheel_unlink() works on it too
+        wheel_unlink(wheel, entry);
+        wheel->count--;
+        fired++;
+        if (entry->callback)
+            entry->callback(entry->ctx);
+    }
+
+    return fired;
+}
+
+void timer_wheel_init(timer_wheel_t *wheel, uint32_t resolution, uint32_t now) {
+    memset(wheel, 0, sizeof(timer_wheel_t));
+    wheel->resolution = resolution ? resolution : 1;
+    wheel->now = now;
+}
+
+void timer_wheel_entry_init(timer_wheel_entry_t *entry, timer_wheel_callback_t callback, void *ctx) {
+    entry->next = NULL;
+    entry->pprev = NULL;
+    entry->expiry = 0;
+    entry->callback = callback;
+    entry->ctx = ctx;
+}
+
+void timer_wheel_arm(timer_wheel_t *wheel, timer_wheel_entry_t *entry, uint32_t delay) {
+    if (entry->pprev)
+        wheel_unlink(wheel, entry);
+    else
+        wheel->count++;
+
+    // Rounded up from the exact current time, so that a timer never fires early
+    uint64_t ticks = ((uint64_t) wheel->remainder + delay + wheel->resolution - 1) / wheel->resolution;
+    if (ticks == 0)
+        ticks = 1;
+    entry->expiry = wheel->tick + (uint32_t) ticks;
+    wheel_place(wheel, entry);
+}
+
+void timer_wheel_cancel(timer_wheel_t *wheel, timer_wheel_entry_t *entry) {
+    if (!entry->pprev)
+        return;
+    wheel_unlink(wheel, entry);
+    wheel->count--;
+}
+
+int timer_wheel_advance(timer_wheel_t *wheel, uint32_t now) {
+    uint32_t elapsed = now - wheel->now;
+    int fired = 0;
+
+    if ((int32_t) elapsed <= 0)
+        return 0;
+
+    uint64_t total = (uint64_t) wheel->remainder + elapsed;
+    uint32_t ticks = (uint32_t) (total / wheel->resolution);
+    uint32_t remainder = (uint32_t) (total % wheel->resolution);
+
+    // While callbacks run, the wheel stands exactly on the tick being processed
+    wheel->remainder = 0;
+    while (ticks > 0 && wheel->count > 0) {
+        uint32_t step = wheel_next_step(wheel);
+        if (step > ticks)
+            break;
+        wheel->tick += step;
+        ticks -= step;
+        wheel->now = now - (ticks * wheel->resolution + remainder);
+        fired += wheel_process(wheel);
+    }
+
+    // Nothing left to visit before now: an empty wheel needs no cascades
+    wheel->tick += ticks;
+    wheel->remainder = remainder;
+    wheel->now = now;
+    return fired;
+}
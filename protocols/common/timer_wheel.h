@@ -0,0 +1,134 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef TIMER_WHEEL_H_
+#define TIMER_WHEEL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @defgroup TimerWheelGeometry Timer Wheel Geometry
+ * @{
+ * Four levels of 64 slots cover 2^24 ticks (about 46 hours at 10 ms per tick). Longer delays
+ * are parked in the last level and re-filed until they come within range.
+ */
+#define TIMER_WHEEL_BITS   6                                      ///< Slot index bits per level
+#define TIMER_WHEEL_SLOTS  (1 << TIMER_WHEEL_BITS)                ///< Slots per level
+#define TIMER_WHEEL_LEVELS 4                                      ///< Number of levels
+#define TIMER_WHEEL_RANGE  (1UL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) ///< Ticks covered by the levels
+/** @} */
+
+/**
+ * @brief Called when a timer expires. The timer is no longer armed and may be re-armed.
+ *
+ * @param ctx User context pointer given to timer_wheel_entry_init().
+ */
+typedef void (*timer_wheel_callback_t)(void *ctx);
+
+/**
+ * @brief A timer, embedded by its owner and linked into the wheel while armed.
+ *
+ * The wheel never allocates: arming and cancelling only relink the entry.
+ */
+typedef struct timer_wheel_entry {
+    struct timer_wheel_entry *next;   ///< Next entry in the slot
+    struct timer_wheel_entry **pprev; ///< Link pointing to this entry, NULL when not armed
+    uint32_t expiry;                  ///< Tick at which the timer expires
+    timer_wheel_callback_t callback;  ///< Expiry callback
+    void *ctx;                        ///< User context passed to the callback
+} timer_wheel_entry_t;
+
+/**
+ * @brief Hierarchical timer wheel.
+ *
+ * Arming and cancelling are O(1). timer_wheel_advance() moves the wheel to the time given by
+ * the caller, so any monotonic clock (or a test clock) drives it; a bitmap of occupied slots
+ * lets it skip idle ticks instead of visiting them one by one. Timers never fire early and at
+ * most one tick late. The structure requires no dynamic memory; it is not thread safe.
+ */
+typedef struct {
+    timer_wheel_entry_t *slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS]; ///< Entries of each slot
+    uint64_t occupied[TIMER_WHEEL_LEVELS];                             ///< Bit n set when slot n is not empty
+    uint32_t resolution;                                               ///< Milliseconds per tick
+    uint32_t tick;                                                     ///< Last tick processed
+    uint32_t remainder;                                                ///< Milliseconds elapsed since that tick
+    uint32_t now;                                                      ///< Time in milliseconds; during callbacks, the expiry time
+    size_t count;                                                      ///< Armed timers
+} timer_wheel_t;
+
+/**
+ * @brief Initializes an empty wheel.
+ *
+ * @param wheel Pointer to the wheel to initialize.
+ * @param resolution Milliseconds per tick, the granularity of every timer.
+ * @param now Current time in milliseconds.
+ */
+void timer_wheel_init(timer_wheel_t *wheel, uint32_t resolution, uint32_t now);
+
+/**
+ * @brief Initializes a timer, not armed.
+ *
+ * @param entry Pointer to the timer.
+ * @param callback Function called when the timer expires.
+ * @param ctx User context pointer passed unchanged to the callback.
+ */
+void timer_wheel_entry_init(timer_wheel_entry_t *entry, timer_wheel_callback_t callback, void *ctx);
+
+/**
+ * @brief Arms a timer, or re-arms it if it is already armed.
+ *
+ * @param wheel Pointer to the wheel.
+ * @param entry Pointer to an initialized timer.
+ * @param delay Milliseconds from the current wheel time, rounded up to whole ticks. A zero
+ *              delay expires on the next tick.
+ */
+void timer_wheel_arm(timer_wheel_t *wheel, timer_wheel_entry_t *entry, uint32_t delay);
+
+/**
+ * @brief Disarms a timer. Does nothing if it is not armed.
+ *
+ * @param wheel Pointer to the wheel the timer was armed on.
+ * @param entry Pointer to the timer.
+ */
+void timer_wheel_cancel(timer_wheel_t *wheel, timer_wheel_entry_t *entry);
+
+/**
+ * @brief Tells whether a timer is armed.
+ */
+static inline bool timer_wheel_armed(const timer_wheel_entry_t *entry) {
+    return entry->pprev != NULL;
+}
+
+/**
+ * @brief Moves the wheel to the current time and calls the callbacks of the expired timers.
+ *
+ * Timers fire in expiry order; the order of timers expiring on the same tick is unspecified.
+ * Callbacks may arm and cancel any timer, including the one that fired.
+ *
+ * @param wheel Pointer to the wheel.
+ * @param now Current time in milliseconds. Times earlier than the last call are ignored.
+ * @return Number of timers that fired.
+ */
+int timer_wheel_advance(timer_wheel_t *wheel, uint32_t now);
+
+#endif /* TIMER_WHEEL_H_ */
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "common.h"
+#include "hdlc.h"
+#include "fx25.h"
+
+// Modes defined by the FX.25 specification, table 1
+static const fx25_mode_t fx25_modes[] = {
+    { 0x01, 0xB74DB7DF8A532F3EULL, 255, 239 },
+    { 0x02, 0x26FF60A600CC8FDEULL, 144, 128 },
+    { 0x03, 0xC7DC0508F3D9B09EULL, 80, 64 },
+    { 0x04, 0x8F056EB4369660EEULL, 48, 32 },
+    { 0x05, 0x6E260B1AC5835FAEULL, 255, 223 },
+    { 0x06, 0xFF94DC634F1CFF4EULL, 160, 128 },
+    { 0x07, 0x1EB7B9CDBC09C00EULL, 96, 64 },
+    { 0x08, 0xDBF869BD2DBB1776ULL, 64, 32 },
+    { 0x09, 0x3ADB0C13DEAE2836ULL, 255, 191 },
+    { 0x0A, 0xAB69DB6A543188D6ULL, 192, 128 },
+    { 0x0B, 0x4A4ABEC4A724B796ULL, 128, 64 },
+};
+
+#define FX25_MODES ((int) (sizeof(fx25_modes) / sizeof(fx25_modes[0])))
+
+// Codes for 16, 32 and 64 check bytes, first generator root alpha^1
+static rs_code_t fx25_rs_codes[3];
+static bool fx25_tables_ready = false;
+
+static const rs_code_t* fx25_rs(int nroots) {
+    switch (nroots) {
+        case 16:
+            return &fx25_rs_codes[0];
+        case 32:
+            return &fx25_rs_codes[1];
+        case 64:
+            return &fx25_rs_codes[2];
+        default:
+            return NULL;
+    }
+}
+
+void fx25_tables_init(void) {
+    if (fx25_tables_ready)
+        return;
+
+    for (int g = 0; g < 3; g++) {
+        rs_init(&fx25_rs_codes[g], 1, 16 << g);
+    }
+
+    fx25_tables_ready = true;
+}
+
+const fx25_mode_t* fx25_mode_get(int tag) {
+    for (int i = 0; i < FX25_MODES; i++) {
+        if (fx25_modes[i].tag == tag)
+            return &fx25_modes[i];
+    }
+    return NULL;
+}
+
+const fx25_mode_t* fx25_mode_select(int dataLen, int checkBytes) {
+    const fx25_mode_t *best = NULL;
+
+    for (int i = 0; i < FX25_MODES; i++) {
+        const fx25_mode_t *mode = &fx25_modes[i];
+        if (mode->n - mode->k == checkBytes && mode->k >= dataLen && (!best || mode->k < best->k))
+            best = mode;
+    }
+    return best;
+}
+
+void fx25_rs_encode(const unsigned char *data, int k, unsigned char *check, int nroots) {
+    fx25_tables_init();
+    const rs_code_t *rs = fx25_rs(nroots);
+    if (rs)
+        rs_encode(rs, data, k, check);
+}
+
+int fx25_rs_decode(unsigned char *block, int n, int nroots) {
+    fx25_tables_init();
+    const rs_code_t *rs = fx25_rs(nroots);
+    if (!rs)
+        return -1;
+    return rs_decode(rs, block, n);
+}
+
+int fx25_frame_encode(const unsigned char *frame, int frameLen, int checkBytes, unsigned char *out, int *outLen) {
+    unsigned char stuffed[FX25_MAX_BLOCK_LEN * 6 / 5 + 8];
+    unsigned char symbols[FX25_MAX_BLOCK_LEN];
+    int stuffedLen;
+
+    // Two flags and the FCS make the encoded frame at least four bytes longer
+    if (frameLen < 0 || frameLen + 4 > FX25_MAX_BLOCK_LEN - checkBytes)
+        return -1;
+
+    hdlc_frame_encode_fast(frame, frameLen, stuffed, &stuffedLen);
+    const fx25_mode_t *mode = fx25_mode_select(stuffedLen, checkBytes);
+    if (!mode)
+        return -1;
+
+    // Every FX.25 byte is sent least significant bit first, while the HDLC bitstream packs the
+    // first bit highest: the codeblock symbols are the bit-reversed stream bytes
+    for (int i = 0; i < FX25_TAG_LEN; i++) {
+        out[i] = ReverseBits((mode->value >> (8 * i)) & 0xFF);
+    }
+
+    unsigned char *block = out + FX25_TAG_LEN;
+    memcpy(block, stuffed, stuffedLen);
+    memset(block + stuffedLen, 0x7E, mode->k - stuffedLen);
+    for (int i = 0; i < mode->k; i++) {
+        symbols[i] = ReverseBits(block[i]);
+    }
+
+    int nroots = mode->n - mode->k;
+    fx25_rs_encode(symbols, mode->k, block + mode->k, nroots);
+    for (int i = mode->k; i < mode->n; i++) {
+        block[i] = ReverseBits(block[i]);
+    }
+
+    *outLen = FX25_TAG_LEN + mode->n;
+    return 0;
+}
+
+static const fx25_mode_t* fx25_tag_match(uint64_t shift) {
+    for (int i = 0; i < FX25_MODES; i++) {
+        if (__builtin_popcountll(shift ^ fx25_modes[i].value) <= FX25_TAG_MAX_ERRORS)
+            return &fx25_modes[i];
+    }
+    return NULL;
+}
+
+// Corrects a complete codeblock and hands its information bytes to the deframer
+static int fx25_rx_block(fx25_rx_t *rx) {
+    const fx25_mode_t *mode = rx->mode;
+    int delivered = 0;
+
+    int corrected = fx25_rs_decode(rx->block, mode->n, mode->n - mode->k);
+    if (corrected < 0) {
+        rx->failures++;
+    } else {
+        rx->blocks++;
+        rx->corrected += corrected;
+        for (int i = 0; i < mode->k; i++) {
+            rx->block[i] = ReverseBits(rx->block[i]);
+        }
+        hdlc_deframer_reset(&rx->deframer);
+        delivered = hdlc_deframer_push(&rx->deframer, rx->block, mode->k);
+    }
+
+    rx->mode = NULL;
+    rx->shift = 0;
+    return delivered;
+}
+
+void fx25_rx_init(fx25_rx_t *rx, fx25_frame_callback_t callback, void *ctx) {
+    fx25_tables_init();
+    memset(rx, 0, sizeof(fx25_rx_t));
+    hdlc_deframer_init(&rx->deframer, callback, ctx);
+}
+
+void fx25_rx_reset(fx25_rx_t *rx) {
+    rx->shift = 0;
+    rx->mode = NULL;
+    rx->bitCount = 0;
+    rx->blockLen = 0;
+}
+
+int fx25_rx_push(fx25_rx_t *rx, const unsigned char *data, int len) {
+    int delivered = 0;
+
+    for (int i = 0; i < len; i++) {
+        for (int k = 7; k >= 0; k--) {
+            unsigned int bit = (data[i] >> k) & 0x01;
+
+            if (!rx->mode) {
+                // The tag is sent least significant bit first, so the oldest bit ends up lowest
+                rx->shift = (rx->shift >> 1) | ((uint64_t) bit << 63);
+                rx->mode = fx25_tag_match(rx->shift);
+                rx->bitCount = 0;
+                rx->blockLen = 0;
+                continue;
+            }
+
+            if (rx->bitCount == 0)
+                rx->block[rx->blockLen] = 0;
+            rx->block[rx->blockLen] |= bit << rx->bitCount;
+            if (++rx->bitCount == 8) {
+                rx->bitCount = 0;
+                if (++rx->blockLen == rx->mode->n)
+                    delivered += fx25_rx_block(rx);
+            }
+        }
+    }
+
+    return delivered;
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef FX25_H_
+#define FX25_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hdlc.h"
+
+/**
+ * @defgroup Fx25Limits FX.25 Limits
+ * @{
+ */
+#define FX25_TAG_LEN        8   ///< Length of a correlation tag, in bytes
+#define FX25_MAX_BLOCK_LEN  255 ///< Largest FEC codeblock, in bytes
+#define FX25_MAX_FRAME_LEN  (FX25_TAG_LEN + FX25_MAX_BLOCK_LEN) ///< Largest output of fx25_frame_encode(), in bytes
+#ifndef FX25_TAG_MAX_ERRORS
+#define FX25_TAG_MAX_ERRORS 8   ///< Bit errors tolerated when matching a correlation tag
+#endif
+/** @} */
+
+/**
+ * @brief FX.25 FEC mode, as assigned to a correlation tag.
+ *
+ * Every mode is a Reed-Solomon code over GF(256), possibly shortened from RS(255, 255 - nroots),
+ * with n - k check bytes appended to k information bytes.
+ */
+typedef struct {
+    uint8_t tag;    ///< Correlation tag number (Tag_01 to Tag_0B)
+    uint64_t value; ///< Correlation tag value, transmitted least significant bit first
+    uint8_t n;      ///< Codeblock length in bytes
+    uint8_t k;      ///< Information bytes in the codeblock
+} fx25_mode_t;
+
+/**
+ * @brief Callback invoked by the FX.25 receiver for every recovered frame.
+ *
+ * Same contract as hdlc_frame_callback_t: the frame is in normal AX.25 bit order, without FCS.
+ */
+typedef hdlc_frame_callback_t fx25_frame_callback_t;
+
+/**
+ * @brief State of a streaming FX.25 receiver.
+ *
+ * Looks for correlation tags in a continuous bitstream at any bit offset, collects the
+ * codeblock that follows, corrects it and extracts the AX.25 frames it carries. The structure
+ * must be initialized with fx25_rx_init() and requires no dynamic memory.
+ */
+typedef struct {
+    hdlc_deframer_t deframer;                ///< Extracts the frames from corrected codeblocks
+    uint64_t shift;                          ///< Last 64 bits received, the newest one highest
+    const fx25_mode_t *mode;                 ///< Mode of the codeblock being collected, NULL while searching
+    int bitCount;                            ///< Bits of the current codeblock byte
+    int blockLen;                            ///< Complete bytes of the codeblock
+    unsigned char block[FX25_MAX_BLOCK_LEN]; ///< Codeblock collected so far
+    uint32_t blocks;                         ///< Codeblocks decoded successfully
+    uint32_t corrected;                      ///< Byte errors corrected over all codeblocks
+    uint32_t failures;                       ///< Codeblocks with too many errors to correct
+} fx25_rx_t;
+
+/**
+ * @brief Builds the Reed-Solomon codes used by FX.25.
+ *
+ * The tables are built on first use. Applications that use FX.25 from several threads should
+ * call this function once at startup.
+ */
+void fx25_tables_init(void);
+
+/**
+ * @brief Returns the FEC mode assigned to a correlation tag.
+ *
+ * @param tag Correlation tag number.
+ * @return Pointer to the mode, or NULL if the tag is reserved or undefined.
+ */
+const fx25_mode_t* fx25_mode_get(int tag);
+
+/**
+ * @brief Selects the smallest FEC mode able to carry a bit-stuffed frame.
+ *
+ * @param dataLen Length of the HDLC encoded frame, flags included, in bytes.
+ * @param checkBytes Number of Reed-Solomon check bytes: 16, 32 or 64.
+ * @return Pointer to the mode, or NULL if checkBytes is not valid or the frame is too long.
+ */
+const fx25_mode_t* fx25_mode_select(int dataLen, int checkBytes);
+
+/**
+ * @brief Computes the Reed-Solomon check bytes of a codeblock.
+ *
+ * FX.25 uses the rs_code_t codes with first generator root alpha^1. Shortened codes are encoded
+ * directly, as if leading zero bytes were present.
+ *
+ * @param data Pointer to the information bytes.
+ * @param k Number of information bytes, at most 255 - nroots.
+ * @param check Pointer to the output buffer for the nroots check bytes.
+ * @param nroots Number of check bytes: 16, 32 or 64.
+ */
+void fx25_rs_encode(const unsigned char *data, int k, unsigned char *check, int nroots);
+
+/**
+ * @brief Corrects a Reed-Solomon codeblock in place, with rs_decode().
+ *
+ * @param block Pointer to the codeblock: information bytes followed by the check bytes.
+ * @param n Length of the codeblock in bytes.
+ * @param nroots Number of check bytes: 16, 32 or 64.
+ * @return Number of corrected bytes (at most nroots / 2), or -1 if the block cannot be corrected.
+ */
+int fx25_rs_decode(unsigned char *block, int n, int nroots);
+
+/**
+ * @brief Encodes an AX.25 frame into an FX.25 frame.
+ *
+ * The frame is HDLC encoded with hdlc_frame_encode_fast(), padded with flags to the
+ * information size of the smallest suitable mode, and followed by its check bytes. The
+ * output holds the correlation tag and the codeblock in the same bit packing as
+ * hdlc_frame_encode(). The AX.25 frame inside stays readable by receivers without FX.25.
+ * Preamble and postamble flags are left to the caller.
+ *
+ * @param frame Pointer to the AX.25 frame, in normal bit order, without FCS.
+ * @param frameLen Length of the frame in bytes.
+ * @param checkBytes Number of Reed-Solomon check bytes: 16, 32 or 64.
+ * @param out Pointer to the output buffer, at least FX25_MAX_FRAME_LEN bytes long.
+ * @param outLen Pointer to an integer where the output length will be stored, in bytes.
+ * @return 0 on success, -1 if checkBytes is not valid or the frame does not fit any mode.
+ */
+int fx25_frame_encode(const unsigned char *frame, int frameLen, int checkBytes, unsigned char *out, int *outLen);
+
+/**
+ * @brief Initializes a streaming FX.25 receiver.
+ *
+ * @param rx Pointer to the receiver to initialize.
+ * @param callback Function called for each frame recovered from a codeblock.
+ * @param ctx User context pointer passed unchanged to the callback.
+ */
+void fx25_rx_init(fx25_rx_t *rx, fx25_frame_callback_t callback, void *ctx);
+
+/**
+ * @brief Drops any partially received codeblock and searches for the next correlation tag.
+ *
+ * Statistics are preserved.
+ *
+ * @param rx Pointer to the receiver to reset.
+ */
+void fx25_rx_reset(fx25_rx_t *rx);
+
+/**
+ * @brief Pushes a chunk of the received bitstream into the FX.25 receiver.
+ *
+ * Bits are consumed most significant bit first, as produced by fx25_frame_encode(). A
+ * correlation tag is accepted with up to FX25_TAG_MAX_ERRORS wrong bits. Only frames carried
+ * in a codeblock are delivered: legacy AX.25 reception needs a separate hdlc_deframer_t fed
+ * with the same bitstream.
+ *
+ * @param rx Pointer to an initialized receiver.
+ * @param data Pointer to the received bytes.
+ * @param len Number of bytes in data.
+ * @return Number of frames delivered through the callback during this call.
+ */
+int fx25_rx_push(fx25_rx_t *rx, const unsigned char *data, int len);
+
+#endif /* FX25_H_ */
@@ -24,8 +24,10 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "common.h"
+#include "hdlc.h"
 
 unsigned char ReverseBits(unsigned char byte) {
     byte = ((byte >> 1) & 0x55) | ((byte & 0x55) << 1);
@@ -34,14 +36,48 @@ unsigned char ReverseBits(unsigned char byte) {
     return byte;
 }
 
-void hdlc_frame_encode(unsigned char *frame, int frameLen, unsigned char *encodedFrame, int *encodedLen) {
-    for (int i = 0; i < frameLen; i++) {
-        frame[i] = ReverseBits(frame[i]);
+// NRZI decoding of one byte: a 1 bit is a bit equal to the one before it, the first bit of the
+// byte being compared with the previous line level.
+static inline unsigned char hdlc_nrzi_decode_byte(unsigned char byte, unsigned int level) {
+    return ~(byte ^ ((byte >> 1) | (level << 7))) & 0xFF;
+}
+
+// NRZI encoding of the n low bits of word (first bit highest). Every output bit is the previous
+// level XORed with the inverted input bit, i.e. a running parity of the inverted input, which is
+// computed for all bits at once with a prefix XOR.
+static inline uint32_t hdlc_nrzi_encode_bits(uint32_t word, int n, uint8_t *level) {
+    uint32_t mask = (n < 32) ? ((1u << n) - 1) : 0xFFFFFFFFu;
+    uint32_t t = ~word & mask;
+    t ^= t >> 1;
+    t ^= t >> 2;
+    t ^= t >> 4;
+    t ^= t >> 8;
+    t ^= t >> 16;
+    if (*level)
+        t ^= mask;
+    *level = t & 0x01;
+    return t;
+}
+
+void hdlc_nrzi_encode(const unsigned char *in, unsigned char *out, int len, uint8_t *level) {
+    for (int i = 0; i < len; i++) {
+        out[i] = hdlc_nrzi_encode_bits(in[i], 8, level);
     }
+}
+
+void hdlc_nrzi_decode(const unsigned char *in, unsigned char *out, int len, uint8_t *level) {
+    for (int i = 0; i < len; i++) {
+        unsigned char raw = in[i];
+        out[i] = hdlc_nrzi_decode_byte(raw, *level);
+        *level = raw & 0x01;
+    }
+}
 
-    uint16_t crc = CRC(frame, frameLen);
-    frame[frameLen++] = (crc >> 8) & 0xFF;
-    frame[frameLen++] = crc & 0xFF;
+void hdlc_frame_encode(const unsigned char *frame, int frameLen, unsigned char *encodedFrame, int *encodedLen) {
+    crc_ctx_t fcs;
+    crc_init(&fcs);
+    crc_update(&fcs, frame, frameLen);
+    uint16_t crc = crc_final(&fcs);
 
     int cnt = 0;
     int bitIndex = 7;
@@ -50,9 +86,11 @@ void hdlc_frame_encode(unsigned char *frame, int frameLen, unsigned char *encode
 
     encodedFrame[encodedIndex++] = 0x7E;
 
-    for (int i = 0; i < frameLen; i++) {
-        for (int mask = 128; mask > 0; mask >>= 1) {
-            if (frame[i] & mask) {
+    // Bytes are sent least significant bit first, followed by the FCS low byte first
+    for (int i = 0; i < frameLen + 2; i++) {
+        unsigned char value = (i < frameLen) ? frame[i] : (i == frameLen) ? (crc & 0xFF) : (crc >> 8);
+        for (int mask = 1; mask < 256; mask <<= 1) {
+            if (value & mask) {
                 byte |= (1 << bitIndex);
                 bitIndex--;
                 if (bitIndex < 0) {
@@ -180,3 +218,850 @@ int hdlc_frame_decode(unsigned char *encodedFrame, int encodedLen, unsigned char
     *decodedLen = decodedIndex;
     return 0;
 }
+
+// Receive state table, indexed by [run of 1 bits][input byte]. Each entry describes the effect
+// of the eight input bits (most significant first) when none of them completes a flag or an
+// abort: bits 0-7 hold the destuffed output bits (first bit highest), bits 8-11 their count and
+// bits 12-14 the new run state. Entries whose byte contains a flag or an abort only carry
+// HDLC_RX_TABLE_EVENT and are handled bit by bit.
+#define HDLC_RX_TABLE_EVENT 0x8000
+
+static uint16_t hdlc_rx_table[8][256];
+
+// Transmit stuffing table, indexed by [run of 1 bits][input byte]. The byte is taken in normal
+// AX.25 order and sent least significant bit first: bits 0-9 hold the stuffed output bits
+// (first transmitted bit highest), bits 10-13 their count and bits 14-16 the new run state.
+static uint32_t hdlc_tx_table[5][256];
+
+static bool hdlc_tables_ready = false;
+
+static int hdlc_scan_scalar(const unsigned char *data, int len, int start);
+static int (*hdlc_scan_kernel)(const unsigned char *data, int len, int start) = hdlc_scan_scalar;
+
+// A flag or an abort always contains six consecutive 1 bits, which bit stuffing never lets
+// through inside a frame. Each kernel looks at every byte together with the next one as a
+// 16-bit word (first bit highest) and reports the first byte in which such a run starts.
+static inline bool hdlc_scan_word(unsigned int w) {
+    unsigned int a = w & (w << 1);  // runs of 2
+    unsigned int b = a & (a << 2);  // runs of 4
+    return (b & (a << 4) & 0xFF00) != 0;
+}
+
+static int hdlc_scan_scalar(const unsigned char *data, int len, int start) {
+    for (int i = start; i < len; i++) {
+        unsigned int next = (i + 1 < len) ? data[i + 1] : 0;
+        if (hdlc_scan_word((data[i] << 8) | next))
+            return i;
+    }
+    return len;
+}
+
+// Same search on an NRZI coded bitstream: every word is decoded before the test. The line level
+// before data[0] is given by level. Bits past the end are taken as transitions (0 bits).
+static int hdlc_scan_nrzi(const unsigned char *data, int len, int start, unsigned int level) {
+    for (int i = start; i < len; i++) {
+        unsigned int prev = (i > 0) ? data[i - 1] & 0x01 : level;
+        unsigned int next = (i + 1 < len) ? hdlc_nrzi_decode_byte(data[i + 1], data[i] & 0x01) : 0;
+        if (hdlc_scan_word((hdlc_nrzi_decode_byte(data[i], prev) << 8) | next))
+            return i;
+    }
+    return len;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HDLC_HAVE_SSE2 1
+#define HDLC_HAVE_AVX2 1
+#include <immintrin.h>
+
+__attribute__((target("sse2")))
+static int hdlc_scan_sse2(const unsigned char *data, int len, int start) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i high = _mm_set1_epi16((short) 0xFF00);
+    int i = start;
+
+    // Needs one byte past the block for the word of its last byte
+    while (i + 17 <= len) {
+        __m128i cur = _mm_loadu_si128((const __m128i*) (data + i));
+        __m128i next = _mm_loadu_si128((const __m128i*) (data + i + 1));
+        __m128i any = zero;
+        for (int half = 0; half < 2; half++) {
+            __m128i w = half ? _mm_unpackhi_epi8(next, cur) : _mm_unpacklo_epi8(next, cur);
+            __m128i a = _mm_and_si128(w, _mm_slli_epi16(w, 1));
+            __m128i b = _mm_and_si128(a, _mm_slli_epi16(a, 2));
+            any = _mm_or_si128(any, _mm_and_si128(_mm_and_si128(b, _mm_slli_epi16(a, 4)), high));
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(any, zero)) != 0xFFFF)
+            return hdlc_scan_scalar(data, len, i);
+        i += 16;
+    }
+
+    return hdlc_scan_scalar(data, len, i);
+}
+
+__attribute__((target("avx2")))
+static int hdlc_scan_avx2(const unsigned char *data, int len, int start) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i high = _mm256_set1_epi16((short) 0xFF00);
+    int i = start;
+
+    while (i + 33 <= len) {
+        __m256i cur = _mm256_loadu_si256((const __m256i*) (data + i));
+        __m256i next = _mm256_loadu_si256((const __m256i*) (data + i + 1));
+        __m256i any = zero;
+        for (int half = 0; half < 2; half++) {
+            __m256i w = half ? _mm256_unpackhi_epi8(next, cur) : _mm256_unpacklo_epi8(next, cur);
+            __m256i a = _mm256_and_si256(w, _mm256_slli_epi16(w, 1));
+            __m256i b = _mm256_and_si256(a, _mm256_slli_epi16(a, 2));
+            any = _mm256_or_si256(any, _mm256_and_si256(_mm256_and_si256(b, _mm256_slli_epi16(a, 4)), high));
+        }
+        if (!_mm256_testz_si256(any, any))
+            return hdlc_scan_scalar(data, len, i);
+        i += 32;
+    }
+
+    return hdlc_scan_sse2(data, len, i);
+}
+#endif
+
+void hdlc_tables_init(void) {
+    if (hdlc_tables_ready)
+        return;
+
+    for (int state = 0; state < 8; state++) {
+        for (int byte = 0; byte < 256; byte++) {
+            int ones = state;
+            int out = 0;
+            int count = 0;
+            bool event = false;
+
+            for (int k = 7; k >= 0 && !event; k--) {
+                if ((byte >> k) & 0x01) {
+                    if (ones == 6) {
+                        event = true;
+                    } else if (ones < 6 && ++ones < 6) {
+                        out = (out << 1) | 1;
+                        count++;
+                    }
+                } else {
+                    if (ones == 6) {
+                        event = true;
+                    } else {
+                        if (ones != 5) {
+                            out <<= 1;
+                            count++;
+                        }
+                        ones = 0;
+                    }
+                }
+            }
+
+            hdlc_rx_table[state][byte] = event ? HDLC_RX_TABLE_EVENT : (uint16_t) (out | (count << 8) | (ones << 12));
+        }
+    }
+
+    for (int state = 0; state < 5; state++) {
+        for (int byte = 0; byte < 256; byte++) {
+            int ones = state;
+            uint32_t out = 0;
+            int count = 0;
+
+            for (int k = 0; k < 8; k++) {
+                if ((byte >> k) & 0x01) {
+                    out = (out << 1) | 1;
+                    count++;
+                    if (++ones == 5) {
+                        out <<= 1;
+                        count++;
+                        ones = 0;
+                    }
+                } else {
+                    out <<= 1;
+                    count++;
+                    ones = 0;
+                }
+            }
+
+            hdlc_tx_table[state][byte] = out | (count << 10) | (ones << 14);
+        }
+    }
+
+#ifdef HDLC_HAVE_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        hdlc_scan_kernel = hdlc_scan_avx2;
+    else
+        hdlc_scan_kernel = hdlc_scan_sse2;
+#elif defined(HDLC_HAVE_SSE2)
+    hdlc_scan_kernel = hdlc_scan_sse2;
+#endif
+
+    hdlc_tables_ready = true;
+}
+
+int hdlc_scan_flags(const unsigned char *data, int len, int start) {
+    hdlc_tables_init();
+    if (start < 0)
+        start = 0;
+    if (start >= len)
+        return len;
+    return hdlc_scan_kernel(data, len, start);
+}
+
+#define HDLC_RX_EVENT_FLAG  1
+#define HDLC_RX_EVENT_ABORT 2
+
+// Called on every flag or abort. Returns non-zero to stop decoding.
+typedef int (*hdlc_rx_event_fn)(hdlc_rx_state_t *rx, unsigned char *frame, int event, void *arg);
+
+static void hdlc_rx_start(hdlc_rx_state_t *rx) {
+    rx->inFrame = true;
+    rx->overrun = false;
+    rx->byte = 0;
+    rx->bitCount = 0;
+    rx->frameLen = 0;
+}
+
+// Tries to fix an FCS mismatch by flipping bits of a frame still in stream bit order (len data
+// bytes followed by the FCS). The CRC is linear, so a flipped bit changes the CRC() mismatch by
+// a syndrome that only depends on the number of data bits sent after it: walking the frame
+// backwards, the syndrome of every bit is one CRC register step away from the previous one.
+// Single bits are tried first, then pairs of adjacent bits (one NRZI level error), then any
+// pair among the candidate bit positions. Returns the number of bits flipped, or -1.
+static int hdlc_fcs_repair(unsigned char *frame, int len, int maxFlips, const int *candidates, int count) {
+    uint16_t syndrome = CRC(frame, len) ^ ((frame[len] << 8) | frame[len + 1]);
+    uint16_t delta[HDLC_RECOVER_MAX_CANDIDATES];
+    int nbits = (len + 2) * 8;
+    uint16_t step = 0x1021;
+    uint16_t prev = 0;
+    int pair = -1;
+
+    if (syndrome == 0)
+        return 0;
+    if (maxFlips < 1)
+        return -1;
+
+    for (int t = nbits - 1; t >= 0; t--) {
+        uint16_t d;
+        if (t >= len * 8) {
+            // FCS bits only change the received FCS
+            d = 1 << (nbits - 1 - t);
+        } else {
+            d = step;
+            step = (step & 0x8000) ? (step << 1) ^ 0x1021 : step << 1;
+        }
+
+        if (d == syndrome) {
+            frame[t / 8] ^= 0x80 >> (t % 8);
+            return 1;
+        }
+        if (pair < 0 && t < nbits - 1 && (d ^ prev) == syndrome)
+            pair = t;
+        for (int c = 0; c < count; c++) {
+            if (candidates[c] == t)
+                delta[c] = d;
+        }
+        prev = d;
+    }
+
+    if (maxFlips < 2)
+        return -1;
+
+    if (pair >= 0) {
+        frame[pair / 8] ^= 0x80 >> (pair % 8);
+        frame[(pair + 1) / 8] ^= 0x80 >> ((pair + 1) % 8);
+        return 2;
+    }
+
+    for (int a = 0; a < count; a++) {
+        for (int b = a + 1; b < count; b++) {
+            if ((delta[a] ^ delta[b]) == syndrome) {
+                frame[candidates[a] / 8] ^= 0x80 >> (candidates[a] % 8);
+                frame[candidates[b] / 8] ^= 0x80 >> (candidates[b] % 8);
+                return 2;
+            }
+        }
+    }
+
+    return -1;
+}
+
+// Validates the frame collected since the previous flag and converts it to normal bit order.
+// The flag itself left its leading 0 and five of its 1 bits in the partial byte, so a frame
+// made of whole bytes always ends with exactly six pending bits. An FCS mismatch is repaired
+// by flipping up to maxFlips bits when maxFlips is not 0; the number flipped goes to flips.
+// Returns the frame length without FCS, or -1 if the frame is invalid.
+static int hdlc_rx_complete(hdlc_rx_state_t *rx, unsigned char *frame, int maxFlips, int *flips) {
+    if (!rx->inFrame || rx->overrun || rx->bitCount != 6 || rx->frameLen < 2)
+        return -1;
+
+    int len = rx->frameLen - 2;
+    uint16_t frameCRC = (frame[len] << 8) | frame[len + 1];
+    int fixed = 0;
+    if (CRC(frame, len) != frameCRC) {
+        fixed = (maxFlips > 0) ? hdlc_fcs_repair(frame, len, maxFlips, NULL, 0) : -1;
+        if (fixed < 0)
+            return -1;
+    }
+    if (flips)
+        *flips = fixed;
+
+    for (int i = 0; i < len; i++) {
+        frame[i] = ReverseBits(frame[i]);
+    }
+
+    return len;
+}
+
+// Bit-serial reference path, also used for the bytes flagged as events by the state table.
+static int hdlc_rx_bit(hdlc_rx_state_t *rx, unsigned char *frame, int frameMax, unsigned char bit, hdlc_rx_event_fn fn, void *arg) {
+    int append = 0;
+
+    if (bit) {
+        if (rx->ones == 6) {
+            // Seventh consecutive 1: abort, wait for the next flag
+            rx->ones = 7;
+            return fn(rx, frame, HDLC_RX_EVENT_ABORT, arg);
+        } else if (rx->ones < 6) {
+            // The sixth 1 is held back until the next bit tells flag from abort
+            append = (++rx->ones < 6);
+        }
+    } else {
+        if (rx->ones == 6) {
+            rx->ones = 0;
+            return fn(rx, frame, HDLC_RX_EVENT_FLAG, arg);
+        }
+        // A 0 after five 1 bits is a stuffed bit and is dropped
+        append = (rx->ones != 5);
+        rx->ones = 0;
+    }
+
+    if (append && rx->inFrame) {
+        rx->byte = (rx->byte << 1) | bit;
+        if (++rx->bitCount == 8) {
+            if (rx->frameLen < frameMax) {
+                frame[rx->frameLen++] = rx->byte;
+            } else {
+                rx->overrun = true;
+            }
+            rx->byte = 0;
+            rx->bitCount = 0;
+        }
+    }
+
+    return 0;
+}
+
+// Table-driven receive loop. Returns the number of input bytes consumed, which is less than len
+// only when the event function asked to stop. NRZI coded input is decoded on the fly, one byte
+// at a time, right before the table lookup.
+static int hdlc_rx_run(hdlc_rx_state_t *rx, unsigned char *frame, int frameMax, const unsigned char *data, int len, hdlc_rx_event_fn fn, void *arg) {
+    unsigned int chunkLevel = rx->level;
+
+    for (int i = 0; i < len; i++) {
+        unsigned char value = data[i];
+        if (rx->nrzi) {
+            value = hdlc_nrzi_decode_byte(value, rx->level);
+            rx->level = data[i] & 0x01;
+        }
+        uint16_t entry = hdlc_rx_table[rx->ones][value];
+
+        if (entry & HDLC_RX_TABLE_EVENT) {
+            hdlc_rx_state_t before = *rx;
+            for (int k = 7; k >= 0; k--) {
+                if (hdlc_rx_bit(rx, frame, frameMax, (value >> k) & 0x01, fn, arg))
+                    return i + 1;
+            }
+            // Flag fill: a byte that left an empty frame in the same state it found it will do
+            // so again, so every following copy of the same byte can be skipped
+            if (rx->frameLen == 0 && before.frameLen == 0 && rx->ones == before.ones && rx->inFrame == before.inFrame && rx->byte == before.byte
+                    && rx->bitCount == before.bitCount && !rx->overrun) {
+                if (rx->nrzi) {
+                    while (i + 1 < len && hdlc_nrzi_decode_byte(data[i + 1], rx->level) == value) {
+                        i++;
+                        rx->level = data[i] & 0x01;
+                    }
+                } else {
+                    while (i + 1 < len && data[i + 1] == data[i])
+                        i++;
+                }
+            }
+        } else {
+            rx->ones = (entry >> 12) & 0x07;
+        }
+
+        if (!rx->inFrame) {
+            // Out of a frame nothing happens until the next flag: jump to the next byte where six
+            // 1 bits may start. The run count is then given by the trailing 1 bits of the byte
+            // before it, which holds at least one 0 bit since it is not a candidate itself.
+            int next = rx->nrzi ? hdlc_scan_nrzi(data, len, i, chunkLevel) : hdlc_scan_kernel(data, len, i);
+            if (next > i + 1) {
+                unsigned char last = data[next - 1];
+                if (rx->nrzi) {
+                    rx->level = last & 0x01;
+                    last = hdlc_nrzi_decode_byte(last, data[next - 2] & 0x01);
+                }
+                int ones = 0;
+                while (last & 0x01) {
+                    ones++;
+                    last >>= 1;
+                }
+                rx->ones = ones;
+                i = next - 1;
+            }
+            continue;
+        }
+        if (entry & HDLC_RX_TABLE_EVENT)
+            continue;
+
+        int count = (entry >> 8) & 0x0F;
+        unsigned int acc = ((unsigned int) rx->byte << count) | (entry & 0xFF);
+        rx->bitCount += count;
+        if (rx->bitCount >= 8) {
+            rx->bitCount -= 8;
+            if (rx->frameLen < frameMax) {
+                frame[rx->frameLen++] = (acc >> rx->bitCount) & 0xFF;
+            } else {
+                rx->overrun = true;
+            }
+        }
+        rx->byte = acc & ((1u << rx->bitCount) - 1);
+    }
+
+    return len;
+}
+
+typedef struct {
+    int result;
+    int len;
+} hdlc_decode_fast_result_t;
+
+static int hdlc_decode_fast_event(hdlc_rx_state_t *rx, unsigned char *frame, int event, void *arg) {
+    hdlc_decode_fast_result_t *res = (hdlc_decode_fast_result_t*) arg;
+
+    if (event == HDLC_RX_EVENT_ABORT) {
+        if (!rx->inFrame)
+            return 0;
+        res->result = -1;
+        return 1;
+    }
+
+    // Opening flag, or several flags in a row before the frame
+    if (!rx->inFrame || (rx->frameLen == 0 && rx->bitCount == 6)) {
+        hdlc_rx_start(rx);
+        return 0;
+    }
+
+    res->len = hdlc_rx_complete(rx, frame, 0, NULL);
+    res->result = (res->len < 0) ? -1 : 0;
+    return 1;
+}
+
+int hdlc_frame_decode_fast(const unsigned char *encodedFrame, int encodedLen, unsigned char *decodedFrame, int *decodedLen) {
+    hdlc_rx_state_t rx = { 0 };
+    hdlc_decode_fast_result_t res = { -1, 0 };
+
+    hdlc_tables_init();
+    hdlc_rx_run(&rx, decodedFrame, encodedLen, encodedFrame, encodedLen, hdlc_decode_fast_event, &res);
+    if (res.result != 0)
+        return -1;
+
+    *decodedLen = res.len;
+    return 0;
+}
+
+int hdlc_frame_decode_nrzi(const unsigned char *encodedFrame, int encodedLen, unsigned char *decodedFrame, int *decodedLen, uint8_t level) {
+    hdlc_rx_state_t rx = { 0 };
+    hdlc_decode_fast_result_t res = { -1, 0 };
+
+    rx.nrzi = true;
+    rx.level = level & 0x01;
+
+    hdlc_tables_init();
+    hdlc_rx_run(&rx, decodedFrame, encodedLen, encodedFrame, encodedLen, hdlc_decode_fast_event, &res);
+    if (res.result != 0)
+        return -1;
+
+    *decodedLen = res.len;
+    return 0;
+}
+
+// Keeps the positions of the count least confident bits seen so far, most confident last
+static void hdlc_recover_candidate(int *pos, uint8_t *conf, int *count, int max, int t, uint8_t c) {
+    if (*count == max && c >= conf[max - 1])
+        return;
+
+    int i = (*count < max) ? (*count)++ : max - 1;
+    while (i > 0 && conf[i - 1] > c) {
+        pos[i] = pos[i - 1];
+        conf[i] = conf[i - 1];
+        i--;
+    }
+    pos[i] = t;
+    conf[i] = c;
+}
+
+int hdlc_frame_decode_recover(const unsigned char *encodedFrame, int encodedLen, unsigned char *decodedFrame, int *decodedLen, const hdlc_recover_t *recover) {
+    int candidates[HDLC_RECOVER_MAX_CANDIDATES];
+    uint8_t candidateConf[HDLC_RECOVER_MAX_CANDIDATES];
+    int candidateCount = 0;
+    int maxCandidates = 0;
+    bool startFlagFound = false;
+    int ones = 0;
+    int bits = 0;
+    unsigned char shiftRegister = 0;
+
+    if (recover && recover->confidence)
+        maxCandidates = (recover->candidates < HDLC_RECOVER_MAX_CANDIDATES) ? recover->candidates : HDLC_RECOVER_MAX_CANDIDATES;
+
+    // Bit-serial destuffing, remembering which decoded bit every encoded bit became
+    for (int r = 0; r < encodedLen * 8; r++) {
+        unsigned char bit = (encodedFrame[r / 8] >> (7 - r % 8)) & 0x01;
+        shiftRegister = (shiftRegister << 1) | bit;
+
+        if (shiftRegister == 0x7E) {
+            if (startFlagFound && bits > 7)
+                break;
+            // Opening flag, or flag fill before the frame
+            startFlagFound = true;
+            ones = 0;
+            bits = 0;
+            candidateCount = 0;
+            continue;
+        }
+        if (!startFlagFound)
+            continue;
+
+        if (bit) {
+            if (++ones > 6)
+                return -1;
+        } else if (ones == 5) {
+            ones = 0;
+            continue;
+        } else {
+            ones = 0;
+        }
+
+        if (bits / 8 >= encodedLen)
+            return -1;
+        if (bits % 8 == 0)
+            decodedFrame[bits / 8] = 0;
+        decodedFrame[bits / 8] |= bit << (7 - bits % 8);
+        if (maxCandidates > 0)
+            hdlc_recover_candidate(candidates, candidateConf, &candidateCount, maxCandidates, bits, recover->confidence[r]);
+        bits++;
+    }
+
+    // The closing flag left its first seven bits in the frame
+    if (shiftRegister != 0x7E || (bits - 7) % 8 != 0 || bits - 7 < 16)
+        return -1;
+    int len = (bits - 7) / 8 - 2;
+
+    // Flag bits are not part of the frame
+    int kept = 0;
+    for (int c = 0; c < candidateCount; c++) {
+        if (candidates[c] < (len + 2) * 8)
+            candidates[kept++] = candidates[c];
+    }
+
+    int fixed = hdlc_fcs_repair(decodedFrame, len, recover ? recover->maxFlips : 1, candidates, kept);
+    if (fixed < 0)
+        return -1;
+
+    for (int i = 0; i < len; i++) {
+        decodedFrame[i] = ReverseBits(decodedFrame[i]);
+    }
+
+    *decodedLen = len;
+    return fixed;
+}
+
+// Appends one byte to the 64-bit transmit accumulator, stuffing it through the table, and
+// flushes 32 bits to the output whenever they are available, NRZI coded when level is not NULL.
+#define HDLC_TX_PUT(acc, nbits, ones, out, outIndex, value, level)                  \
+    do {                                                                            \
+        uint32_t entry_ = hdlc_tx_table[ones][value];                               \
+        int count_ = (entry_ >> 10) & 0x0F;                                         \
+        acc = (acc << count_) | (entry_ & 0x3FF);                                   \
+        ones = (entry_ >> 14) & 0x07;                                               \
+        nbits += count_;                                                            \
+        if (nbits >= 32) {                                                          \
+            nbits -= 32;                                                            \
+            uint32_t word_ = (uint32_t) (acc >> nbits);                             \
+            if (level)                                                              \
+                word_ = hdlc_nrzi_encode_bits(word_, 32, level);                    \
+            out[outIndex++] = (word_ >> 24) & 0xFF;                                 \
+            out[outIndex++] = (word_ >> 16) & 0xFF;                                 \
+            out[outIndex++] = (word_ >> 8) & 0xFF;                                  \
+            out[outIndex++] = word_ & 0xFF;                                         \
+        }                                                                           \
+    } while (0)
+
+// Encodes the frames back to back: the closing flag of a frame opens the next one
+static void hdlc_encode_table(const hdlc_frame_desc_t *frames, int count, unsigned char *encodedFrame, int *encodedLen, uint8_t *level) {
+    uint64_t acc = 0x7E;
+    int nbits = 8;
+    int encodedIndex = 0;
+
+    hdlc_tables_init();
+
+    for (int f = 0; f < count; f++) {
+        const unsigned char *frame = frames[f].frame;
+        int frameLen = frames[f].len;
+        int ones = 0;
+        crc_ctx_t fcs;
+
+        crc_init(&fcs);
+        crc_update(&fcs, frame, frameLen);
+        uint16_t crc = crc_final(&fcs);
+
+        for (int i = 0; i < frameLen; i++) {
+            HDLC_TX_PUT(acc, nbits, ones, encodedFrame, encodedIndex, frame[i], level);
+        }
+
+        HDLC_TX_PUT(acc, nbits, ones, encodedFrame, encodedIndex, crc & 0xFF, level);
+        HDLC_TX_PUT(acc, nbits, ones, encodedFrame, encodedIndex, (crc >> 8) & 0xFF, level);
+
+        // Closing flag is not stuffed
+        acc = (acc << 8) | 0x7E;
+        nbits += 8;
+        if (nbits >= 32) {
+            nbits -= 32;
+            uint32_t word = (uint32_t) (acc >> nbits);
+            if (level)
+                word = hdlc_nrzi_encode_bits(word, 32, level);
+            encodedFrame[encodedIndex++] = (word >> 24) & 0xFF;
+            encodedFrame[encodedIndex++] = (word >> 16) & 0xFF;
+            encodedFrame[encodedIndex++] = (word >> 8) & 0xFF;
+            encodedFrame[encodedIndex++] = word & 0xFF;
+        }
+    }
+
+    // Flush the remaining bits padded with zeros
+    while (nbits >= 8) {
+        nbits -= 8;
+        unsigned char byte = (acc >> nbits) & 0xFF;
+        encodedFrame[encodedIndex++] = level ? hdlc_nrzi_encode_bits(byte, 8, level) : byte;
+    }
+    if (nbits > 0) {
+        unsigned char byte = (acc << (8 - nbits)) & 0xFF;
+        encodedFrame[encodedIndex++] = level ? hdlc_nrzi_encode_bits(byte, 8, level) : byte;
+    }
+
+    *encodedLen = encodedIndex;
+}
+
+void hdlc_frame_encode_fast(const unsigned char *frame, int frameLen, unsigned char *encodedFrame, int *encodedLen) {
+    hdlc_frame_desc_t desc = { frame, frameLen };
+    hdlc_encode_table(&desc, 1, encodedFrame, encodedLen, NULL);
+}
+
+void hdlc_frame_encode_nrzi(const unsigned char *frame, int frameLen, unsigned char *encodedFrame, int *encodedLen, uint8_t *level) {
+    hdlc_frame_desc_t desc = { frame, frameLen };
+    *level &= 0x01;
+    hdlc_encode_table(&desc, 1, encodedFrame, encodedLen, level);
+}
+
+void hdlc_frame_encode_batch(const hdlc_frame_desc_t *frames, int count, unsigned char *encoded, int *encodedLen, uint8_t *level) {
+    if (level)
+        *level &= 0x01;
+    hdlc_encode_table(frames, count, encoded, encodedLen, level);
+}
+
+typedef struct {
+    unsigned char *decoded;    // Output buffer
+    int decodedSize;           // Size of the output buffer
+    int used;                  // Bytes of the output buffer holding frames
+    hdlc_frame_desc_t *frames; // Descriptors of the frames found
+    int maxFrames;             // Size of the descriptor array
+    int count;                 // Frames found
+} hdlc_decode_batch_t;
+
+static int hdlc_decode_batch_event(hdlc_rx_state_t *rx, unsigned char *frame, int event, void *arg) {
+    hdlc_decode_batch_t *batch = (hdlc_decode_batch_t*) arg;
+
+    if (event == HDLC_RX_EVENT_ABORT) {
+        rx->inFrame = false;
+        return 0;
+    }
+
+    if (rx->inFrame && rx->frameLen >= HDLC_MIN_FRAME_LEN + 2) {
+        int len = hdlc_rx_complete(rx, frame, 0, NULL);
+        if (len >= 0) {
+            if (batch->count == batch->maxFrames || batch->used + len > batch->decodedSize)
+                return 1;
+            memcpy(batch->decoded + batch->used, frame, len);
+            batch->frames[batch->count].frame = batch->decoded + batch->used;
+            batch->frames[batch->count].len = len;
+            batch->count++;
+            batch->used += len;
+        }
+    }
+
+    hdlc_rx_start(rx);
+    return 0;
+}
+
+int hdlc_frame_decode_batch(const unsigned char *encoded, int encodedLen, unsigned char *decoded, int decodedSize, hdlc_frame_desc_t *frames,
+        int maxFrames, uint8_t *level) {
+    unsigned char frame[HDLC_MAX_FRAME_LEN];
+    hdlc_rx_state_t rx = { 0 };
+    hdlc_decode_batch_t batch = { decoded, decodedSize, 0, frames, maxFrames, 0 };
+
+    if (level) {
+        rx.nrzi = true;
+        rx.level = *level & 0x01;
+    }
+
+    hdlc_tables_init();
+    hdlc_rx_run(&rx, frame, HDLC_MAX_FRAME_LEN, encoded, encodedLen, hdlc_decode_batch_event, &batch);
+    if (level)
+        *level = rx.level;
+
+    return batch.count;
+}
+
+static int hdlc_deframer_event(hdlc_rx_state_t *rx, unsigned char *frame, int event, void *arg) {
+    hdlc_deframer_t *deframer = (hdlc_deframer_t*) arg;
+
+    if (event == HDLC_RX_EVENT_ABORT) {
+        if (rx->inFrame)
+            deframer->aborts++;
+        rx->inFrame = false;
+        return 0;
+    }
+
+    // Empty frames (flag fill) and runt frames are dropped without being counted as errors
+    if (rx->inFrame && rx->frameLen >= HDLC_MIN_FRAME_LEN + 2) {
+        int flips = 0;
+        int len = hdlc_rx_complete(rx, frame, deframer->recoverFlips, &flips);
+        if (len >= 0) {
+            if (flips > 0)
+                deframer->recovered++;
+            deframer->frames++;
+            deframer->delivered++;
+            if (deframer->callback)
+                deframer->callback(frame, len, deframer->ctx);
+        } else {
+            deframer->fcsErrors++;
+        }
+    }
+
+    hdlc_rx_start(rx);
+    return 0;
+}
+
+void hdlc_deframer_init(hdlc_deframer_t *deframer, hdlc_frame_callback_t callback, void *ctx) {
+    hdlc_tables_init();
+    memset(deframer, 0, sizeof(hdlc_deframer_t));
+    deframer->callback = callback;
+    deframer->ctx = ctx;
+}
+
+void hdlc_deframer_reset(hdlc_deframer_t *deframer) {
+    bool nrzi = deframer->rx.nrzi;
+    memset(&deframer->rx, 0, sizeof(hdlc_rx_state_t));
+    deframer->rx.nrzi = nrzi;
+}
+
+void hdlc_deframer_set_nrzi(hdlc_deframer_t *deframer, bool enable) {
+    deframer->rx.nrzi = enable;
+    deframer->rx.level = 0;
+}
+
+void hdlc_deframer_set_recover(hdlc_deframer_t *deframer, int maxFlips) {
+    deframer->recoverFlips = (maxFlips < 0) ? 0 : (maxFlips > 2) ? 2 : maxFlips;
+}
+
+int hdlc_deframer_push(hdlc_deframer_t *deframer, const unsigned char *data, int len) {
+    deframer->delivered = 0;
+    hdlc_rx_run(&deframer->rx, deframer->frame, HDLC_MAX_FRAME_LEN, data, len, hdlc_deframer_event, deframer);
+    return deframer->delivered;
+}
+
+typedef struct {
+    hdlc_multi_rx_t *mrx;
+    int channel;
+} hdlc_multi_rx_arg_t;
+
+static int hdlc_multi_rx_event(hdlc_rx_state_t *rx, unsigned char *frame, int event, void *arg) {
+    hdlc_multi_rx_t *mrx = ((hdlc_multi_rx_arg_t*) arg)->mrx;
+    int channel = ((hdlc_multi_rx_arg_t*) arg)->channel;
+
+    if (event == HDLC_RX_EVENT_ABORT) {
+        if (rx->inFrame)
+            mrx->aborts[channel]++;
+        rx->inFrame = false;
+        return 0;
+    }
+
+    // Empty frames (flag fill) and runt frames are dropped without being counted as errors
+    if (rx->inFrame && rx->frameLen >= HDLC_MIN_FRAME_LEN + 2) {
+        int len = hdlc_rx_complete(rx, frame, 0, NULL);
+        if (len >= 0) {
+            mrx->frames[channel]++;
+            mrx->delivered++;
+            if (mrx->callback)
+                mrx->callback(channel, frame, len, mrx->ctx);
+        } else {
+            mrx->fcsErrors[channel]++;
+        }
+    }
+
+    hdlc_rx_start(rx);
+    return 0;
+}
+
+int hdlc_multi_rx_init(hdlc_multi_rx_t *mrx, int channels, hdlc_channel_frame_callback_t callback, void *ctx) {
+    if (channels < 1 || channels > HDLC_MAX_CHANNELS)
+        return -1;
+
+    hdlc_tables_init();
+    memset(mrx, 0, offsetof(hdlc_multi_rx_t, frame));
+    mrx->channels = channels;
+    mrx->callback = callback;
+    mrx->ctx = ctx;
+    return 0;
+}
+
+void hdlc_multi_rx_reset(hdlc_multi_rx_t *mrx, int channel) {
+    if (channel < 0 || channel >= mrx->channels)
+        return;
+
+    mrx->ones[channel] = 0;
+    mrx->inFrame[channel] = false;
+    mrx->overrun[channel] = false;
+    mrx->byte[channel] = 0;
+    mrx->bitCount[channel] = 0;
+    mrx->frameLen[channel] = 0;
+    mrx->level[channel] = 0;
+}
+
+void hdlc_multi_rx_set_nrzi(hdlc_multi_rx_t *mrx, bool enable) {
+    mrx->nrzi = enable;
+    memset(mrx->level, 0, sizeof(mrx->level));
+}
+
+int hdlc_multi_rx_push(hdlc_multi_rx_t *mrx, const unsigned char *const *data, const int *len) {
+    hdlc_multi_rx_arg_t arg = { mrx, 0 };
+
+    mrx->delivered = 0;
+    for (int ch = 0; ch < mrx->channels; ch++) {
+        if (!data[ch] || len[ch] <= 0)
+            continue;
+
+        // Work on a register copy of the channel state, written back after the block
+        hdlc_rx_state_t rx = { mrx->ones[ch], mrx->inFrame[ch], mrx->overrun[ch], mrx->byte[ch], mrx->bitCount[ch], mrx->frameLen[ch], mrx->nrzi, mrx->level[ch] };
+        arg.channel = ch;
+        hdlc_rx_run(&rx, mrx->frame[ch], HDLC_MAX_FRAME_LEN, data[ch], len[ch], hdlc_multi_rx_event, &arg);
+
+        mrx->ones[ch] = rx.ones;
+        mrx->inFrame[ch] = rx.inFrame;
+        mrx->overrun[ch] = rx.overrun;
+        mrx->byte[ch] = rx.byte;
+        mrx->bitCount[ch] = rx.bitCount;
+        mrx->frameLen[ch] = rx.frameLen;
+        mrx->level[ch] = rx.level;
+    }
+
+    return mrx->delivered;
+}
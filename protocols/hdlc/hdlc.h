@@ -44,19 +44,18 @@ unsigned char ReverseBits(unsigned char byte);
  *
  * This function transforms an AX.25 frame into an HDLC frame suitable for transmission.
  * The encoding process includes several steps:
- * - Reverses the bits of each byte in the input frame using ReverseBits() to match the LSB-first
- *   transmission order of AX.25.
- * - Calculates a 16-bit Frame Check Sequence (FCS) using the CRC function from common.h and appends
- *   it to the frame for error detection.
+ * - Sends the bits of each byte least significant bit first, as required by AX.25.
+ * - Calculates a 16-bit Frame Check Sequence (FCS) with crc_update() from common.h and sends
+ *   it after the frame for error detection.
  * - Performs bit stuffing: after five consecutive 1 bits, a 0 bit is inserted to prevent the flag
  *   sequence (0x7E) from appearing within the data.
  * - Adds the HDLC flag byte (0x7E) at the beginning and end of the frame to delimit the frame boundaries.
  *
  * The encoded frame is written to the provided encodedFrame buffer, and its length is stored in encodedLen.
- * The input frame buffer is modified in-place to include the FCS before encoding.
+ * Bit reversal and FCS are done on the fly: the input frame is never modified, so the same buffer
+ * may be encoded again for retransmission without making a copy.
  *
- * @param frame Pointer to the input AX.25 frame data. This buffer must have enough space to append
- *              two additional bytes for the FCS (frameLen + 2 bytes minimum).
+ * @param frame Pointer to the input AX.25 frame data, in normal bit order, without FCS.
  * @param frameLen Length of the input frame in bytes, excluding the FCS.
  * @param encodedFrame Pointer to the output buffer where the encoded HDLC frame will be stored.
  *                     Must be large enough to hold the encoded data, including flags and potential
@@ -64,7 +63,7 @@ unsigned char ReverseBits(unsigned char byte);
  * @param encodedLen Pointer to an integer where the length of the encoded frame will be stored,
  *                   in bytes, including the start and end flags.
  */
-void hdlc_frame_encode(unsigned char *frame, int frameLen, unsigned char *encodedFrame, int *encodedLen);
+void hdlc_frame_encode(const unsigned char *frame, int frameLen, unsigned char *encodedFrame, int *encodedLen);
 
 /**
  * @brief Decodes an HDLC frame back into an AX.25 frame.
@@ -92,4 +91,438 @@ void hdlc_frame_encode(unsigned char *frame, int frameLen, unsigned char *encode
  */
 int hdlc_frame_decode(unsigned char *encodedFrame, int encodedLen, unsigned char *decodedFrame, int *decodedLen);
 
+/**
+ * @brief Builds the lookup tables used by the table-driven HDLC encoder and decoders.
+ *
+ * The tables are built on first use by every function that needs them. Applications that
+ * decode from several threads should call this function once at startup, before any thread
+ * is started, so that the tables are never built concurrently.
+ */
+void hdlc_tables_init(void);
+
+/**
+ * @brief Decodes an HDLC frame using the table-driven bit unstuffing engine.
+ *
+ * Same contract and result as hdlc_frame_decode(), which remains the bit-serial reference
+ * implementation. Instead of testing every bit, each input byte is looked up in a state table
+ * indexed by the current run of 1 bits and the byte value; the entry gives the destuffed
+ * output bits and the new run state in one step. Only the few bytes that contain a flag or an
+ * abort sequence are processed bit by bit. Repeated opening flags are skipped.
+ *
+ * @param encodedFrame Pointer to the input HDLC frame data, including start and end flags (0x7E).
+ * @param encodedLen Length of the input HDLC frame in bytes.
+ * @param decodedFrame Pointer to the output buffer where the decoded AX.25 frame will be stored.
+ *                     Must be at least encodedLen bytes long.
+ * @param decodedLen Pointer to an integer where the length of the decoded frame will be stored,
+ *                   in bytes, excluding the FCS.
+ * @return 0 on successful decoding, -1 on failure (e.g., missing flags, abort, FCS mismatch, or frame too short).
+ */
+int hdlc_frame_decode_fast(const unsigned char *encodedFrame, int encodedLen, unsigned char *decodedFrame, int *decodedLen);
+
+/**
+ * @brief Encodes an AX.25 frame into an HDLC frame using table-driven bit stuffing.
+ *
+ * Produces exactly the same output as hdlc_frame_encode(). The FCS is computed with the
+ * slicing-by-8 crc_update() kernel, then every byte is looked up in a stuffing table indexed by
+ * the current run of 1 bits and the byte value, which yields the bit-reversed, stuffed output
+ * bits and the new run state. Output bits are collected in a 64-bit accumulator and written 32 bits at a time.
+ *
+ * @param frame Pointer to the input AX.25 frame data, in normal bit order, without FCS.
+ * @param frameLen Length of the input frame in bytes.
+ * @param encodedFrame Pointer to the output buffer where the encoded HDLC frame will be stored.
+ *                     Must be large enough to hold the encoded data, including flags and potential
+ *                     bit stuffing (at most (frameLen + 2) * 6 / 5 + 4 bytes).
+ * @param encodedLen Pointer to an integer where the length of the encoded frame will be stored,
+ *                   in bytes, including the start and end flags.
+ */
+void hdlc_frame_encode_fast(const unsigned char *frame, int frameLen, unsigned char *encodedFrame, int *encodedLen);
+
+/**
+ * @brief NRZI encodes a bitstream.
+ *
+ * Uses the AX.25 convention: a 0 bit is sent as a change of line level and a 1 bit as no
+ * change. Bits are taken most significant bit first, as in hdlc_frame_encode() output, and
+ * each output bit is the line level after the corresponding input bit. The conversion runs
+ * eight bits at a time, so a stream may be encoded in chunks of any size.
+ *
+ * @param in Pointer to the bitstream to encode.
+ * @param out Pointer to the output buffer, at least len bytes long. May be the same as in.
+ * @param len Number of bytes to encode.
+ * @param level Pointer to the current line level (0 or 1), updated with the level after the
+ *              last bit. Initialize it to 0 at the start of a transmission.
+ */
+void hdlc_nrzi_encode(const unsigned char *in, unsigned char *out, int len, uint8_t *level);
+
+/**
+ * @brief Decodes an NRZI coded bitstream.
+ *
+ * Reverses hdlc_nrzi_encode(): an output bit is 1 when the line level did not change.
+ *
+ * @param in Pointer to the NRZI coded bitstream.
+ * @param out Pointer to the output buffer, at least len bytes long. May be the same as in.
+ * @param len Number of bytes to decode.
+ * @param level Pointer to the line level before the first bit, updated with the level of the
+ *              last bit.
+ */
+void hdlc_nrzi_decode(const unsigned char *in, unsigned char *out, int len, uint8_t *level);
+
+/**
+ * @brief Encodes an AX.25 frame into an NRZI coded HDLC frame.
+ *
+ * Same output as hdlc_frame_encode_fast() followed by hdlc_nrzi_encode(), in a single pass:
+ * the NRZI conversion is applied to each 32-bit word of the stuffed bitstream as it is
+ * flushed, so no intermediate buffer is needed. Frames encoded one after the other with the
+ * same level variable form a continuous transmission.
+ *
+ * @param frame Pointer to the input AX.25 frame data, in normal bit order, without FCS.
+ * @param frameLen Length of the input frame in bytes.
+ * @param encodedFrame Pointer to the output buffer, sized as for hdlc_frame_encode_fast().
+ * @param encodedLen Pointer to an integer where the length of the encoded frame will be stored.
+ * @param level Pointer to the current line level (0 or 1), updated with the level after the
+ *              last bit.
+ */
+void hdlc_frame_encode_nrzi(const unsigned char *frame, int frameLen, unsigned char *encodedFrame, int *encodedLen, uint8_t *level);
+
+/**
+ * @brief Decodes an NRZI coded HDLC frame.
+ *
+ * Same contract as hdlc_frame_decode_fast(), with the NRZI decoding done byte by byte inside
+ * the table-driven engine.
+ *
+ * @param encodedFrame Pointer to the NRZI coded HDLC frame, including start and end flags.
+ * @param encodedLen Length of the input in bytes.
+ * @param decodedFrame Pointer to the output buffer, at least encodedLen bytes long.
+ * @param decodedLen Pointer to an integer where the length of the decoded frame will be stored,
+ *                   in bytes, excluding the FCS.
+ * @param level Line level before the first bit of encodedFrame.
+ * @return 0 on successful decoding, -1 on failure.
+ */
+int hdlc_frame_decode_nrzi(const unsigned char *encodedFrame, int encodedLen, unsigned char *decodedFrame, int *decodedLen, uint8_t level);
+
+/**
+ * @brief Describes one frame of a batch.
+ */
+typedef struct {
+    const unsigned char *frame; ///< AX.25 frame, in normal bit order, without FCS
+    int len;                    ///< Length of the frame in bytes
+} hdlc_frame_desc_t;
+
+/**
+ * @brief Encodes several AX.25 frames into one continuous HDLC bitstream.
+ *
+ * Frames are sent back to back, each closing flag also opening the next frame, as allowed by
+ * AX.25: a burst of n frames costs n + 1 flags instead of 2n, and no padding is inserted
+ * between frames. Each frame is encoded as by hdlc_frame_encode_fast(); only the end of the
+ * bitstream is padded with zeros to a whole byte.
+ *
+ * @param frames Array of frame descriptors.
+ * @param count Number of frames.
+ * @param encoded Pointer to the output buffer. Must hold the encoded frames: 1.2 times each
+ *                frame length plus 4 bytes per frame, plus 2 bytes.
+ * @param encodedLen Pointer to an integer where the length of the bitstream will be stored, in bytes.
+ * @param level Pointer to the NRZI line level, as for hdlc_frame_encode_nrzi(), or NULL for a
+ *              plain bitstream.
+ */
+void hdlc_frame_encode_batch(const hdlc_frame_desc_t *frames, int count, unsigned char *encoded, int *encodedLen, uint8_t *level);
+
+/**
+ * @brief Decodes every HDLC frame of a bitstream in one pass.
+ *
+ * Flags may be shared between frames or repeated, and frames may start at any bit offset.
+ * Frames with a bad FCS or an abort, runts shorter than HDLC_MIN_FRAME_LEN and frames longer
+ * than HDLC_MAX_FRAME_LEN are skipped. The valid frames are stored one after the other in
+ * decoded, in normal bit order and without FCS, and described by the frames array.
+ * Decoding stops when either the output buffer or the descriptor array is full.
+ *
+ * @param encoded Pointer to the bitstream, most significant bit first.
+ * @param encodedLen Length of the bitstream in bytes.
+ * @param decoded Pointer to the output buffer for the frame bytes.
+ * @param decodedSize Size of the output buffer in bytes.
+ * @param frames Array receiving a descriptor for each frame, pointing into decoded.
+ * @param maxFrames Size of the descriptor array.
+ * @param level Pointer to the NRZI line level before the bitstream, updated to the last line
+ *              level, or NULL for a plain bitstream.
+ * @return Number of frames decoded.
+ */
+int hdlc_frame_decode_batch(const unsigned char *encoded, int encodedLen, unsigned char *decoded, int decodedSize, hdlc_frame_desc_t *frames,
+        int maxFrames, uint8_t *level);
+
+/**
+ * @defgroup HdlcRecoverLimits FCS Recovery Limits
+ * @{
+ */
+#ifndef HDLC_RECOVER_MAX_CANDIDATES
+#define HDLC_RECOVER_MAX_CANDIDATES 32 ///< Least confident bits searched for arbitrary pairs of errors
+#endif
+/** @} */
+
+/**
+ * @brief Options of hdlc_frame_decode_recover().
+ */
+typedef struct {
+    int maxFlips;              ///< 1: single bit errors; 2: also two adjacent bits and any two candidate bits
+    const uint8_t *confidence; ///< Optional demodulator confidence of every encoded bit, most significant bit of
+                               ///< the first byte first, higher is surer. NULL when not available.
+    int candidates;            ///< Least confident bits paired with each other, at most HDLC_RECOVER_MAX_CANDIDATES
+} hdlc_recover_t;
+
+/**
+ * @brief Decodes an HDLC frame, repairing a failed FCS by flipping one or two bits.
+ *
+ * A frame that passes the FCS check is returned as with hdlc_frame_decode(). Otherwise every
+ * single bit of the destuffed frame is tried, then every pair of adjacent bits (the trace of
+ * one NRZI level error), then every pair among the least confident bits when a confidence is
+ * supplied. Candidates are checked against the CRC error syndrome, updated one register step
+ * per bit, so the cost is a few operations per frame bit plus candidates^2 / 2 comparisons,
+ * without ever recomputing the CRC.
+ *
+ * Each correction spends part of the 16-bit FCS protection: roughly one noise frame in
+ * 65536 / (2 * frame bits) passes as a valid frame with two flips allowed, so the result
+ * should be checked further (addresses, expected sequence numbers) before it is trusted. Errors
+ * that change the bit stuffing or the flags are not covered.
+ *
+ * @param encodedFrame Pointer to the input HDLC frame data, including start and end flags (0x7E).
+ * @param encodedLen Length of the input HDLC frame in bytes.
+ * @param decodedFrame Pointer to the output buffer, at least encodedLen bytes long.
+ * @param decodedLen Pointer to an integer where the length of the decoded frame will be stored,
+ *                   in bytes, excluding the FCS.
+ * @param recover Pointer to the recovery options, or NULL to repair single bit errors only.
+ * @return Number of bits flipped (0 if the frame was intact), or -1 if the frame could not be decoded.
+ */
+int hdlc_frame_decode_recover(const unsigned char *encodedFrame, int encodedLen, unsigned char *decodedFrame, int *decodedLen,
+        const hdlc_recover_t *recover);
+
+/**
+ * @brief Finds the next byte of a bitstream where a flag or an abort sequence may start.
+ *
+ * A flag (0x7E) or an abort contains six consecutive 1 bits, which bit stuffing never allows
+ * inside a frame. The scanner looks for such a run at any bit offset, including runs that
+ * straddle two bytes, using AVX2 or SSE2 when the CPU supports them and a scalar loop
+ * otherwise. Bits are taken most significant bit first, as in hdlc_frame_encode() output.
+ *
+ * The receive loops use it to skip noise between frames, and skip repeated flag fill bytes,
+ * so that only the bytes around flags go through the bit-exact unstuffer.
+ *
+ * @param data Pointer to the bitstream.
+ * @param len Length of the bitstream in bytes.
+ * @param start Index of the first byte to examine.
+ * @return Index of the first byte at or after start in which a run of six 1 bits begins,
+ *         or len if there is none.
+ */
+int hdlc_scan_flags(const unsigned char *data, int len, int start);
+
+/**
+ * @defgroup HdlcDeframerLimits Streaming Deframer Limits
+ * @{
+ * Size limits applied by the streaming deframer. Both may be overridden at compile time.
+ */
+#ifndef HDLC_MAX_FRAME_LEN
+#define HDLC_MAX_FRAME_LEN 2048 ///< Largest frame collected by the deframer, in bytes, including the FCS
+#endif
+#ifndef HDLC_MIN_FRAME_LEN
+#define HDLC_MIN_FRAME_LEN 15   ///< Smallest frame delivered, in bytes, excluding the FCS (two addresses + control)
+#endif
+#ifndef HDLC_MAX_CHANNELS
+#define HDLC_MAX_CHANNELS 16    ///< Number of channels of a multi-channel receive engine
+#endif
+/** @} */
+
+/**
+ * @brief Callback invoked by the deframer for every frame that passes the FCS check.
+ *
+ * @param frame Pointer to the decoded AX.25 frame, in normal bit order and without the FCS.
+ *              The buffer belongs to the deframer and is only valid during the call.
+ * @param frameLen Length of the decoded frame in bytes.
+ * @param ctx User context pointer given to hdlc_deframer_init().
+ */
+typedef void (*hdlc_frame_callback_t)(const unsigned char *frame, int frameLen, void *ctx);
+
+/**
+ * @brief Bit-level receive state shared by the HDLC decoders.
+ *
+ * Holds everything needed to resume decoding at an arbitrary bit position: the run of
+ * consecutive 1 bits (used for destuffing, flag and abort detection), the partially
+ * assembled byte and the number of bytes collected for the current frame. The frame bytes
+ * themselves live in a buffer owned by the caller of the decoder.
+ */
+typedef struct {
+    uint8_t ones;          ///< Consecutive 1 bits seen (7 means aborted / idle)
+    bool inFrame;          ///< True once an opening flag has been seen
+    bool overrun;          ///< Current frame exceeded the frame buffer
+    unsigned char byte;    ///< Partially assembled byte
+    int bitCount;          ///< Number of bits in the partial byte
+    int frameLen;          ///< Number of complete bytes collected
+    bool nrzi;             ///< Input is NRZI coded
+    uint8_t level;         ///< Line level of the last NRZI coded bit received
+} hdlc_rx_state_t;
+
+/**
+ * @brief State of a streaming HDLC deframer.
+ *
+ * Combines the bit-level receive state with a frame buffer, so a continuous bitstream may
+ * be pushed in chunks of any size. Every frame found between two flags is delivered through
+ * the callback once its FCS has been verified.
+ *
+ * The structure must be initialized with hdlc_deframer_init() before use and requires no
+ * dynamic memory.
+ */
+typedef struct {
+    hdlc_rx_state_t rx;                        ///< Bit-level receive state
+    unsigned char frame[HDLC_MAX_FRAME_LEN];   ///< Frame collected so far (including FCS)
+    hdlc_frame_callback_t callback;            ///< Frame delivery callback
+    void *ctx;                                 ///< User context passed to the callback
+    int delivered;                             ///< Frames delivered during the current push
+    uint32_t frames;                           ///< Frames delivered
+    uint32_t fcsErrors;                        ///< Frames discarded because of an FCS mismatch or bad length
+    uint32_t aborts;                           ///< Abort sequences (seven or more 1 bits) seen inside a frame
+    uint8_t recoverFlips;                      ///< Bits flipped to repair an FCS mismatch, 0 to drop the frame
+    uint32_t recovered;                        ///< Frames delivered after an FCS repair (also counted in frames)
+} hdlc_deframer_t;
+
+/**
+ * @brief Initializes a streaming HDLC deframer.
+ *
+ * Clears all decoding state and statistics and registers the frame callback.
+ *
+ * @param deframer Pointer to the deframer to initialize.
+ * @param callback Function called for each valid frame found in the bitstream.
+ * @param ctx User context pointer passed unchanged to the callback.
+ */
+void hdlc_deframer_init(hdlc_deframer_t *deframer, hdlc_frame_callback_t callback, void *ctx);
+
+/**
+ * @brief Resets the decoding state of a streaming HDLC deframer.
+ *
+ * Drops any partially received frame and waits for the next flag. The callback, the
+ * NRZI setting and the statistics counters are preserved. Useful after a carrier loss or a demodulator resync.
+ *
+ * @param deframer Pointer to the deframer to reset.
+ */
+void hdlc_deframer_reset(hdlc_deframer_t *deframer);
+
+/**
+ * @brief Pushes a chunk of the received bitstream into the deframer.
+ *
+ * Bits are consumed most significant bit first, the same packing produced by
+ * hdlc_frame_encode(). The chunk may start and end at any point of the bitstream: flags,
+ * stuffed bits and frames may straddle chunk boundaries. For every frame between two flags
+ * the FCS is verified and, on success, the callback is invoked with the frame in normal
+ * AX.25 bit order, ready for ax25_frame_decode(). Frames with a bad FCS, an abort sequence,
+ * a length that is not a whole number of bytes or a length outside
+ * [HDLC_MIN_FRAME_LEN, HDLC_MAX_FRAME_LEN] are silently discarded.
+ *
+ * @param deframer Pointer to an initialized deframer.
+ * @param data Pointer to the received bytes.
+ * @param len Number of bytes in data.
+ * @return Number of frames delivered through the callback during this call.
+ */
+int hdlc_deframer_push(hdlc_deframer_t *deframer, const unsigned char *data, int len);
+
+/**
+ * @brief Selects whether the bitstream pushed into the deframer is NRZI coded.
+ *
+ * When enabled, hdlc_deframer_push() takes the raw line levels from the demodulator and
+ * decodes them on the fly, keeping the last level across calls. Disabled by default.
+ *
+ * @param deframer Pointer to an initialized deframer.
+ * @param enable True for NRZI coded input, false for a plain bitstream.
+ */
+void hdlc_deframer_set_nrzi(hdlc_deframer_t *deframer, bool enable);
+
+/**
+ * @brief Enables FCS repair in the deframer.
+ *
+ * Frames failing the FCS check go through the same search as hdlc_frame_decode_recover(),
+ * without demodulator confidence: single bits, and adjacent pairs when maxFlips is 2.
+ * Disabled (0) by default.
+ *
+ * @param deframer Pointer to an initialized deframer.
+ * @param maxFlips 0 to drop frames with a bad FCS, 1 or 2 to repair them.
+ */
+void hdlc_deframer_set_recover(hdlc_deframer_t *deframer, int maxFlips);
+
+/**
+ * @brief Callback invoked by the multi-channel receive engine for every valid frame.
+ *
+ * @param channel Channel on which the frame was received, from 0 to channels - 1.
+ * @param frame Pointer to the decoded AX.25 frame, in normal bit order and without the FCS.
+ *              The buffer belongs to the engine and is only valid during the call.
+ * @param frameLen Length of the decoded frame in bytes.
+ * @param ctx User context pointer given to hdlc_multi_rx_init().
+ */
+typedef void (*hdlc_channel_frame_callback_t)(int channel, const unsigned char *frame, int frameLen, void *ctx);
+
+/**
+ * @brief State of a multi-channel HDLC receive engine.
+ *
+ * Runs one streaming deframer per channel, with the bit-level state of all channels kept in
+ * small parallel arrays (structure of arrays) so that the state of every port fits in a few
+ * cache lines next to the shared decoding tables. Each channel has its own frame buffer and
+ * statistics. The structure must be initialized with hdlc_multi_rx_init() and requires no
+ * dynamic memory.
+ */
+typedef struct {
+    int channels;                                             ///< Number of channels in use
+    hdlc_channel_frame_callback_t callback;                   ///< Frame delivery callback
+    void *ctx;                                                ///< User context passed to the callback
+    int delivered;                                            ///< Frames delivered during the current push
+    bool nrzi;                                                ///< Input of every channel is NRZI coded
+    uint8_t ones[HDLC_MAX_CHANNELS];                          ///< Consecutive 1 bits seen, per channel
+    bool inFrame[HDLC_MAX_CHANNELS];                          ///< Opening flag seen, per channel
+    bool overrun[HDLC_MAX_CHANNELS];                          ///< Frame buffer overrun, per channel
+    uint8_t byte[HDLC_MAX_CHANNELS];                          ///< Partially assembled byte, per channel
+    uint8_t bitCount[HDLC_MAX_CHANNELS];                      ///< Bits in the partial byte, per channel
+    uint16_t frameLen[HDLC_MAX_CHANNELS];                     ///< Complete bytes collected, per channel
+    uint8_t level[HDLC_MAX_CHANNELS];                         ///< Last NRZI line level, per channel
+    uint32_t frames[HDLC_MAX_CHANNELS];                       ///< Frames delivered, per channel
+    uint32_t fcsErrors[HDLC_MAX_CHANNELS];                    ///< Frames discarded (FCS or length), per channel
+    uint32_t aborts[HDLC_MAX_CHANNELS];                       ///< Abort sequences inside a frame, per channel
+    unsigned char frame[HDLC_MAX_CHANNELS][HDLC_MAX_FRAME_LEN]; ///< Frame collected so far, per channel
+} hdlc_multi_rx_t;
+
+/**
+ * @brief Initializes a multi-channel HDLC receive engine.
+ *
+ * @param mrx Pointer to the engine to initialize.
+ * @param channels Number of channels, from 1 to HDLC_MAX_CHANNELS.
+ * @param callback Function called for each valid frame, tagged with its channel.
+ * @param ctx User context pointer passed unchanged to the callback.
+ * @return 0 on success, -1 if channels is out of range.
+ */
+int hdlc_multi_rx_init(hdlc_multi_rx_t *mrx, int channels, hdlc_channel_frame_callback_t callback, void *ctx);
+
+/**
+ * @brief Drops any partially received frame on one channel.
+ *
+ * Statistics are preserved, as with hdlc_deframer_reset().
+ *
+ * @param mrx Pointer to an initialized engine.
+ * @param channel Channel to reset.
+ */
+void hdlc_multi_rx_reset(hdlc_multi_rx_t *mrx, int channel);
+
+/**
+ * @brief Pushes one block of received bitstream for every channel.
+ *
+ * Channels are processed one after the other, each block with the same table-driven engine
+ * and the same rules as hdlc_deframer_push(). Frames may straddle blocks.
+ *
+ * @param mrx Pointer to an initialized engine.
+ * @param data Array of mrx->channels pointers to the received bytes of each channel.
+ *             A NULL pointer skips the channel.
+ * @param len Array of mrx->channels block lengths in bytes.
+ * @return Number of frames delivered through the callback during this call, over all channels.
+ */
+int hdlc_multi_rx_push(hdlc_multi_rx_t *mrx, const unsigned char *const *data, const int *len);
+
+/**
+ * @brief Selects whether the bitstreams of all channels are NRZI coded.
+ *
+ * Same as hdlc_deframer_set_nrzi(), for every channel of the engine.
+ *
+ * @param mrx Pointer to an initialized engine.
+ * @param enable True for NRZI coded input, false for plain bitstreams.
+ */
+void hdlc_multi_rx_set_nrzi(hdlc_multi_rx_t *mrx, bool enable);
+
 #endif /* HDLC_H_ */
@@ -0,0 +1,392 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "common.h"
+#include "il2p.h"
+
+#define IL2P_TX_LFSR_INIT 0x00F
+#define IL2P_RX_LFSR_INIT 0x1F0
+
+// Reed-Solomon codes with 2, 4, 6, 8 and 16 check bytes, first generator root alpha^0
+static rs_code_t il2p_rs_codes[5];
+static bool il2p_tables_ready = false;
+
+static void il2p_tables_init(void) {
+    if (il2p_tables_ready)
+        return;
+
+    for (int i = 0; i < 4; i++) {
+        rs_init(&il2p_rs_codes[i], 0, 2 * (i + 1));
+    }
+    rs_init(&il2p_rs_codes[4], 0, 16);
+
+    il2p_tables_ready = true;
+}
+
+static const rs_code_t* il2p_rs(int nroots) {
+    return (nroots == 16) ? &il2p_rs_codes[4] : &il2p_rs_codes[nroots / 2 - 1];
+}
+
+static inline int il2p_scramble_bit(int in, int *state) {
+    int out = ((*state >> 4) ^ *state) & 0x01;
+    *state = ((((in ^ *state) & 0x01) << 9) | (*state ^ ((*state & 0x01) << 4))) >> 1;
+    return out;
+}
+
+void il2p_scramble(const unsigned char *in, unsigned char *out, int len) {
+    int state = IL2P_TX_LFSR_INIT;
+    int skip = 5;
+    int ob = 0;
+    unsigned char om = 0x80;
+
+    memset(out, 0, len);
+
+    // The first five output bits only hold the initial register state
+    for (int ib = 0; ib < len; ib++) {
+        for (unsigned char im = 0x80; im != 0; im >>= 1) {
+            int s = il2p_scramble_bit((in[ib] & im) != 0, &state);
+            if (skip > 0) {
+                skip--;
+                continue;
+            }
+            if (s)
+                out[ob] |= om;
+            om >>= 1;
+            if (om == 0) {
+                om = 0x80;
+                ob++;
+            }
+        }
+    }
+
+    // Flush the last five bits out of the register
+    for (int n = 0; n < 5 && ob < len; n++) {
+        if (il2p_scramble_bit(0, &state))
+            out[ob] |= om;
+        om >>= 1;
+        if (om == 0) {
+            om = 0x80;
+            ob++;
+        }
+    }
+}
+
+void il2p_descramble(const unsigned char *in, unsigned char *out, int len) {
+    int state = IL2P_RX_LFSR_INIT;
+
+    for (int b = 0; b < len; b++) {
+        unsigned char byte = 0;
+        for (unsigned char m = 0x80; m != 0; m >>= 1) {
+            int bit = (in[b] & m) != 0;
+            if ((bit ^ state) & 0x01)
+                byte |= m;
+            state = ((state >> 1) | (bit << 8)) ^ (bit << 3);
+        }
+        out[b] = byte;
+    }
+}
+
+typedef struct {
+    int count;      // Number of payload blocks
+    int smallSize;  // Size of the small blocks, large ones are one byte longer
+    int largeCount; // Number of large blocks, sent first
+    int parity;     // Check bytes per block
+} il2p_blocks_t;
+
+static void il2p_payload_blocks(int payloadLen, bool maxFec, il2p_blocks_t *blocks) {
+    memset(blocks, 0, sizeof(il2p_blocks_t));
+    if (payloadLen == 0)
+        return;
+
+    int maxBlock = maxFec ? 239 : 247;
+    blocks->count = (payloadLen + maxBlock - 1) / maxBlock;
+    blocks->smallSize = payloadLen / blocks->count;
+    blocks->largeCount = payloadLen - blocks->count * blocks->smallSize;
+    // Baseline FEC steps through 2, 4, 6 and 8 check bytes at small block sizes 61, 123 and 185
+    blocks->parity = maxFec ? 16 : 2 * (blocks->smallSize / 62 + 1);
+}
+
+// AX.25 PID to IL2P PID subfield, or -1 if the PID has no translation
+static int il2p_pid_encode(uint8_t pid) {
+    switch (pid) {
+        case 0x20:
+            return 0x2;
+        case 0x01:
+            return 0x3;
+        case 0x06:
+            return 0x4;
+        case 0x07:
+            return 0x5;
+        case 0x08:
+            return 0x6;
+        case 0xCC:
+            return 0xB;
+        case 0xCD:
+            return 0xC;
+        case 0xCE:
+            return 0xD;
+        case 0xCF:
+            return 0xE;
+        case 0xF0:
+            return 0xF;
+        default:
+            return -1;
+    }
+}
+
+static int il2p_pid_decode(int pid) {
+    static const int16_t table[16] = { -1, -1, 0x20, 0x01, 0x06, 0x07, 0x08, -1, -1, -1, -1, 0xCC, 0xCD, 0xCE, 0xCF, 0xF0 };
+    return table[pid & 0x0F];
+}
+
+// U frame control bytes (P/F bit cleared) in IL2P opcode order
+static const uint8_t il2p_u_controls[8] = { 0x2F, 0x43, 0x0F, 0x63, 0x87, 0x03, 0xAF, 0xE3 };
+
+// Spreads the bits of a subfield over bit 6 or bit 7 of consecutive header bytes, first byte
+// holding the most significant bit
+static void il2p_header_put(unsigned char *header, int first, int count, int bit, unsigned int value) {
+    for (int i = 0; i < count; i++) {
+        if ((value >> (count - 1 - i)) & 0x01)
+            header[first + i] |= 1 << bit;
+    }
+}
+
+static unsigned int il2p_header_get(const unsigned char *header, int first, int count, int bit) {
+    unsigned int value = 0;
+    for (int i = 0; i < count; i++) {
+        value = (value << 1) | ((header[first + i] >> bit) & 0x01);
+    }
+    return value;
+}
+
+// Builds a type 1 header for the frame. Returns the offset of the payload in the frame, or -1
+// if the frame cannot be translated.
+static int il2p_header_translate(const unsigned char *frame, int frameLen, int options, unsigned char *header) {
+    if (frameLen < 15 || !(frame[13] & 0x01))
+        return -1;
+
+    memset(header, 0, IL2P_HEADER_LEN);
+    for (int i = 0; i < 12; i++) {
+        // Skip the SSID byte of the destination
+        unsigned char c = frame[i < 6 ? i : i + 1];
+        if ((c & 0x01) || (c >> 1) < 0x20 || (c >> 1) > 0x5F)
+            return -1;
+        header[i] = (c >> 1) - 0x20;
+    }
+    header[12] = (((frame[6] >> 1) & 0x0F) << 4) | ((frame[13] >> 1) & 0x0F);
+
+    unsigned int cmd = (frame[6] >> 7) & 0x01;
+    uint8_t control = frame[14];
+    unsigned int pf = (control >> 4) & 0x01;
+    int pid;
+    unsigned int ctrl;
+    bool ui = false;
+    int payload = 15;
+
+    if ((control & 0x01) == 0) {
+        // I frame, always a command, with a PID
+        if ((options & IL2P_OPT_MODULO128) || frameLen < 16 || !cmd)
+            return -1;
+        pid = il2p_pid_encode(frame[15]);
+        ctrl = (pf << 6) | ((control >> 5) << 3) | ((control >> 1) & 0x07);
+        payload = 16;
+    } else if ((control & 0x03) == 0x01) {
+        if ((options & IL2P_OPT_MODULO128) || frameLen != 15)
+            return -1;
+        pid = 0x0;
+        ctrl = (pf << 6) | ((control >> 5) << 3) | (cmd << 2) | ((control >> 2) & 0x03);
+    } else {
+        int opcode = -1;
+        for (int i = 0; i < 8; i++) {
+            if (il2p_u_controls[i] == (control & ~0x10))
+                opcode = i;
+        }
+        if (opcode < 0)
+            return -1;
+        if (opcode == 5) {
+            if (frameLen < 16)
+                return -1;
+            ui = true;
+            pid = il2p_pid_encode(frame[15]);
+            payload = 16;
+        } else {
+            pid = 0x1;
+        }
+        ctrl = (pf << 6) | (opcode << 3) | (cmd << 2);
+    }
+    if (pid < 0)
+        return -1;
+
+    il2p_header_put(header, 0, 1, 6, ui);
+    il2p_header_put(header, 1, 4, 6, pid);
+    il2p_header_put(header, 5, 7, 6, ctrl);
+    return payload;
+}
+
+// Rebuilds the AX.25 header of a type 1 packet. Returns its length, or -1 if the header is invalid.
+static int il2p_header_restore(const unsigned char *header, unsigned char *frame) {
+    bool ui = il2p_header_get(header, 0, 1, 6);
+    int pid = il2p_header_get(header, 1, 4, 6);
+    unsigned int ctrl = il2p_header_get(header, 5, 7, 6);
+    unsigned int pf = (ctrl >> 6) & 0x01;
+    unsigned int cmd;
+    int len = 15;
+
+    if (pid == 0x0) {
+        cmd = (ctrl >> 2) & 0x01;
+        frame[14] = (((ctrl >> 3) & 0x07) << 5) | (pf << 4) | ((ctrl & 0x03) << 2) | 0x01;
+    } else if (pid == 0x1 || ui) {
+        cmd = (ctrl >> 2) & 0x01;
+        frame[14] = il2p_u_controls[(ctrl >> 3) & 0x07] | (pf << 4);
+        if (ui) {
+            if (il2p_pid_decode(pid) < 0 || (frame[14] & ~0x10) != 0x03)
+                return -1;
+            frame[len++] = il2p_pid_decode(pid);
+        }
+    } else {
+        if (il2p_pid_decode(pid) < 0)
+            return -1;
+        cmd = 1;
+        frame[14] = (((ctrl >> 3) & 0x07) << 5) | (pf << 4) | ((ctrl & 0x07) << 1);
+        frame[len++] = il2p_pid_decode(pid);
+    }
+
+    for (int i = 0; i < 12; i++) {
+        frame[i < 6 ? i : i + 1] = ((header[i] & 0x3F) + 0x20) << 1;
+    }
+    frame[6] = (cmd << 7) | 0x60 | ((header[12] >> 4) << 1);
+    frame[13] = (!cmd << 7) | 0x60 | ((header[12] & 0x0F) << 1) | 0x01;
+    return len;
+}
+
+int il2p_frame_encode(const unsigned char *frame, int frameLen, unsigned char *encoded, int *encodedLen, int options) {
+    unsigned char header[IL2P_HEADER_LEN];
+    bool maxFec = (options & IL2P_OPT_MAX_FEC) != 0;
+
+    il2p_tables_init();
+
+    int payload = il2p_header_translate(frame, frameLen, options, header);
+    if (payload < 0) {
+        // Type 0: the whole frame is the payload
+        memset(header, 0, sizeof(header));
+        payload = 0;
+    } else {
+        header[1] |= 0x80;
+    }
+    int payloadLen = frameLen - payload;
+    if (frameLen < 1 || payloadLen > IL2P_MAX_PAYLOAD)
+        return -1;
+
+    il2p_header_put(header, 0, 1, 7, maxFec);
+    il2p_header_put(header, 2, 10, 7, payloadLen);
+
+    int pos = 0;
+    encoded[pos++] = (IL2P_SYNC_WORD >> 16) & 0xFF;
+    encoded[pos++] = (IL2P_SYNC_WORD >> 8) & 0xFF;
+    encoded[pos++] = IL2P_SYNC_WORD & 0xFF;
+
+    il2p_scramble(header, encoded + pos, IL2P_HEADER_LEN);
+    rs_encode(il2p_rs(IL2P_HEADER_PARITY), encoded + pos, IL2P_HEADER_LEN, encoded + pos + IL2P_HEADER_LEN);
+    pos += IL2P_HEADER_LEN + IL2P_HEADER_PARITY;
+
+    il2p_blocks_t blocks;
+    il2p_payload_blocks(payloadLen, maxFec, &blocks);
+    const unsigned char *src = frame + payload;
+    for (int b = 0; b < blocks.count; b++) {
+        int size = blocks.smallSize + (b < blocks.largeCount);
+        il2p_scramble(src, encoded + pos, size);
+        rs_encode(il2p_rs(blocks.parity), encoded + pos, size, encoded + pos + size);
+        src += size;
+        pos += size + blocks.parity;
+    }
+
+    *encodedLen = pos;
+    return 0;
+}
+
+// Copies n bytes starting at an arbitrary bit position of the input
+static bool il2p_read(const unsigned char *data, int len, long bitPos, unsigned char *out, int n) {
+    long byte = bitPos / 8;
+    int shift = bitPos % 8;
+
+    if (byte + n + (shift ? 1 : 0) > len)
+        return false;
+    for (int i = 0; i < n; i++) {
+        out[i] = shift ? (unsigned char) ((data[byte + i] << shift) | (data[byte + i + 1] >> (8 - shift))) : data[byte + i];
+    }
+    return true;
+}
+
+int il2p_frame_decode(const unsigned char *encoded, int encodedLen, unsigned char *decoded, int *decodedLen) {
+    unsigned char block[255];
+    unsigned char header[IL2P_HEADER_LEN];
+    uint32_t window = 0;
+
+    il2p_tables_init();
+
+    for (long bit = 0; bit < (long) encodedLen * 8; bit++) {
+        window = ((window << 1) | ((encoded[bit / 8] >> (7 - bit % 8)) & 0x01)) & 0xFFFFFF;
+        if (bit < 23 || __builtin_popcount(window ^ IL2P_SYNC_WORD) > 1)
+            continue;
+
+        long pos = bit + 1;
+        if (!il2p_read(encoded, encodedLen, pos, block, IL2P_HEADER_LEN + IL2P_HEADER_PARITY))
+            return -1;
+        int corrected = rs_decode(il2p_rs(IL2P_HEADER_PARITY), block, IL2P_HEADER_LEN + IL2P_HEADER_PARITY);
+        if (corrected < 0)
+            continue;
+        il2p_descramble(block, header, IL2P_HEADER_LEN);
+        pos += 8 * (IL2P_HEADER_LEN + IL2P_HEADER_PARITY);
+
+        int len = 0;
+        if (header[1] & 0x80) {
+            len = il2p_header_restore(header, decoded);
+            if (len < 0)
+                continue;
+        }
+
+        il2p_blocks_t blocks;
+        il2p_payload_blocks(il2p_header_get(header, 2, 10, 7), il2p_header_get(header, 0, 1, 7), &blocks);
+        for (int b = 0; b < blocks.count; b++) {
+            int size = blocks.smallSize + (b < blocks.largeCount);
+            if (!il2p_read(encoded, encodedLen, pos, block, size + blocks.parity))
+                return -1;
+            int fixed = rs_decode(il2p_rs(blocks.parity), block, size + blocks.parity);
+            if (fixed < 0)
+                return -1;
+            corrected += fixed;
+            il2p_descramble(block, decoded + len, size);
+            len += size;
+            pos += 8 * (size + blocks.parity);
+        }
+
+        *decodedLen = len;
+        return corrected;
+    }
+
+    return -1;
+}
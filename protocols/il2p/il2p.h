@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef IL2P_H_
+#define IL2P_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @defgroup Il2pLimits IL2P Limits
+ * @{
+ */
+#define IL2P_SYNC_WORD        0xF15E48 ///< Sync word sent before every packet, most significant bit first
+#define IL2P_SYNC_LEN         3        ///< Length of the sync word, in bytes
+#define IL2P_HEADER_LEN       13       ///< Control and addressing field, in bytes
+#define IL2P_HEADER_PARITY    2        ///< Reed-Solomon check bytes of the header
+#define IL2P_MAX_PAYLOAD      1023     ///< Largest payload byte count
+#define IL2P_MAX_ENCODED_LEN  (IL2P_SYNC_LEN + IL2P_HEADER_LEN + IL2P_HEADER_PARITY + IL2P_MAX_PAYLOAD + 5 * 16) ///< Largest output of il2p_frame_encode()
+#define IL2P_MAX_FRAME_LEN    (16 + IL2P_MAX_PAYLOAD) ///< Largest AX.25 frame produced by il2p_frame_decode()
+/** @} */
+
+/**
+ * @defgroup Il2pOptions IL2P Encoding Options
+ * @{
+ */
+#define IL2P_OPT_MAX_FEC      0x01 ///< Sixteen check bytes per payload block instead of two to eight
+#define IL2P_OPT_MODULO128    0x02 ///< I and S frames use two-byte (modulo 128) control fields
+/** @} */
+
+/**
+ * @brief Scrambles a block with the IL2P packet-synchronous LFSR.
+ *
+ * Galois configuration of x^9 + x^4 + 1, reset to its initial state for every block. The
+ * output is taken after the five bit delay of the register and the register is flushed at
+ * the end, so the output has the same length as the input.
+ *
+ * @param in Pointer to the bytes to scramble.
+ * @param out Pointer to the output buffer, len bytes long. Must not overlap in.
+ * @param len Number of bytes.
+ */
+void il2p_scramble(const unsigned char *in, unsigned char *out, int len);
+
+/**
+ * @brief Reverses il2p_scramble().
+ *
+ * @param in Pointer to the scrambled bytes.
+ * @param out Pointer to the output buffer, len bytes long. Must not overlap in.
+ * @param len Number of bytes.
+ */
+void il2p_descramble(const unsigned char *in, unsigned char *out, int len);
+
+/**
+ * @brief Encodes an AX.25 frame into an IL2P packet.
+ *
+ * Frames whose header fits the compact type 1 header (no repeaters, callsigns in DEC SIXBIT,
+ * modulo 8 sequence numbers and a PID known to IL2P) are translated: addresses, control and
+ * PID go to the 13-byte header and only the information field is sent as payload. Any other
+ * frame is carried whole in the payload behind a type 0 header. The header and every payload
+ * block are scrambled, then protected by their Reed-Solomon check bytes.
+ *
+ * No bit stuffing is applied: the output is the sync word followed by the packet, to be sent
+ * most significant bit first after a preamble of 0x55 bytes.
+ *
+ * @param frame Pointer to the AX.25 frame, in normal bit order, without FCS.
+ * @param frameLen Length of the frame in bytes.
+ * @param encoded Pointer to the output buffer, at least IL2P_MAX_ENCODED_LEN bytes long.
+ * @param encodedLen Pointer to an integer where the length of the packet will be stored, in bytes.
+ * @param options Bitwise OR of IL2P_OPT_* flags.
+ * @return 0 on success, -1 if the frame is too long or too short to be a valid AX.25 frame.
+ */
+int il2p_frame_encode(const unsigned char *frame, int frameLen, unsigned char *encoded, int *encodedLen, int options);
+
+/**
+ * @brief Decodes an IL2P packet into an AX.25 frame.
+ *
+ * The sync word is searched at any bit offset of the input and accepted with one wrong bit,
+ * as recommended by the specification. A sync word whose header fails Reed-Solomon decoding
+ * is taken as a false match and the search goes on. Type 1 headers carry a single command
+ * bit: the address command/response bits are restored as defined by AX.25 v2.
+ *
+ * @param encoded Pointer to the received bitstream, most significant bit first.
+ * @param encodedLen Length of the input in bytes.
+ * @param decoded Pointer to the output buffer, at least IL2P_MAX_FRAME_LEN bytes long.
+ * @param decodedLen Pointer to an integer where the length of the AX.25 frame will be stored,
+ *                   in bytes, without FCS.
+ * @return Number of byte errors corrected (0 or more) on success, -1 if no packet could be
+ *         decoded (no sync word, truncated packet or uncorrectable block).
+ */
+int il2p_frame_decode(const unsigned char *encoded, int encodedLen, unsigned char *decoded, int *decodedLen);
+
+#endif /* IL2P_H_ */
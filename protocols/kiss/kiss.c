@@ -0,0 +1,293 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "kiss.h"
+
+#define KISS_SMACK_FLAG 0x80
+
+// SMACK uses CRC-16 x^16 + x^15 + x^2 + 1, reflected, initial value 0
+static uint16_t kiss_crc_table[256];
+static bool kiss_tables_ready = false;
+
+static void kiss_tables_init(void) {
+    if (kiss_tables_ready)
+        return;
+
+    for (int i = 0; i < 256; i++) {
+        uint16_t crc = i;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc & 0x0001) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+        kiss_crc_table[i] = crc;
+    }
+
+    kiss_tables_ready = true;
+}
+
+static uint16_t kiss_crc_update(uint16_t crc, const unsigned char *data, int len) {
+    for (int i = 0; i < len; i++) {
+        crc = (crc >> 8) ^ kiss_crc_table[(crc ^ data[i]) & 0xFF];
+    }
+    return crc;
+}
+
+// Index of the first FEND or FESC at or after start, or len. Eight bytes are checked at a time
+// with the usual zero byte test on the data XORed with each special character.
+static int kiss_find_special(const unsigned char *data, int start, int len) {
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
+    int i = start;
+
+    for (; i + 8 <= len; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        uint64_t fend = word ^ (ones * KISS_FEND);
+        uint64_t fesc = word ^ (ones * KISS_FESC);
+        if ((((fend - ones) & ~fend) | ((fesc - ones) & ~fesc)) & highs)
+            break;
+    }
+    for (; i < len; i++) {
+        if (data[i] == KISS_FEND || data[i] == KISS_FESC)
+            return i;
+    }
+    return len;
+}
+
+// Escapes len bytes into out and returns the number of bytes written
+static int kiss_escape(const unsigned char *in, int len, unsigned char *out) {
+    int pos = 0;
+
+    for (int i = 0; i < len;) {
+        int next = kiss_find_special(in, i, len);
+        memcpy(out + pos, in + i, next - i);
+        pos += next - i;
+        if (next == len)
+            break;
+        out[pos++] = KISS_FESC;
+        out[pos++] = (in[next] == KISS_FEND) ? KISS_TFEND : KISS_TFESC;
+        i = next + 1;
+    }
+    return pos;
+}
+
+int kiss_frame_encode(int port, int command, const unsigned char *data, int dataLen, unsigned char *encoded, int *encodedLen, bool smack) {
+    smack = smack && command == KISS_CMD_DATA;
+    if (port < 0 || port >= (smack ? KISS_MAX_PORTS / 2 : KISS_MAX_PORTS) || command < 0 || command > 0x0F || dataLen < 0)
+        return -1;
+
+    unsigned char type = (port << 4) | command | (smack ? KISS_SMACK_FLAG : 0);
+    int pos = 0;
+
+    // Port 12 data frames have a type byte of FEND: it is escaped like the data
+    encoded[pos++] = KISS_FEND;
+    pos += kiss_escape(&type, 1, encoded + pos);
+    pos += kiss_escape(data, dataLen, encoded + pos);
+    if (smack) {
+        kiss_tables_init();
+        uint16_t crc = kiss_crc_update(kiss_crc_update(0, &type, 1), data, dataLen);
+        unsigned char fcs[2] = { crc & 0xFF, crc >> 8 };
+        pos += kiss_escape(fcs, 2, encoded + pos);
+    }
+    encoded[pos++] = KISS_FEND;
+
+    *encodedLen = pos;
+    return 0;
+}
+
+int kiss_command_encode(int port, int command, uint8_t value, unsigned char *encoded, int *encodedLen) {
+    if (command == KISS_CMD_RETURN) {
+        encoded[0] = KISS_FEND;
+        encoded[1] = 0xFF;
+        encoded[2] = KISS_FEND;
+        *encodedLen = 3;
+        return 0;
+    }
+    if (command < KISS_CMD_TXDELAY || command > KISS_CMD_SETHARDWARE)
+        return -1;
+
+    return kiss_frame_encode(port, command, &value, 1, encoded, encodedLen, false);
+}
+
+// Splits an unescaped frame into port, command and data, checking and removing a SMACK CRC
+// when smack is set. Returns 0, or -1 on an empty frame or a CRC mismatch.
+static int kiss_parse(const unsigned char *frame, int len, int *port, int *command, int *dataLen, bool smack) {
+    if (len < 1)
+        return -1;
+    unsigned char type = frame[0];
+
+    if (type == 0xFF) {
+        *port = 0;
+        *command = KISS_CMD_RETURN;
+        *dataLen = len - 1;
+        return 0;
+    }
+
+    *port = (type >> 4) & 0x0F;
+    *command = type & 0x0F;
+    *dataLen = len - 1;
+
+    if (smack && (type & KISS_SMACK_FLAG) && *command == KISS_CMD_DATA) {
+        // The CRC over the frame and its own two bytes leaves a zero register
+        kiss_tables_init();
+        if (len < 3 || kiss_crc_update(0, frame, len) != 0)
+            return -1;
+        *port &= 0x07;
+        *dataLen -= 2;
+    }
+    return 0;
+}
+
+int kiss_frame_decode(unsigned char *frame, int frameLen, int *port, int *command, int *dataLen, bool smack) {
+    int start = 0;
+    int end = frameLen;
+    int pos = 0;
+
+    while (start < end && frame[start] == KISS_FEND)
+        start++;
+    while (end > start && frame[end - 1] == KISS_FEND)
+        end--;
+    if (start == end || memchr(frame + start, KISS_FEND, end - start))
+        return -1;
+
+    // Unescaping only shrinks the frame, so it can be written over itself
+    for (int i = start; i < end;) {
+        const unsigned char *esc = memchr(frame + i, KISS_FESC, end - i);
+        int next = esc ? (int) (esc - frame) : end;
+        memmove(frame + pos, frame + i, next - i);
+        pos += next - i;
+        if (next >= end - 1)
+            break;
+        unsigned char c = frame[next + 1];
+        frame[pos++] = (c == KISS_TFEND) ? KISS_FEND : (c == KISS_TFESC) ? KISS_FESC : c;
+        i = next + 2;
+    }
+    if (pos < 1)
+        return -1;
+
+    return kiss_parse(frame, pos, port, command, dataLen, smack);
+}
+
+static void kiss_deframer_complete(kiss_deframer_t *deframer) {
+    int port, command, dataLen;
+
+    if (deframer->overrun) {
+        deframer->overruns++;
+    } else if (deframer->frameLen > 0) {
+        if (kiss_parse(deframer->frame, deframer->frameLen, &port, &command, &dataLen, deframer->smack) == 0) {
+            deframer->frames++;
+            deframer->delivered++;
+            if (deframer->callback)
+                deframer->callback(port, command, deframer->frame + 1, dataLen, deframer->ctx);
+        } else {
+            deframer->crcErrors++;
+        }
+    }
+
+    deframer->frameLen = 0;
+    deframer->escape = false;
+    deframer->overrun = false;
+}
+
+// Appends one byte to the frame, watching for overruns
+static inline void kiss_deframer_put(kiss_deframer_t *deframer, unsigned char c) {
+    if (deframer->frameLen < (int) sizeof(deframer->frame))
+        deframer->frame[deframer->frameLen++] = c;
+    else
+        deframer->overrun = true;
+}
+
+// Unescapes a run of bytes that contains no FEND into the frame buffer
+static void kiss_deframer_append(kiss_deframer_t *deframer, const unsigned char *data, int len) {
+    int i = 0;
+
+    if (deframer->escape && len > 0) {
+        unsigned char c = data[i++];
+        kiss_deframer_put(deframer, (c == KISS_TFEND) ? KISS_FEND : (c == KISS_TFESC) ? KISS_FESC : c);
+        deframer->escape = false;
+    }
+
+    while (i < len) {
+        const unsigned char *esc = memchr(data + i, KISS_FESC, len - i);
+        int next = esc ? (int) (esc - data) : len;
+        int run = next - i;
+
+        if (deframer->frameLen + run > (int) sizeof(deframer->frame)) {
+            deframer->overrun = true;
+            run = (int) sizeof(deframer->frame) - deframer->frameLen;
+        }
+        memcpy(deframer->frame + deframer->frameLen, data + i, run);
+        deframer->frameLen += run;
+        if (next == len)
+            break;
+
+        if (next + 1 == len) {
+            // Escape split across two pushes
+            deframer->escape = true;
+            break;
+        }
+        unsigned char c = data[next + 1];
+        kiss_deframer_put(deframer, (c == KISS_TFEND) ? KISS_FEND : (c == KISS_TFESC) ? KISS_FESC : c);
+        i = next + 2;
+    }
+}
+
+void kiss_deframer_init(kiss_deframer_t *deframer, kiss_frame_callback_t callback, void *ctx, bool smack) {
+    memset(deframer, 0, sizeof(kiss_deframer_t));
+    deframer->callback = callback;
+    deframer->ctx = ctx;
+    deframer->smack = smack;
+}
+
+void kiss_deframer_reset(kiss_deframer_t *deframer) {
+    deframer->frameLen = 0;
+    deframer->inFrame = false;
+    deframer->escape = false;
+    deframer->overrun = false;
+}
+
+int kiss_deframer_push(kiss_deframer_t *deframer, const unsigned char *data, int len) {
+    int i = 0;
+
+    deframer->delivered = 0;
+    while (i < len) {
+        const unsigned char *fend = memchr(data + i, KISS_FEND, len - i);
+        int next = fend ? (int) (fend - data) : len;
+
+        // Bytes before the first FEND are line noise or leftovers from before a reset
+        if (deframer->inFrame)
+            kiss_deframer_append(deframer, data + i, next - i);
+        if (!fend)
+            break;
+
+        if (deframer->inFrame)
+            kiss_deframer_complete(deframer);
+        deframer->inFrame = true;
+        i = next + 1;
+    }
+
+    return deframer->delivered;
+}
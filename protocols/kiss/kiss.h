@@ -0,0 +1,193 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef KISS_H_
+#define KISS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @defgroup KissSpecial KISS Special Characters
+ * @{
+ */
+#define KISS_FEND  0xC0 ///< Frame end
+#define KISS_FESC  0xDB ///< Frame escape
+#define KISS_TFEND 0xDC ///< Transposed frame end, follows FESC
+#define KISS_TFESC 0xDD ///< Transposed frame escape, follows FESC
+/** @} */
+
+/**
+ * @defgroup KissLimits KISS Limits
+ * @{
+ * Both may be overridden at compile time.
+ */
+#ifndef KISS_MAX_FRAME_LEN
+#define KISS_MAX_FRAME_LEN 2048 ///< Largest data field collected by the deframer, in bytes
+#endif
+#define KISS_MAX_PORTS     16   ///< Ports addressed by the type byte (8 with SMACK)
+/** @} */
+
+/**
+ * @brief Largest output of kiss_frame_encode() for dataLen bytes of data.
+ *
+ * Two FENDs, and the type byte, the data and the SMACK CRC all escaped.
+ */
+#define KISS_ENCODED_MAX(dataLen) (2 * ((dataLen) + 3) + 2)
+
+/**
+ * @brief KISS commands, low nibble of the type byte.
+ */
+typedef enum {
+    KISS_CMD_DATA = 0x00,        ///< Frame to send or received frame
+    KISS_CMD_TXDELAY = 0x01,     ///< Keyup delay, in units of 10 ms
+    KISS_CMD_PERSIST = 0x02,     ///< Persistence p, as (p * 256) - 1
+    KISS_CMD_SLOTTIME = 0x03,    ///< Slot interval, in units of 10 ms
+    KISS_CMD_TXTAIL = 0x04,      ///< Time to hold up the transmitter after the frame, in units of 10 ms
+    KISS_CMD_FULLDUPLEX = 0x05,  ///< 0 for half duplex, non-zero for full duplex
+    KISS_CMD_SETHARDWARE = 0x06, ///< Hardware specific
+    KISS_CMD_RETURN = 0xFF,      ///< Leave KISS mode, type byte 0xFF for all ports
+} kiss_command_t;
+
+/**
+ * @brief Callback invoked by the KISS deframer for every complete frame.
+ *
+ * @param port Port number from the type byte.
+ * @param command Command from the type byte (a kiss_command_t value).
+ * @param data Pointer to the unescaped data field, without type byte or SMACK CRC. For
+ *             KISS_CMD_DATA it is an AX.25 frame ready for ax25_frame_decode(). The buffer
+ *             belongs to the deframer and is only valid during the call.
+ * @param dataLen Length of the data field in bytes.
+ * @param ctx User context pointer given to kiss_deframer_init().
+ */
+typedef void (*kiss_frame_callback_t)(int port, int command, const unsigned char *data, int dataLen, void *ctx);
+
+/**
+ * @brief State of a streaming KISS deframer.
+ *
+ * Collects the bytes between two FENDs from a serial stream pushed in chunks of any size,
+ * unescaping them on the fly. The structure must be initialized with kiss_deframer_init()
+ * and requires no dynamic memory.
+ */
+typedef struct {
+    unsigned char frame[KISS_MAX_FRAME_LEN + 3]; ///< Type byte, data and SMACK CRC collected so far
+    int frameLen;                                ///< Number of bytes collected
+    bool inFrame;                                ///< True once a FEND has been seen
+    bool escape;                                 ///< Last byte received was FESC
+    bool overrun;                                ///< Current frame exceeded the frame buffer
+    bool smack;                                  ///< Data frames with bit 7 of the type byte set carry a SMACK CRC
+    kiss_frame_callback_t callback;              ///< Frame delivery callback
+    void *ctx;                                   ///< User context passed to the callback
+    int delivered;                               ///< Frames delivered during the current push
+    uint32_t frames;                             ///< Frames delivered
+    uint32_t crcErrors;                          ///< SMACK frames discarded because of a CRC mismatch
+    uint32_t overruns;                           ///< Frames discarded because they exceeded KISS_MAX_FRAME_LEN
+} kiss_deframer_t;
+
+/**
+ * @brief Encodes a data frame or a command into a KISS frame.
+ *
+ * The output is the FEND, the type byte, the escaped data and the closing FEND. Runs of bytes
+ * that need no escaping are located a machine word at a time and copied in one block.
+ *
+ * With smack set and a KISS_CMD_DATA command, bit 7 of the type byte is set and the SMACK
+ * CRC-16 of type byte and data is appended, low byte first. SMACK only covers data frames:
+ * other commands are always sent plain.
+ *
+ * @param port Port number, 0 to 15 (0 to 7 with SMACK).
+ * @param command Command, 0 to 15. KISS_CMD_RETURN is sent with kiss_command_encode().
+ * @param data Pointer to the data field, an AX.25 frame without FCS for KISS_CMD_DATA.
+ * @param dataLen Length of the data field in bytes.
+ * @param encoded Pointer to the output buffer, at least KISS_ENCODED_MAX(dataLen) bytes long.
+ * @param encodedLen Pointer to an integer where the length of the KISS frame will be stored.
+ * @param smack True to append the SMACK CRC to data frames.
+ * @return 0 on success, -1 if the port or the command is out of range.
+ */
+int kiss_frame_encode(int port, int command, const unsigned char *data, int dataLen, unsigned char *encoded, int *encodedLen, bool smack);
+
+/**
+ * @brief Encodes a one-byte parameter command, or the return command.
+ *
+ * @param port Port number, 0 to 15. Ignored for KISS_CMD_RETURN.
+ * @param command KISS_CMD_TXDELAY to KISS_CMD_SETHARDWARE, or KISS_CMD_RETURN.
+ * @param value Parameter value, in the units given by kiss_command_t. Ignored for KISS_CMD_RETURN.
+ * @param encoded Pointer to the output buffer, at least 6 bytes long.
+ * @param encodedLen Pointer to an integer where the length of the KISS frame will be stored.
+ * @return 0 on success, -1 if the port or the command is out of range.
+ */
+int kiss_command_encode(int port, int command, uint8_t value, unsigned char *encoded, int *encodedLen);
+
+/**
+ * @brief Decodes one KISS frame in place.
+ *
+ * The frame, with or without its FENDs, is unescaped in the same buffer: on success the type
+ * byte ends up in frame[0] and the data field starts at frame[1]. With smack set, a SMACK
+ * CRC, signalled by bit 7 of the type byte of a data frame, is verified and removed; without
+ * it bit 7 is part of the port number, as on plain KISS TNCs with 16 ports.
+ *
+ * @param frame Pointer to the KISS frame, modified in place.
+ * @param frameLen Length of the KISS frame in bytes.
+ * @param port Pointer to an integer where the port number will be stored.
+ * @param command Pointer to an integer where the command will be stored.
+ * @param dataLen Pointer to an integer where the length of the data field will be stored.
+ * @param smack True if the TNC speaks SMACK.
+ * @return 0 on success, -1 if the frame is empty, contains a FEND or fails its SMACK CRC.
+ */
+int kiss_frame_decode(unsigned char *frame, int frameLen, int *port, int *command, int *dataLen, bool smack);
+
+/**
+ * @brief Initializes a streaming KISS deframer.
+ *
+ * Clears all decoding state and statistics and registers the frame callback.
+ *
+ * @param deframer Pointer to the deframer to initialize.
+ * @param callback Function called for each complete frame.
+ * @param ctx User context pointer passed unchanged to the callback.
+ * @param smack True if the TNC speaks SMACK: data frames with bit 7 of the type byte set are
+ *              then CRC-checked (see kiss_frame_decode()). False for plain KISS on 16 ports.
+ */
+void kiss_deframer_init(kiss_deframer_t *deframer, kiss_frame_callback_t callback, void *ctx, bool smack);
+
+/**
+ * @brief Drops any partially received frame and waits for the next FEND.
+ *
+ * Statistics are preserved.
+ *
+ * @param deframer Pointer to the deframer to reset.
+ */
+void kiss_deframer_reset(kiss_deframer_t *deframer);
+
+/**
+ * @brief Pushes a chunk of the serial stream into the deframer.
+ *
+ * FENDs are located with memchr() and the bytes between escapes are copied in blocks, so the
+ * cost is close to a memcpy() of the stream. Frames and escape sequences may straddle chunk
+ * boundaries. Empty frames (consecutive FENDs) are skipped. An FESC followed by anything but
+ * TFEND or TFESC is dropped and the byte kept, as most TNCs do.
+ *
+ * @param deframer Pointer to an initialized deframer.
+ * @param data Pointer to the received bytes.
+ * @param len Number of bytes in data.
+ * @return Number of frames delivered through the callback during this call.
+ */
+int kiss_deframer_push(kiss_deframer_t *deframer, const unsigned char *data, int len);
+
+#endif /* KISS_H_ */
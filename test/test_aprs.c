@@ -1558,6 +1558,71 @@ int test_aprs_altitude_token_validation() {
     return err;  // MODIFIED
 }  // MODIFIED
 
+int test_aprs_decode_arena() {
+    printf("test_aprs_decode_arena\n");
+    uint8_t err = 0;
+
+    static unsigned char buffer[512];
+    mem_arena_t arena;
+    mem_arena_init(&arena, buffer, sizeof(buffer));
+
+    // One packet of each allocating kind, all released by a single reset
+    aprs_position_no_ts_t pos;
+    TEST_ASSERT(aprs_decode_position_no_ts_arena("!4903.50N/07201.75W-Test /A=001234", &pos, &arena) == 0 && pos.comment != NULL,
+            "Position should decode into the arena", err);
+    TEST_ASSERT((unsigned char* ) pos.comment >= buffer && (unsigned char* ) pos.comment < buffer + sizeof(buffer), "Comment should live in the arena", err);
+
+    aprs_message_t msg;
+    TEST_ASSERT(aprs_decode_message_arena(":WB2OSZ-7 :Hello{001}", &msg, &arena) == 0, "Message should decode into the arena", err);
+    TEST_ASSERT(strcmp(msg.message, "Hello") == 0 && strcmp(msg.message_number, "001") == 0, "Message fields should match", err);
+
+    aprs_object_report_t obj;
+    TEST_ASSERT(aprs_decode_object_report_arena(";LEADER   *092345z4903.50N/07201.75W>", &obj, &arena) == 0, "Object should decode into the arena", err);
+
+    aprs_position_with_ts_t pts;
+    TEST_ASSERT(aprs_decode_position_with_ts_arena("@092345z4903.50N/07201.75W-Test", &pts, &arena) == 0 && strcmp(pts.comment, "Test") == 0,
+            "Timestamped position should decode into the arena", err);
+
+    aprs_raw_gps_t gps;
+    TEST_ASSERT(aprs_decode_raw_gps_arena("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47", &gps, &arena) == 0,
+            "Raw GPS should decode into the arena", err);
+
+    aprs_grid_square_t grid;
+    TEST_ASSERT(aprs_decode_grid_square_arena("[JJ00 Test location", &grid, &arena) == 0, "Grid square should decode into the arena", err);
+
+    aprs_test_packet_t test;
+    TEST_ASSERT(aprs_decode_test_packet_arena(",TEST123", &test, &arena) == 0 && strcmp(test.data, "TEST123") == 0, "Test packet should decode into the arena",
+            err);
+
+    aprs_item_report_t item;
+    TEST_ASSERT(aprs_decode_item_report_arena(")ITEM1    !3746.49N/12225.16W>Test item", &item, &arena) == 0, "Item should decode into the arena", err);
+
+    aprs_compressed_position_t cpos = { .latitude = 40.7128, .longitude = -74.0060, .symbol_table = '/', .symbol_code = '-', .comment = "Hi", .dti =
+    APRS_DTI_POSITION_NO_TS_NO_MSG, .course = -1, .speed = -1, .altitude = INT_MIN };
+    char info[100];
+    aprs_encode_compressed_position(info, sizeof(info), &cpos);
+    aprs_compressed_position_t decoded;
+    TEST_ASSERT(aprs_decode_compressed_position_arena(info, &decoded, &arena) == 0, "Compressed position should decode into the arena", err);
+
+    aprs_weather_report_t wx;
+    size_t before = arena.used;
+    TEST_ASSERT(aprs_decode_weather_report_arena("!4903.50N/07201.75W_220/004g005t077", &wx, &arena) == 0 && wx.has_position && wx.temperature == 77.0f,
+            "Positioned weather report should decode into the arena", err);
+    TEST_ASSERT(arena.used > before, "The scratch position comment should come from the arena", err);
+
+    TEST_ASSERT(arena.used > 0 && arena.used <= sizeof(buffer), "Every allocation should come from the arena", err);
+    mem_arena_reset(&arena);
+    TEST_ASSERT(arena.used == 0, "One reset should release the whole packet", err);
+
+    // An arena too small for the comment fails the decode
+    mem_arena_t tiny;
+    unsigned char tiny_buffer[4];
+    mem_arena_init(&tiny, tiny_buffer, sizeof(tiny_buffer));
+    TEST_ASSERT(aprs_decode_position_no_ts_arena("!4903.50N/07201.75W-Test /A=001234", &pos, &tiny) != 0, "An exhausted arena should fail the decode", err);
+
+    return 0;
+}
+
 int test_aprs_main() {
     int result = 0;
     printf("\n----------------------------------------------------------------------------------\n");
@@ -1592,6 +1657,7 @@ int test_aprs_main() {
     result |= test_dx_spot_encode_decode();
     result |= test_aprs_df_report();
     result |= test_aprs_agrelo_df();
+    result |= test_aprs_decode_arena();
     printf("\n----------------------------------------------------------------------------------\n");
     printf("Tests APRS Completed. %s\n", result == 0 ? "All tests passed" : "Some tests failed");
     printf("----------------------------------------------------------------------------------\n\n");
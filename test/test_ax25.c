@@ -27,6 +27,7 @@
 
 #include "test_common.h"
 #include "ax25.h"
+#include "hdlc.h"
 #include "utils.h"
 
 static uint32_t assert_count = 0;
@@ -1805,6 +1806,615 @@ int test_srej_functionality() {
     return 0;
 }
 
+int test_frame_decode_into() {
+    printf("test_frame_decode_into\n");
+    uint8_t err = 0;
+
+    ax25_frame_header_t header = { 0 };
+    header.destination = (ax25_address_t ) { .callsign = "APRS", .ssid = 0, .res0 = true, .res1 = true };
+    header.source = (ax25_address_t ) { .callsign = "N0CALL", .ssid = 7, .res0 = true, .res1 = true };
+    header.repeaters.num_repeaters = 1;
+    header.repeaters.repeaters[0] = (ax25_address_t ) { .callsign = "WIDE1", .ssid = 1, .ch = true, .res0 = true, .res1 = true };
+    header.cr = true;
+    size_t header_len;
+    uint8_t *header_bytes = ax25_frame_header_encode(&header, &header_len, &err);
+    TEST_ASSERT(header_bytes != NULL && header_len == 21, "Header encoding should succeed", err);
+
+    // Control field and information of each frame, appended to the same address field
+    struct {
+        uint8_t tail[8];
+        size_t tail_len;
+        int modulo128;
+        ax25_frame_type_t type;
+    } cases[] = {
+            { { 0x03, 0xF0, 'T', 'E', 'S', 'T' }, 6, MODULO128_FALSE, AX25_FRAME_UNNUMBERED_INFORMATION },
+            { { 0x13, 0xF0 }, 2, MODULO128_FALSE, AX25_FRAME_UNNUMBERED_INFORMATION },
+            { { 0x3F }, 1, MODULO128_FALSE, AX25_FRAME_UNNUMBERED_SABM },
+            { { 0x63 }, 1, MODULO128_FALSE, AX25_FRAME_UNNUMBERED_UA },
+            { { 0x87, 0x11, 0x45, 0x03 }, 4, MODULO128_FALSE, AX25_FRAME_UNNUMBERED_FRMR },
+            { { 0xE3, 'p', 'i', 'n', 'g' }, 5, MODULO128_FALSE, AX25_FRAME_UNNUMBERED_TEST },
+            { { 0x54, 0xCC, 1, 2, 3 }, 5, MODULO128_FALSE, AX25_FRAME_INFORMATION_8BIT },
+            { { 0x54 }, 1, MODULO128_FALSE, AX25_FRAME_INFORMATION_8BIT },
+            { { 0x08, 0x55, 0xF0, 'x' }, 4, MODULO128_TRUE, AX25_FRAME_INFORMATION_16BIT },
+            { { 0xA9 }, 1, MODULO128_FALSE, AX25_FRAME_SUPERVISORY_REJ_8BIT },
+            { { 0x0D, 0x0B }, 2, MODULO128_TRUE, AX25_FRAME_SUPERVISORY_SREJ_16BIT },
+            { { 0x54, 0xF0, 'r', 'a', 'w' }, 5, MODULO128_NONE, AX25_FRAME_RAW }, };
+
+    bool all_match = true;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        uint8_t frame_bytes[64];
+        size_t frame_len = header_len + cases[c].tail_len;
+        memcpy(frame_bytes, header_bytes, header_len);
+        memcpy(frame_bytes + header_len, cases[c].tail, cases[c].tail_len);
+
+        ax25_frame_storage_t storage;
+        uint8_t err_into;
+        ax25_frame_t *view = ax25_frame_decode_into(frame_bytes, frame_len, cases[c].modulo128, &storage, &err_into);
+        ax25_frame_t *heap = ax25_frame_decode(frame_bytes, frame_len, cases[c].modulo128, &err);
+        if (!view || !heap || err_into != 0 || view != &storage.base || view->type != cases[c].type || heap->type != view->type) {
+            printf("         -- case %zu: decode mismatch\n", c);
+            all_match = false;
+            if (heap)
+                ax25_frame_free(heap, &err);
+            continue;
+        }
+
+        for (int a = 0; a < 2 + heap->header.repeaters.num_repeaters; a++) {
+            const ax25_address_t *va = (a == 0) ? &view->header.destination : (a == 1) ? &view->header.source : &view->header.repeaters.repeaters[a - 2];
+            const ax25_address_t *ha = (a == 0) ? &heap->header.destination : (a == 1) ? &heap->header.source : &heap->header.repeaters.repeaters[a - 2];
+            if (strcmp(va->callsign, ha->callsign) != 0 || va->ssid != ha->ssid || va->ch != ha->ch || va->extension != ha->extension)
+                all_match = false;
+        }
+        if (view->header.repeaters.num_repeaters != heap->header.repeaters.num_repeaters || view->header.cr != heap->header.cr)
+            all_match = false;
+
+        const uint8_t *vp = NULL, *hp = NULL;
+        size_t vlen = 0, hlen = 0;
+        switch (view->type) {
+            case AX25_FRAME_UNNUMBERED_INFORMATION:
+                vp = storage.ui.payload, vlen = storage.ui.payload_len;
+                hp = ((ax25_unnumbered_information_frame_t*) heap)->payload, hlen = ((ax25_unnumbered_information_frame_t*) heap)->payload_len;
+                all_match &= storage.ui.pid == ((ax25_unnumbered_information_frame_t*) heap)->pid;
+                all_match &= storage.ui.base.pf == ((ax25_unnumbered_information_frame_t*) heap)->base.pf;
+            break;
+            case AX25_FRAME_UNNUMBERED_TEST:
+                vp = storage.test.payload, vlen = storage.test.payload_len;
+                hp = ((ax25_test_frame_t*) heap)->payload, hlen = ((ax25_test_frame_t*) heap)->payload_len;
+            break;
+            case AX25_FRAME_RAW:
+                vp = storage.raw.payload, vlen = storage.raw.payload_len;
+                hp = ((ax25_raw_frame_t*) heap)->payload, hlen = ((ax25_raw_frame_t*) heap)->payload_len;
+                all_match &= storage.raw.control == ((ax25_raw_frame_t*) heap)->control;
+            break;
+            case AX25_FRAME_INFORMATION_8BIT:
+            case AX25_FRAME_INFORMATION_16BIT: {
+                ax25_information_frame_t *h = (ax25_information_frame_t*) heap;
+                vp = storage.information.payload, vlen = storage.information.payload_len;
+                hp = h->payload, hlen = h->payload_len;
+                all_match &= storage.information.nr == h->nr && storage.information.ns == h->ns && storage.information.pf == h->pf
+                        && storage.information.pid == h->pid;
+                break;
+            }
+            case AX25_FRAME_UNNUMBERED_FRMR: {
+                ax25_frame_reject_frame_t *h = (ax25_frame_reject_frame_t*) heap;
+                all_match &= storage.frmr.frmr_control == h->frmr_control && storage.frmr.vr == h->vr && storage.frmr.vs == h->vs
+                        && storage.frmr.frmr_cr == h->frmr_cr && storage.frmr.w == h->w && storage.frmr.x == h->x && storage.frmr.y == h->y
+                        && storage.frmr.z == h->z;
+                break;
+            }
+            case AX25_FRAME_SUPERVISORY_REJ_8BIT:
+            case AX25_FRAME_SUPERVISORY_SREJ_16BIT: {
+                ax25_supervisory_frame_t *h = (ax25_supervisory_frame_t*) heap;
+                all_match &= storage.supervisory.nr == h->nr && storage.supervisory.pf == h->pf && storage.supervisory.code == h->code;
+                break;
+            }
+            default:
+                all_match &= storage.unnumbered.pf == ((ax25_unnumbered_frame_t*) heap)->pf;
+            break;
+        }
+        if (vlen != hlen || (vlen > 0 && memcmp(vp, hp, vlen) != 0))
+            all_match = false;
+        if (vlen > 0 && (vp < frame_bytes || vp + vlen > frame_bytes + frame_len))
+            all_match = false;
+
+        ax25_frame_free(heap, &err);
+    }
+    TEST_ASSERT(all_match, "ax25_frame_decode_into should match ax25_frame_decode and reference the input buffer", err);
+
+    // Error cases
+    {
+        ax25_frame_storage_t storage;
+        uint8_t frame_bytes[64];
+        memcpy(frame_bytes, header_bytes, header_len);
+        const uint8_t xid[] = { 0xAF, 0x82, 0x80, 0x00, 0x00 };
+        memcpy(frame_bytes + header_len, xid, sizeof(xid));
+        TEST_ASSERT(ax25_frame_decode_into(frame_bytes, header_len + sizeof(xid), MODULO128_FALSE, &storage, &err) == NULL && err == 7,
+                "XID frames should be rejected with error 7", err);
+
+        // Malformed frames fail with the same error from both decoders
+        const struct {
+            uint8_t tail[6];
+            size_t tail_len;
+        } bad[] = { { { 0xAF, 0x82, 0x80 }, 3 }, { { 0xAF, 0x82, 0x80, 0x00, 0x02, 0x01 }, 6 }, { { 0x03 }, 1 }, { { 0x87, 0x11 }, 2 }, { { 0xFF }, 1 } };
+        bool same = true;
+        for (size_t b = 0; b < sizeof(bad) / sizeof(bad[0]); b++) {
+            uint8_t err_heap;
+            memcpy(frame_bytes + header_len, bad[b].tail, bad[b].tail_len);
+            ax25_frame_t *heap = ax25_frame_decode(frame_bytes, header_len + bad[b].tail_len, MODULO128_FALSE, &err_heap);
+            same &= heap == NULL && ax25_frame_decode_into(frame_bytes, header_len + bad[b].tail_len, MODULO128_FALSE, &storage, &err) == NULL
+                    && err == err_heap && err != 0;
+        }
+        TEST_ASSERT(same, "Malformed frames should fail with the same error from ax25_frame_decode and ax25_frame_decode_into", err);
+
+        TEST_ASSERT(ax25_frame_decode_into(frame_bytes, header_len, MODULO128_FALSE, &storage, &err) == NULL && err == 3,
+                "Frame without control field should fail with error 3", err);
+        frame_bytes[header_len - 1] &= 0xFE;
+        frame_bytes[header_len] = 0x03;
+        TEST_ASSERT(ax25_frame_decode_into(frame_bytes, header_len + 1, MODULO128_FALSE, &storage, &err) == NULL && err == 5,
+                "Unterminated address field should fail with error 5", err);
+        TEST_ASSERT(ax25_frame_decode_into(frame_bytes, 10, MODULO128_FALSE, &storage, &err) == NULL && err == 1, "Short frame should fail with error 1",
+                err);
+    }
+
+    free(header_bytes);
+    return 0;
+}
+
+static int custom_encode_calls;
+
+static uint8_t* custom_param_encode(const ax25_xid_parameter_t *param, size_t *len, uint8_t *err) {
+    custom_encode_calls++;
+    uint8_t *bytes = malloc(3);
+    bytes[0] = param->pi;
+    bytes[1] = 1;
+    bytes[2] = 0x5A;
+    *len = 3;
+    *err = 0;
+    return bytes;
+}
+
+static uint8_t* failing_param_encode(const ax25_xid_parameter_t *param, size_t *len, uint8_t *err) {
+    (void) param;
+    *len = 0;
+    *err = 1;
+    return NULL;
+}
+
+int test_frame_encode_into() {
+    printf("test_frame_encode_into\n");
+    uint8_t err = 0;
+
+    // Frames in wire format: address field with one repeater followed by control and information
+    uint8_t header_bytes[] = { 'A' << 1, 'P' << 1, 'R' << 1, 'S' << 1, ' ' << 1, ' ' << 1, 0xE0, 'N' << 1, '0' << 1, 'C' << 1, 'A' << 1, 'L' << 1, 'L' << 1,
+            0x6E, 'W' << 1, 'I' << 1, 'D' << 1, 'E' << 1, '1' << 1, ' ' << 1, 0xE3 };
+    struct {
+        uint8_t tail[16];
+        size_t tail_len;
+        int modulo128;
+    } cases[] = {
+            { { 0x03, 0xF0, 'T', 'E', 'S', 'T' }, 6, MODULO128_FALSE },
+            { { 0x3F }, 1, MODULO128_FALSE },
+            { { 0x87, 0x11, 0x45, 0x03 }, 4, MODULO128_FALSE },
+            { { 0xAF, 0x82, 0x80, 0x00, 0x06, 0x02, 0x02, 0x21, 0x00, 0x08, 0x00 }, 11, MODULO128_FALSE },
+            { { 0xE3, 'p', 'i', 'n', 'g' }, 5, MODULO128_FALSE },
+            { { 0x54, 0xCC, 1, 2, 3 }, 5, MODULO128_FALSE },
+            { { 0x08, 0x55, 0xF0, 'x' }, 4, MODULO128_TRUE },
+            { { 0xA9 }, 1, MODULO128_FALSE },
+            { { 0x0D, 0x0B }, 2, MODULO128_TRUE },
+            { { 0x54, 0xF0, 'r', 'a', 'w' }, 5, MODULO128_NONE }, };
+
+    bool all_match = true;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        uint8_t frame_bytes[64];
+        size_t frame_len = sizeof(header_bytes) + cases[c].tail_len;
+        memcpy(frame_bytes, header_bytes, sizeof(header_bytes));
+        memcpy(frame_bytes + sizeof(header_bytes), cases[c].tail, cases[c].tail_len);
+
+        ax25_frame_t *frame = ax25_frame_decode(frame_bytes, frame_len, cases[c].modulo128, &err);
+        if (!frame) {
+            printf("         -- case %zu: decode failed (%u)\n", c, err);
+            all_match = false;
+            continue;
+        }
+
+        size_t ref_len;
+        uint8_t *ref = ax25_frame_encode(frame, &ref_len, &err);
+        size_t needed = ax25_frame_encode_into(frame, NULL, 0, &err);
+        uint8_t out[64];
+        memset(out, 0xAA, sizeof(out));
+        size_t out_len = ax25_frame_encode_into(frame, out, sizeof(out), &err);
+        if (!ref || err != 0 || needed != ref_len || out_len != ref_len || memcmp(out, ref, ref_len) != 0 || out[out_len] != 0xAA) {
+            printf("         -- case %zu: encode mismatch\n", c);
+            all_match = false;
+        }
+
+        free(ref);
+        ax25_frame_free(frame, &err);
+    }
+    TEST_ASSERT(all_match, "ax25_frame_encode_into should produce the same bytes as ax25_frame_encode", err);
+
+    // Too small a buffer is reported and left untouched, then the frame goes straight to the HDLC framer
+    {
+        ax25_unnumbered_information_frame_t ui = { 0 };
+        ui.base.base.type = AX25_FRAME_UNNUMBERED_INFORMATION;
+        ui.base.base.header.destination = (ax25_address_t ) { .callsign = "APRS", .res0 = true, .res1 = true };
+        ui.base.base.header.source = (ax25_address_t ) { .callsign = "N0CALL", .ssid = 7, .res0 = true, .res1 = true };
+        ui.base.base.header.cr = true;
+        ui.base.modifier = 0x03;
+        ui.pid = 0xF0;
+        ui.payload = (uint8_t*) "Hello";
+        ui.payload_len = 5;
+
+        uint8_t small[10] = { 0 };
+        size_t len = ax25_frame_encode_into((ax25_frame_t*) &ui, small, sizeof(small), &err);
+        TEST_ASSERT(err == 5 && len == 21 && small[0] == 0, "Too small a buffer should fail with error 5 and report the size", err);
+
+        uint8_t buf[64];
+        len = ax25_frame_encode_into((ax25_frame_t*) &ui, buf, sizeof(buf), &err);
+        TEST_ASSERT(err == 0 && len == 21, "UI frame should encode into 21 bytes", err);
+        unsigned char encoded[128], decoded[128];
+        int encoded_len, decoded_len;
+        hdlc_frame_encode(buf, len, encoded, &encoded_len);
+        TEST_ASSERT(hdlc_frame_decode(encoded, encoded_len, decoded, &decoded_len) == 0, "Encoded frame should pass through HDLC", err);
+        COMPARE_FRAME(decoded, (size_t )decoded_len, buf, len, "HDLC round trip should give the encoded frame back");
+    }
+
+    // XID parameters with their own encoder are encoded once per call, and a failing one is reported
+    {
+        ax25_xid_parameter_t custom = { .pi = 0x09, .encode = custom_param_encode };
+        ax25_xid_parameter_t *params[] = { &custom };
+        ax25_exchange_identification_frame_t xid = { 0 };
+        xid.base.base.type = AX25_FRAME_UNNUMBERED_XID;
+        xid.base.base.header.destination = (ax25_address_t ) { .callsign = "N0CALL", .res0 = true, .res1 = true };
+        xid.base.base.header.source = (ax25_address_t ) { .callsign = "N1CALL", .res0 = true, .res1 = true };
+        xid.base.modifier = 0xAF;
+        xid.fi = 0x82;
+        xid.gi = 0x80;
+        xid.parameters = params;
+        xid.param_count = 1;
+
+        size_t ref_len;
+        uint8_t *ref = ax25_frame_encode((ax25_frame_t*) &xid, &ref_len, &err);
+        custom_encode_calls = 0;
+        uint8_t buf[64];
+        size_t len = ax25_frame_encode_into((ax25_frame_t*) &xid, buf, sizeof(buf), &err);
+        TEST_ASSERT(ref && err == 0 && len == ref_len && memcmp(buf, ref, ref_len) == 0, "Custom XID parameter should encode like ax25_frame_encode", err);
+        TEST_ASSERT(custom_encode_calls == 1, "Custom XID parameter should be encoded once", err);
+        free(ref);
+
+        custom.encode = failing_param_encode;
+        len = ax25_frame_encode_into((ax25_frame_t*) &xid, buf, sizeof(buf), &err);
+        TEST_ASSERT(err == 3 && len == 0, "Failing XID parameter should fail with error 3", err);
+    }
+
+    return 0;
+}
+
+int test_frame_view() {
+    printf("test_frame_view\n");
+    uint8_t err = 0;
+
+    // APRS <- N0CALL-7 via WIDE1-1*, UI frame
+    uint8_t ui_bytes[] = { 'A' << 1, 'P' << 1, 'R' << 1, 'S' << 1, ' ' << 1, ' ' << 1, 0xE0, 'N' << 1, '0' << 1, 'C' << 1, 'A' << 1, 'L' << 1, 'L' << 1, 0x6E,
+            'W' << 1, 'I' << 1, 'D' << 1, 'E' << 1, '1' << 1, ' ' << 1, 0xE3, 0x03, 0xF0, '>', 'h', 'i' };
+    ax25_frame_view_t view;
+    TEST_ASSERT(ax25_frame_view_init(&view, ui_bytes, sizeof(ui_bytes), &err), "ax25_frame_view_init should succeed for UI frame", err);
+    TEST_ASSERT(view.num_addresses == 3, "View should find three addresses", err);
+    TEST_ASSERT(ax25_frame_view_address_equals(&view, 0, "APRS", 0), "Destination should match APRS-0", err);
+    TEST_ASSERT(ax25_frame_view_address_equals(&view, 1, "N0CALL", 7), "Source should match N0CALL-7", err);
+    TEST_ASSERT(ax25_frame_view_address_equals(&view, 1, "N0CALL", -1), "Source should match N0CALL with any SSID", err);
+    TEST_ASSERT(!ax25_frame_view_address_equals(&view, 1, "N0CALL", 8), "Source should not match N0CALL-8", err);
+    TEST_ASSERT(!ax25_frame_view_address_equals(&view, 1, "N0CAL", -1), "Source should not match a callsign prefix", err);
+    TEST_ASSERT(!ax25_frame_view_address_equals(&view, 0, "APRSXYZ", -1), "Callsigns longer than 6 characters should not match", err);
+    TEST_ASSERT(!ax25_frame_view_address_equals(&view, 3, "APRS", -1), "Out of range address should not match", err);
+    TEST_ASSERT(ax25_frame_view_ssid(&view, 2) == 1 && ax25_frame_view_ch(&view, 2), "Repeater should be WIDE1-1 with H bit set", err);
+    char callsign[CALLSIGN_MAX];
+    TEST_ASSERT(ax25_frame_view_callsign(&view, 2, callsign) == 5 && strcmp(callsign, "WIDE1") == 0, "Repeater callsign should be WIDE1", err);
+    TEST_ASSERT(ax25_frame_view_control(&view) == 0x03, "Control should be UI", err);
+    TEST_ASSERT(ax25_frame_view_pid(&view, MODULO128_FALSE) == 0xF0, "PID should be 0xF0", err);
+    size_t info_len;
+    const uint8_t *info = ax25_frame_view_info(&view, MODULO128_FALSE, &info_len);
+    TEST_ASSERT(info == ui_bytes + 23 && info_len == 3, "Info should point at the payload in place", err);
+
+    // Supervisory frame has no PID nor information
+    uint8_t s_bytes[15];
+    memcpy(s_bytes, ui_bytes, 7);
+    memcpy(s_bytes + 7, ui_bytes + 7, 7);
+    s_bytes[13] |= 0x01;
+    s_bytes[14] = 0x21;
+    TEST_ASSERT(ax25_frame_view_init(&view, s_bytes, sizeof(s_bytes), &err), "ax25_frame_view_init should succeed for S-frame", err);
+    TEST_ASSERT(ax25_frame_view_pid(&view, MODULO128_FALSE) == -1, "S-frame should have no PID", err);
+    TEST_ASSERT(ax25_frame_view_info(&view, MODULO128_FALSE, &info_len) == NULL && info_len == 0, "S-frame should have no info", err);
+
+    // Without a modulo, I-frames are raw frames, as ax25_frame_decode() returns them
+    uint8_t i_bytes[18];
+    memcpy(i_bytes, s_bytes, 14);
+    i_bytes[14] = 0x54;
+    i_bytes[15] = 0xF0;
+    i_bytes[16] = 'h';
+    i_bytes[17] = 'i';
+    TEST_ASSERT(ax25_frame_view_init(&view, i_bytes, sizeof(i_bytes), &err), "ax25_frame_view_init should succeed for I-frame", err);
+    TEST_ASSERT(ax25_frame_view_pid(&view, MODULO128_FALSE) == 0xF0, "I-frame should have a PID", err);
+    TEST_ASSERT(ax25_frame_view_pid(&view, MODULO128_NONE) == -1, "Raw frame should have no PID", err);
+    ax25_raw_frame_t *raw = (ax25_raw_frame_t*) ax25_frame_decode(i_bytes, sizeof(i_bytes), MODULO128_NONE, &err);
+    info = ax25_frame_view_info(&view, MODULO128_NONE, &info_len);
+    TEST_ASSERT(raw && raw->base.type == AX25_FRAME_RAW && info == i_bytes + 15 && info_len == raw->payload_len && memcmp(info, raw->payload, info_len) == 0,
+            "Raw frame info should match the decoded raw payload", err);
+    ax25_frame_free((ax25_frame_t*) raw, &err);
+
+    // Errors
+    TEST_ASSERT(!ax25_frame_view_init(&view, ui_bytes, 21, &err) && err == 3, "Frame without control field should fail with error 3", err);
+    TEST_ASSERT(!ax25_frame_view_init(&view, ui_bytes, 10, &err) && err == 1, "Short frame should fail with error 1", err);
+    ui_bytes[20] &= 0xFE;
+    TEST_ASSERT(!ax25_frame_view_init(&view, ui_bytes, sizeof(ui_bytes), &err) && err == 5, "Unterminated address field should fail with error 5", err);
+
+    return 0;
+}
+
+int test_packed_address() {
+    printf("test_packed_address\n");
+    uint8_t err = 0;
+
+    ax25_packed_address_t a = ax25_address_pack_string("N0CALL-7", &err);
+    TEST_ASSERT(err == 0 && a != 0, "ax25_address_pack_string should succeed", err);
+    ax25_packed_address_t b = ax25_address_pack_string("N0CALL-7*", &err);
+    ax25_packed_address_t c = ax25_address_pack_string("N0CALL-8", &err);
+    ax25_packed_address_t d = ax25_address_pack_string("N0CAL-7", &err);
+    TEST_ASSERT(AX25_PACKED_ADDRESS_EQUALS(a, b) && a != b, "Addresses differing only in the H bit should be equal", err);
+    TEST_ASSERT(!AX25_PACKED_ADDRESS_EQUALS(a, c), "Different SSID should not be equal", err);
+    TEST_ASSERT(!AX25_PACKED_ADDRESS_EQUALS(a, d), "Different callsign should not be equal", err);
+    TEST_ASSERT(AX25_PACKED_ADDRESS_HASH(a) == AX25_PACKED_ADDRESS_HASH(b), "Equal addresses should hash the same", err);
+    TEST_ASSERT(AX25_PACKED_ADDRESS_HASH(a) != AX25_PACKED_ADDRESS_HASH(c), "Different addresses should hash differently", err);
+    TEST_ASSERT((b & AX25_PACKED_CH_BIT) != 0 && (a & AX25_PACKED_CH_BIT) == 0, "H bit should be visible in the packed form", err);
+
+    // Packing agrees with the wire encoding and the string parser
+    ax25_address_t *addr = ax25_address_from_string("WIDE2-2*", &err);
+    size_t len;
+    uint8_t *wire = ax25_address_encode(addr, &len, &err);
+    ax25_packed_address_t packed = ax25_address_pack(addr);
+    TEST_ASSERT(packed == ax25_address_pack_wire(wire), "ax25_address_pack should match the wire encoding", err);
+    TEST_ASSERT(packed == ax25_address_pack_string("WIDE2-2*", &err), "ax25_address_pack_string should match ax25_address_from_string", err);
+    uint8_t back[7];
+    ax25_address_unpack_wire(packed, back);
+    TEST_ASSERT(memcmp(back, wire, 7) == 0, "ax25_address_unpack_wire should restore the wire bytes", err);
+    ax25_address_t unpacked;
+    ax25_address_unpack(packed, &unpacked);
+    TEST_ASSERT(strcmp(unpacked.callsign, "WIDE2 ") == 0 && unpacked.ssid == 2 && unpacked.ch, "ax25_address_unpack should restore the address", err);
+    free(wire);
+    ax25_address_free(addr, &err);
+
+    TEST_ASSERT(ax25_address_pack_string("NOCALL-16", &err) == 0 && err == 4, "Invalid SSID should fail with error 4", err);
+    TEST_ASSERT(ax25_address_pack_string(NULL, &err) == 0 && err == 2, "NULL string should fail with error 2", err);
+
+    // Straight from a frame view
+    uint8_t frame[] = { 'A' << 1, 'P' << 1, 'R' << 1, 'S' << 1, ' ' << 1, ' ' << 1, 0xE0, 'N' << 1, '0' << 1, 'C' << 1, 'A' << 1, 'L' << 1, 'L' << 1, 0x6F,
+            0x03, 0xF0 };
+    ax25_frame_view_t view;
+    ax25_frame_view_init(&view, frame, sizeof(frame), &err);
+    TEST_ASSERT(AX25_PACKED_ADDRESS_EQUALS(ax25_frame_view_packed_address(&view, 1), a), "Frame view source should equal N0CALL-7", err);
+
+    return 0;
+}
+
+int test_frame_decode_arena() {
+    printf("test_frame_decode_arena\n");
+    uint8_t err = 0;
+
+    // Arena basics: alignment, exhaustion, in-place growth and reset
+    static unsigned char buffer[1024];
+    mem_arena_t arena;
+    mem_arena_init(&arena, buffer + 1, sizeof(buffer) - 1);
+    void *a = mem_arena_alloc(&arena, 3);
+    void *b = mem_arena_alloc(&arena, 5);
+    TEST_ASSERT(a && b && ((uintptr_t ) a % MEM_ARENA_ALIGN) == 0 && ((uintptr_t ) b % MEM_ARENA_ALIGN) == 0, "Arena blocks should be aligned", err);
+    TEST_ASSERT(mem_realloc(&arena, b, 5, 40) == b, "The last arena block should grow in place", err);
+    TEST_ASSERT(mem_arena_alloc(&arena, sizeof(buffer)) == NULL, "An exhausted arena should return NULL", err);
+    mem_arena_reset(&arena);
+    TEST_ASSERT(arena.used == 0 && arena.peak > 0 && mem_arena_alloc(&arena, 3) == a, "Reset should release every block", err);
+    mem_arena_reset(&arena);
+
+    uint8_t ui[] = { 'A' << 1, 'P' << 1, 'R' << 1, 'S' << 1, ' ' << 1, ' ' << 1, 0xE0, 'N' << 1, '0' << 1, 'C' << 1, 'A' << 1, 'L' << 1, 'L' << 1, 0x6F,
+            0x03, 0xF0, 'H', 'E', 'L', 'L', 'O' };
+    ax25_frame_t *frame = ax25_frame_decode_arena(ui, sizeof(ui), MODULO128_FALSE, &arena, &err);
+    ax25_unnumbered_information_frame_t *uif = (ax25_unnumbered_information_frame_t*) frame;
+    TEST_ASSERT(frame != NULL && frame->type == AX25_FRAME_UNNUMBERED_INFORMATION && uif->payload_len == 5 && strcmp((char* ) uif->payload, "HELLO") == 0,
+            "UI frame should decode into the arena", err);
+    TEST_ASSERT((unsigned char* ) frame >= buffer && (unsigned char* ) uif->payload < buffer + sizeof(buffer), "Frame and payload should live in the arena",
+            err);
+
+    // XID parameters are allocated and grown in the arena too
+    uint8_t xid[] = { 'A' << 1, 'P' << 1, 'R' << 1, 'S' << 1, ' ' << 1, ' ' << 1, 0xE0, 'N' << 1, '0' << 1, 'C' << 1, 'A' << 1, 'L' << 1, 'L' << 1, 0x6F,
+            0xBF, 0x82, 0x80, 0x00, 0x0B, 0x02, 0x02, 0x00, 0x21, 0x06, 0x02, 0x04, 0x00, 0x08, 0x01, 0x07 };
+    size_t used = arena.used;
+    frame = ax25_frame_decode_arena(xid, sizeof(xid), MODULO128_FALSE, &arena, &err);
+    ax25_exchange_identification_frame_t *xf = (ax25_exchange_identification_frame_t*) frame;
+    TEST_ASSERT(frame != NULL && frame->type == AX25_FRAME_UNNUMBERED_XID && xf->param_count == 3 && xf->parameters[2]->pi == 0x08,
+            "XID frame should decode into the arena", err);
+    TEST_ASSERT(arena.used > used, "XID parameters should come from the arena", err);
+
+    size_t encoded_len;
+    uint8_t *encoded = ax25_frame_encode(frame, &encoded_len, &err);
+    TEST_ASSERT(encoded != NULL && encoded_len == sizeof(xid) && memcmp(encoded, xid, sizeof(xid)) == 0, "Arena frames should encode like heap frames", err);
+    free(encoded);
+
+    // Too small an arena fails cleanly
+    mem_arena_t tiny;
+    unsigned char tiny_buffer[32];
+    mem_arena_init(&tiny, tiny_buffer, sizeof(tiny_buffer));
+    TEST_ASSERT(ax25_frame_decode_arena(ui, sizeof(ui), MODULO128_FALSE, &tiny, &err) == NULL && err == 8, "An exhausted arena should fail with error 8", err);
+    TEST_ASSERT(ax25_frame_decode_arena(ui, 10, MODULO128_FALSE, &tiny, &err) == NULL && err == 1, "A malformed frame should keep its own error", err);
+
+    // A NULL arena falls back to the heap
+    frame = ax25_frame_decode_arena(ui, sizeof(ui), MODULO128_FALSE, NULL, &err);
+    TEST_ASSERT(frame != NULL && err == 0, "A NULL arena should decode on the heap", err);
+    ax25_frame_free(frame, &err);
+
+    mem_arena_reset(&arena);
+    TEST_ASSERT(arena.used == 0, "One reset should release the decoded frames", err);
+
+    return 0;
+}
+
+int test_frame_pool() {
+    printf("test_frame_pool\n");
+    uint8_t err = 0;
+
+    static ax25_frame_pool_slot_t slots[2];
+    ax25_frame_pool_t pool;
+    ax25_frame_pool_init(&pool, slots, 2);
+
+    uint8_t ui[] = { 'A' << 1, 'P' << 1, 'R' << 1, 'S' << 1, ' ' << 1, ' ' << 1, 0xE0, 'N' << 1, '0' << 1, 'C' << 1, 'A' << 1, 'L' << 1, 'L' << 1, 0x6F,
+            0x03, 0xF0, 'H', 'E', 'L', 'L', 'O' };
+    ax25_frame_t *first = ax25_frame_pool_decode(&pool, ui, sizeof(ui), MODULO128_FALSE, &err);
+    ax25_unnumbered_information_frame_t *uif = (ax25_unnumbered_information_frame_t*) first;
+    TEST_ASSERT(first != NULL && first->type == AX25_FRAME_UNNUMBERED_INFORMATION && strcmp((char* ) uif->payload, "HELLO") == 0,
+            "UI frame should decode into the pool", err);
+    TEST_ASSERT((unsigned char* ) first >= slots[0].bytes && uif->payload + uif->payload_len < slots[0].bytes + sizeof(slots[0]),
+            "Frame and payload should share the first slot", err);
+    ax25_frame_header_t header = first->header;
+
+    // A payload larger than the inline storage goes to the heap
+    static uint8_t big[16 + AX25_FRAME_POOL_INLINE_LEN + 64];
+    memcpy(big, ui, 16);
+    memset(big + 16, 'x', sizeof(big) - 16);
+    ax25_frame_t *large = ax25_frame_pool_decode(&pool, big, sizeof(big), MODULO128_FALSE, &err);
+    TEST_ASSERT(large != NULL && pool.fallbacks == 1 && pool.in_use == 1, "An oversized frame should fall back to the heap", err);
+
+    // Malformed frames fail without holding a slot
+    TEST_ASSERT(ax25_frame_pool_decode(&pool, ui, 10, MODULO128_FALSE, &err) == NULL && err == 1 && pool.in_use == 1 && pool.fallbacks == 1,
+            "A malformed frame should fail like ax25_frame_decode", err);
+    uint8_t bad_xid[] = { 'A' << 1, 'P' << 1, 'R' << 1, 'S' << 1, ' ' << 1, ' ' << 1, 0xE0, 'N' << 1, '0' << 1, 'C' << 1, 'A' << 1, 'L' << 1, 'L' << 1, 0x6F,
+            0xAF, 0x82, 0x80, 0x00, 0x02, 0x02, 0x01 };
+    TEST_ASSERT(ax25_frame_pool_decode(&pool, bad_xid, sizeof(bad_xid), MODULO128_FALSE, &err) == NULL && err == 3 && pool.in_use == 1 && pool.fallbacks == 1,
+            "A truncated XID parameter should fail with its own error", err);
+
+    // I-frame with inline payload from ax25_frame_pool_create, then pool exhaustion
+    ax25_frame_t *iframe = ax25_frame_pool_create(&pool, AX25_FRAME_INFORMATION_8BIT, &header, 32, &err);
+    ax25_information_frame_t *inf = (ax25_information_frame_t*) iframe;
+    TEST_ASSERT(iframe != NULL && inf->payload_len == 32 && inf->payload != NULL && (unsigned char* ) iframe >= slots[1].bytes && pool.in_use == 2,
+            "Created frame should take the second slot with its payload", err);
+    ax25_frame_t *extra = ax25_frame_pool_create(&pool, AX25_FRAME_SUPERVISORY_RR_8BIT, &header, 0, &err);
+    TEST_ASSERT(extra != NULL && pool.fallbacks == 2 && pool.peak == 2, "An empty pool should fall back to the heap", err);
+    TEST_ASSERT(ax25_frame_pool_create(&pool, (ax25_frame_type_t) 99, &header, 0, &err) == NULL && err == 2, "Unknown types should be rejected", err);
+
+    size_t encoded_len;
+    inf->pid = 0xF0;
+    memset(inf->payload, 'y', inf->payload_len);
+    uint8_t *encoded = ax25_frame_encode(iframe, &encoded_len, &err);
+    TEST_ASSERT(encoded != NULL && encoded_len == 14 + 2 + 32 && encoded[encoded_len - 1] == 'y', "Pool frames should encode like heap frames", err);
+    free(encoded);
+
+    ax25_frame_pool_free(&pool, extra, &err);
+    ax25_frame_pool_free(&pool, large, &err);
+    ax25_frame_pool_free(&pool, iframe, &err);
+    TEST_ASSERT(pool.in_use == 1 && pool.free_list == &slots[1], "Freed slots should return to the pool", err);
+    ax25_frame_pool_free(&pool, first, &err);
+    TEST_ASSERT(pool.in_use == 0, "Every slot should be free", err);
+
+    // Steady state: decode and free reuse the same slot
+    bool same = true;
+    for (int i = 0; i < 1000; i++) {
+        ax25_frame_t *frame = ax25_frame_pool_decode(&pool, ui, sizeof(ui), MODULO128_FALSE, &err);
+        same &= (frame != NULL && (unsigned char* ) frame < slots[0].bytes + sizeof(slots[0]));
+        ax25_frame_pool_free(&pool, frame, &err);
+    }
+    TEST_ASSERT(same && pool.fallbacks == 2 && pool.peak == 2, "Decode and free should cycle through one slot", err);
+
+    // ax25_frame_create works on the heap
+    ax25_frame_t *heap = ax25_frame_create(AX25_FRAME_UNNUMBERED_UA, &header, &err);
+    TEST_ASSERT(heap != NULL && err == 0 && heap->type == AX25_FRAME_UNNUMBERED_UA, "ax25_frame_create should allocate a frame", err);
+    ax25_frame_free(heap, &err);
+
+    return 0;
+}
+
+int test_segment_reassembler() {
+    printf("test_segment_reassembler\n");
+    uint8_t err = 0;
+
+    static uint8_t payload[10000], buffer[AX25_REASSEMBLY_MAX_LEN];
+    for (size_t i = 0; i < sizeof(payload); i++)
+        payload[i] = (uint8_t) (i * 7 + (i >> 8));
+    size_t num_segments;
+    ax25_segmented_info_t *segments = ax25_segment_info_fields(payload, sizeof(payload), 256, &err, &num_segments);
+    TEST_ASSERT(segments != NULL && num_segments == 40, "Payload should be segmented", err);
+
+    ax25_reassembler_t reassembler;
+    ax25_reassembler_init(&reassembler, buffer, sizeof(buffer));
+
+    // In order: complete on the last segment
+    int result = 0;
+    for (size_t i = 0; i < num_segments; i++)
+        result = ax25_reassembler_push(&reassembler, segments[i].info_field + 1, segments[i].info_field_len - 1, &err);
+    TEST_ASSERT(result == 1 && reassembler.total_length == sizeof(payload) && memcmp(buffer, payload, sizeof(payload)) == 0,
+            "Segments in order should reassemble the payload", err);
+
+    // Reverse order: the last segment waits for the size, the first completes the payload
+    bool placed = true;
+    for (size_t i = num_segments; i-- > 1;)
+        placed &= (ax25_reassembler_push(&reassembler, segments[i].info_field + 1, segments[i].info_field_len - 1, &err) == 0);
+    TEST_ASSERT(placed && !reassembler.complete && !reassembler.last_parked, "Segments should be placed before the first arrives", err);
+    result = ax25_reassembler_push(&reassembler, segments[0].info_field + 1, segments[0].info_field_len - 1, &err);
+    TEST_ASSERT(result == 1 && memcmp(buffer, payload, sizeof(payload)) == 0, "Segments in reverse order should reassemble the payload", err);
+
+    // Shuffled, with duplicates: the last segment comes first and is parked until a full-size one
+    memset(buffer, 0, sizeof(buffer));
+    size_t order[40];
+    for (size_t i = 0; i < num_segments; i++)
+        order[i] = (i * 17 + 39) % num_segments;
+    result = 0;
+    int completions = 0;
+    for (size_t i = 0; i < num_segments; i++) {
+        result = ax25_reassembler_push(&reassembler, segments[order[i]].info_field + 1, segments[order[i]].info_field_len - 1, &err);
+        completions += (result == 1);
+        if (i < num_segments - 1)
+            ax25_reassembler_push(&reassembler, segments[order[i]].info_field + 1, segments[order[i]].info_field_len - 1, &err);
+    }
+    TEST_ASSERT(order[0] == num_segments - 1 && completions == 1 && result == 1 && memcmp(buffer, payload, sizeof(payload)) == 0
+            && reassembler.payloads == 3 && reassembler.errors == 0, "Shuffled and repeated segments should reassemble once", err);
+
+    // A payload too large for the buffer, a missing segment, then a new payload replacing it
+    static uint8_t small[1000];
+    ax25_reassembler_init(&reassembler, small, sizeof(small));
+    TEST_ASSERT(ax25_reassembler_push(&reassembler, segments[0].info_field + 1, segments[0].info_field_len - 1, &err) == -1 && err == 2,
+            "A payload larger than the buffer should be rejected", err);
+    uint8_t short_payload[600];
+    memcpy(short_payload, payload, sizeof(short_payload));
+    size_t num_short;
+    ax25_segmented_info_t *short_segments = ax25_segment_info_fields(short_payload, sizeof(short_payload), 256, &err, &num_short);
+    ax25_reassembler_push(&reassembler, short_segments[0].info_field + 1, short_segments[0].info_field_len - 1, &err);
+    ax25_reassembler_push(&reassembler, short_segments[2].info_field + 1, short_segments[2].info_field_len - 1, &err);
+    TEST_ASSERT(!reassembler.complete && reassembler.received == 0x5, "A payload with a missing segment should stay incomplete", err);
+    TEST_ASSERT(ax25_reassembler_push(&reassembler, short_segments[1].info_field + 1, 100, &err) == -1 && err == 3,
+            "A middle segment of the wrong size should be rejected", err);
+    uint8_t single[] = { 0xC0, 0x00, 0x03, 'a', 'b', 'c' };
+    result = ax25_reassembler_push(&reassembler, single, sizeof(single), &err);
+    TEST_ASSERT(result == 1 && reassembler.total_length == 3 && memcmp(small, "abc", 3) == 0, "A new payload should replace an incomplete one", err);
+    uint8_t wrong[] = { 0xC0, 0x00, 0x05, 'a', 'b', 'c' };
+    TEST_ASSERT(ax25_reassembler_push(&reassembler, wrong, sizeof(wrong), &err) == -1 && err == 5 && reassembler.received == 0,
+            "A payload that does not add up should be abandoned", err);
+
+    // Segments beyond the last one: after the end flag, or before an end flag below them
+    ax25_reassembler_push(&reassembler, short_segments[0].info_field + 1, short_segments[0].info_field_len - 1, &err);
+    ax25_reassembler_push(&reassembler, short_segments[2].info_field + 1, short_segments[2].info_field_len - 1, &err);
+    uint8_t beyond[256];
+    memcpy(beyond, short_segments[1].info_field + 1, short_segments[1].info_field_len - 1);
+    beyond[0] = 0x03;
+    TEST_ASSERT(ax25_reassembler_push(&reassembler, beyond, short_segments[1].info_field_len - 1, &err) == -1 && err == 4 && reassembler.received == 0x5,
+            "A segment numbered after the last one should be rejected", err);
+    ax25_reassembler_reset(&reassembler);
+    ax25_reassembler_push(&reassembler, short_segments[0].info_field + 1, short_segments[0].info_field_len - 1, &err);
+    beyond[0] = 0x02;
+    ax25_reassembler_push(&reassembler, beyond, short_segments[1].info_field_len - 1, &err);
+    uint8_t early_end[] = { 0x41, 'x' };
+    TEST_ASSERT(ax25_reassembler_push(&reassembler, early_end, sizeof(early_end), &err) == -1 && err == 4 && reassembler.received == 0x5 && reassembler.last < 0,
+            "An end flag below a segment already received should be rejected", err);
+
+    ax25_free_segmented_info(short_segments, num_short);
+    ax25_free_segmented_info(segments, num_segments);
+    return 0;
+}
+
 int test_ax25_main() {
     int result = 0;
     printf("\n----------------------------------------------------------------------------------\n");
@@ -1843,6 +2453,13 @@ int test_ax25_main() {
     result |= test_sequence_number_wrap_around();
     result |= test_large_payloads();
     result |= test_sabme_ua_negotiation();
+    result |= test_frame_decode_into();
+    result |= test_frame_encode_into();
+    result |= test_frame_view();
+    result |= test_packed_address();
+    result |= test_frame_decode_arena();
+    result |= test_frame_pool();
+    result |= test_segment_reassembler();
 
     printf("\n----------------------------------------------------------------------------------\n\n");
     test_ax25_frame_print();
@@ -0,0 +1,642 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "test_common.h"
+#include "ax25.h"
+#include "ax25_link.h"
+
+static uint32_t assert_count = 0;
+
+#define WIRE_FRAMES 256
+#define WIRE_LEN    (7 * 10 + 3 + AX25_LINK_MAX_N1)
+
+// One end of a simulated radio channel
+typedef struct {
+    ax25_link_t link;
+    uint8_t out[WIRE_FRAMES][WIRE_LEN]; // Frames sent and not yet delivered
+    size_t out_len[WIRE_FRAMES];
+    int out_count;
+    int drop_iframes;                    // Next I-frames sent are lost
+    bool deaf;                           // Every frame sent to this station is lost
+    int events[64];
+    int errors[64];
+    int event_count;
+    uint8_t rx[16384];                   // Information received, concatenated
+    size_t rx_len;
+    int rx_frames;
+} link_station_t;
+
+static link_station_t station_a, station_b;
+static uint8_t wire_copy[WIRE_FRAMES][WIRE_LEN];
+static size_t wire_copy_len[WIRE_FRAMES];
+
+static bool is_iframe(const uint8_t *frame) {
+    return (frame[14] & 0x01) == 0;
+}
+
+static void station_send(const uint8_t *frame, size_t len, void *ctx) {
+    link_station_t *st = ctx;
+    if (st->drop_iframes > 0 && is_iframe(frame)) {
+        st->drop_iframes--;
+        return;
+    }
+    if (st->out_count < WIRE_FRAMES && len <= WIRE_LEN) {
+        memcpy(st->out[st->out_count], frame, len);
+        st->out_len[st->out_count++] = len;
+    }
+}
+
+static void station_data(uint8_t pid, const uint8_t *data, size_t len, void *ctx) {
+    (void) pid;
+    link_station_t *st = ctx;
+    if (st->rx_len + len <= sizeof(st->rx)) {
+        memcpy(st->rx + st->rx_len, data, len);
+        st->rx_len += len;
+    }
+    st->rx_frames++;
+}
+
+static void station_event(int event, int error, void *ctx) {
+    link_station_t *st = ctx;
+    if (st->event_count < 64) {
+        st->events[st->event_count] = event;
+        st->errors[st->event_count++] = error;
+    }
+}
+
+static bool station_has_event(const link_station_t *st, int event, int error) {
+    for (int i = 0; i < st->event_count; i++) {
+        if (st->events[i] == event && st->errors[i] == error)
+            return true;
+    }
+    return false;
+}
+
+static void station_init(link_station_t *st, const ax25_link_config_t *config, const char *local, const char *peer) {
+    ax25_link_callbacks_t callbacks = { station_send, station_data, station_event };
+    uint8_t err;
+
+    memset(st, 0, sizeof(*st));
+    ax25_address_t *l = ax25_address_from_string(local, &err);
+    ax25_address_t *p = ax25_address_from_string(peer, &err);
+    ax25_link_init(&st->link, config, l, p, NULL, &callbacks, st);
+    ax25_address_free(l, &err);
+    ax25_address_free(p, &err);
+}
+
+static void stations_init(const ax25_link_config_t *config) {
+    station_init(&station_a, config, "N0CALL", "N1CALL-1");
+    station_init(&station_b, config, "N1CALL-1", "N0CALL");
+}
+
+// Delivers the frames sent by from, returns how many were sent
+static int wire_deliver(link_station_t *from, link_station_t *to, uint32_t now) {
+    int count = from->out_count;
+    memcpy(wire_copy, from->out, sizeof(wire_copy[0]) * count);
+    memcpy(wire_copy_len, from->out_len, sizeof(size_t) * count);
+    from->out_count = 0;
+    for (int i = 0; i < count; i++) {
+        if (!to->deaf)
+            ax25_link_receive(&to->link, wire_copy[i], wire_copy_len[i], now);
+    }
+    return count;
+}
+
+// Exchanges frames until both stations are quiet
+static void wire_pump(uint32_t now) {
+    while (wire_deliver(&station_a, &station_b, now) + wire_deliver(&station_b, &station_a, now) > 0)
+        ;
+}
+
+// Advances the clock by step until both stations are quiet and no timer is left but T3
+static uint32_t wire_run(uint32_t now, uint32_t step, int steps) {
+    for (int i = 0; i < steps; i++) {
+        wire_pump(now);
+        if (!station_a.link.t1_running && !station_b.link.t1_running)
+            break;
+        now += step;
+        ax25_link_tick(&station_a.link, now);
+        ax25_link_tick(&station_b.link, now);
+    }
+    wire_pump(now);
+    return now;
+}
+
+// Loses the frame at index in the frames sent by st
+static void wire_drop(link_station_t *st, int index) {
+    memmove(st->out[index], st->out[index + 1], sizeof(st->out[0]) * (st->out_count - index - 1));
+    memmove(st->out_len + index, st->out_len + index + 1, sizeof(size_t) * (st->out_count - index - 1));
+    st->out_count--;
+}
+
+static void fill_pattern(uint8_t *data, size_t len, int seed) {
+    for (size_t i = 0; i < len; i++)
+        data[i] = (uint8_t) (seed * 31 + i);
+}
+
+int test_link_connect() {
+    printf("test_link_connect\n");
+    uint8_t err = 0;
+    ax25_link_config_t config;
+    ax25_link_config_default(&config);
+    stations_init(&config);
+
+    TEST_ASSERT(ax25_link_send(&station_a.link, PID_NO_L3, (const uint8_t* ) "x", 1, 0) == -1, "Data should be refused while disconnected", err);
+    TEST_ASSERT(ax25_link_connect(&station_a.link, 0) == 0 && station_a.link.state == AX25_LINK_AWAITING_CONNECTION && station_a.out_count == 1,
+            "Connect should send SABM", err);
+    TEST_ASSERT(station_a.out[0][14] == 0x3F && (station_a.out[0][6] & 0x80) && !(station_a.out[0][13] & 0x80), "SABM should be a command with P=1", err);
+    TEST_ASSERT(ax25_link_connect(&station_a.link, 0) == -1, "A second connect should be refused", err);
+
+    wire_pump(0);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_CONNECTED && station_b.link.state == AX25_LINK_CONNECTED, "Both ends should be connected", err);
+    TEST_ASSERT(station_a.event_count == 1 && station_a.events[0] == AX25_LINK_CONNECT_CONFIRM, "Caller should get a connect confirm", err);
+    TEST_ASSERT(station_b.event_count == 1 && station_b.events[0] == AX25_LINK_CONNECT_INDICATION, "Peer should get a connect indication", err);
+    TEST_ASSERT(!station_a.link.t1_running && station_a.link.t3_running, "T3 should run on an idle link", err);
+
+    // Frames for another station are ignored
+    uint8_t other[16], disc[16];
+    ax25_link_disconnect(&station_b.link, 10);
+    memcpy(disc, station_b.out[0], 15);
+    memcpy(other, disc, 15);
+    other[0] ^= 0x02;
+    TEST_ASSERT(ax25_link_receive(&station_a.link, other, 15, 10) == -1 && station_a.link.state == AX25_LINK_CONNECTED,
+            "Frames for another station should be ignored", err);
+
+    wire_pump(10);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_DISCONNECTED && station_b.link.state == AX25_LINK_DISCONNECTED, "Both ends should be disconnected", err);
+    TEST_ASSERT(station_b.events[1] == AX25_LINK_DISCONNECT_CONFIRM && station_a.events[1] == AX25_LINK_DISCONNECT_INDICATION,
+            "Disconnect should be confirmed and indicated", err);
+
+    TEST_ASSERT(ax25_link_disconnect(&station_a.link, 20) == -1 && station_a.out_count == 0, "Disconnect should be refused while disconnected", err);
+
+    // A DISC for a link that does not exist is answered with DM
+    ax25_link_receive(&station_a.link, disc, 15, 20);
+    TEST_ASSERT(station_a.out_count == 1 && station_a.out[0][14] == 0x1F && station_a.link.state == AX25_LINK_DISCONNECTED,
+            "DISC should be answered with DM F=1 while disconnected", err);
+
+    // No answer: N2 retries with T1 backing off, then give up
+    stations_init(&config);
+    station_b.deaf = true;
+    ax25_link_connect(&station_a.link, 0);
+    wire_run(0, 1000, 3);
+    TEST_ASSERT(station_a.link.rc == 1 && station_a.link.t1v == 2 * config.t1, "T1 should double on the first retry", err);
+    wire_run(3000, 1000, 400);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_DISCONNECTED && station_a.link.frames_sent == 1u + config.n2,
+            "Connect should give up after N2 retries", err);
+    TEST_ASSERT(station_has_event(&station_a, AX25_LINK_ERROR, AX25_LINK_ERROR_G) && station_has_event(&station_a, AX25_LINK_DISCONNECT_INDICATION, 0),
+            "Connection timeout should be reported", err);
+
+    // A link reset drops the frames still outstanding and reports a connect indication
+    stations_init(&config);
+    ax25_link_connect(&station_a.link, 0);
+    wire_pump(0);
+    station_b.deaf = true;
+    ax25_link_send(&station_a.link, PID_NO_L3, (const uint8_t* ) "lost", 4, 0);
+    wire_pump(0);
+    station_b.deaf = false;
+    station_a.event_count = 0;
+    ax25_frame_storage_t frmr;
+    uint8_t frame[32];
+    memset(&frmr, 0, sizeof(frmr));
+    frmr.base.type = AX25_FRAME_UNNUMBERED_FRMR;
+    frmr.base.header = station_b.link.header;
+    frmr.frmr.base.modifier = 0x87;
+    frmr.frmr.w = true;
+    size_t len = ax25_frame_encode_into(&frmr.base, frame, sizeof(frame), &err);
+    ax25_link_receive(&station_a.link, frame, len, 0);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_AWAITING_CONNECTION && station_a.link.vs != station_a.link.va, "FRMR should reset the link", err);
+    wire_pump(0);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_CONNECTED && station_a.link.tx_count == 0 && station_b.rx_frames == 0,
+            "Outstanding frames should not be resent under new sequence numbers", err);
+    TEST_ASSERT(station_has_event(&station_a, AX25_LINK_CONNECT_INDICATION, 0), "Discarding them should be indicated", err);
+
+    // With nothing outstanding the reset is silent
+    station_a.event_count = 0;
+    ax25_link_receive(&station_a.link, frame, len, 0);
+    wire_pump(0);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_CONNECTED && !station_has_event(&station_a, AX25_LINK_CONNECT_INDICATION, 0)
+            && !station_has_event(&station_a, AX25_LINK_CONNECT_CONFIRM, 0), "A reset without lost frames should not report a connection", err);
+
+    return 0;
+}
+
+int test_link_transfer() {
+    printf("test_link_transfer\n");
+    uint8_t err = 0;
+    ax25_link_config_t config;
+    ax25_link_config_default(&config);
+    config.n1 = 128;
+    stations_init(&config);
+    ax25_link_connect(&station_a.link, 0);
+    wire_pump(0);
+
+    static uint8_t sent[40 * 128];
+    fill_pattern(sent, sizeof(sent), 1);
+    TEST_ASSERT(ax25_link_send(&station_a.link, PID_NO_L3, sent, 129, 0) == -1, "Fields longer than N1 should be refused", err);
+
+    for (int i = 0; i < 40; i++)
+        ax25_link_send(&station_a.link, PID_NO_L3, sent + i * 128, 128, 0);
+    TEST_ASSERT(station_a.out_count == 7 && station_a.link.t1_running, "Only a window of 7 I-frames should go out", err);
+    TEST_ASSERT(ax25_link_send(&station_b.link, PID_NO_L3, (const uint8_t* ) "reply", 5, 0) == 0, "The peer should be able to send too", err);
+
+    wire_pump(0);
+    TEST_ASSERT(station_b.rx_frames == 40 && station_b.rx_len == sizeof(sent) && memcmp(station_b.rx, sent, sizeof(sent)) == 0,
+            "Every frame should arrive in order", err);
+    TEST_ASSERT(station_a.rx_frames == 1 && memcmp(station_a.rx, "reply", 5) == 0, "Data should flow both ways", err);
+    TEST_ASSERT(station_a.link.tx_count == 0 && station_a.link.va == station_a.link.vs && station_a.link.vs == 40 % 8 && !station_a.link.t1_running,
+            "Every frame should be acknowledged", err);
+    TEST_ASSERT(station_a.link.retransmissions == 0, "Nothing should be sent twice on a clean channel", err);
+
+    // A lost frame is recovered with REJ
+    station_b.rx_len = 0;
+    station_b.rx_frames = 0;
+    for (int i = 0; i < 7; i++)
+        ax25_link_send(&station_a.link, PID_NO_L3, sent + i * 128, 128, 100);
+    memmove(station_a.out[2], station_a.out[3], sizeof(station_a.out[0]) * 4);
+    memmove(station_a.out_len + 2, station_a.out_len + 3, sizeof(size_t) * 4);
+    station_a.out_count--;
+    wire_pump(100);
+    TEST_ASSERT(station_b.rx_frames == 7 && memcmp(station_b.rx, sent, 7 * 128) == 0, "A lost I-frame should be recovered", err);
+    TEST_ASSERT(station_a.link.retransmissions == 5 && station_a.link.state == AX25_LINK_CONNECTED && station_a.link.tx_count == 0,
+            "REJ should resend from the lost frame", err);
+
+    // Busy receiver: RNR stops the sender, RR lets it resume
+    station_b.rx_frames = 0;
+    ax25_link_set_busy(&station_b.link, true, 200);
+    wire_pump(200);
+    TEST_ASSERT(station_a.link.peer_busy, "RNR should mark the peer busy", err);
+    ax25_link_send(&station_a.link, PID_NO_L3, sent, 10, 200);
+    TEST_ASSERT(station_a.out_count == 0, "Nothing should be sent to a busy peer", err);
+    ax25_link_set_busy(&station_b.link, false, 300);
+    wire_pump(300);
+    TEST_ASSERT(!station_a.link.peer_busy && station_b.rx_frames == 1 && station_a.link.tx_count == 0, "Sending should resume when the peer is ready",
+            err);
+
+    return 0;
+}
+
+int test_link_timer_recovery() {
+    printf("test_link_timer_recovery\n");
+    uint8_t err = 0;
+    ax25_link_config_t config;
+    ax25_link_config_default(&config);
+    stations_init(&config);
+    ax25_link_connect(&station_a.link, 0);
+    wire_pump(0);
+
+    // The last frame of a burst is lost: only T1 can recover it
+    uint8_t data[64];
+    fill_pattern(data, sizeof(data), 2);
+    station_a.drop_iframes = 1;
+    ax25_link_send(&station_a.link, PID_NO_L3, data, sizeof(data), 0);
+    wire_pump(0);
+    TEST_ASSERT(station_b.rx_frames == 0 && station_a.link.t1_running, "The lost frame should leave T1 running", err);
+
+    // The connection round trip took no time: T1 has already come down from its initial value
+    uint32_t t1 = station_a.link.t1v;
+    TEST_ASSERT(t1 < config.t1 && t1 >= config.t1_min, "T1 should adapt to the round trip time", err);
+    ax25_link_tick(&station_a.link, t1 - 1);
+    TEST_ASSERT(station_a.out_count == 0, "T1 should not expire early", err);
+    ax25_link_tick(&station_a.link, t1);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_TIMER_RECOVERY && station_a.out_count == 1 && station_a.out[0][14] == 0x11,
+            "T1 expiry should poll the peer with RR P=1", err);
+    uint32_t now = wire_run(t1, 500, 100);
+    TEST_ASSERT(station_b.rx_frames == 1 && memcmp(station_b.rx, data, sizeof(data)) == 0, "The frame should be resent after the poll", err);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_CONNECTED && station_a.link.rc == 0 && station_a.link.tx_count == 0,
+            "The link should return to the connected state", err);
+
+    // T3 polls an idle link
+    now += config.t3;
+    ax25_link_tick(&station_a.link, now);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_TIMER_RECOVERY && station_a.out_count == 1, "T3 expiry should poll the peer", err);
+    wire_pump(now);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_CONNECTED, "The answer should end timer recovery", err);
+
+    // Peer gone: N2 polls, then disconnect
+    station_b.deaf = true;
+    ax25_link_send(&station_a.link, PID_NO_L3, data, sizeof(data), now);
+    wire_run(now, 500, 1000);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_DISCONNECTED && station_has_event(&station_a, AX25_LINK_ERROR, AX25_LINK_ERROR_I)
+            && station_has_event(&station_a, AX25_LINK_DISCONNECT_INDICATION, 0), "Unacknowledged data should time out after N2 polls", err);
+
+    // Frames lost, then the peer stays busy: the polls go on until N2 gives up
+    stations_init(&config);
+    ax25_link_connect(&station_a.link, 0);
+    wire_pump(0);
+    station_a.drop_iframes = 2;
+    ax25_link_send(&station_a.link, PID_NO_L3, data, sizeof(data), 0);
+    ax25_link_send(&station_a.link, PID_NO_L3, data, sizeof(data), 0);
+    wire_pump(0);
+    now = station_a.link.t1v;
+    ax25_link_tick(&station_a.link, now);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_TIMER_RECOVERY, "T1 expiry should start timer recovery", err);
+    ax25_link_set_busy(&station_b.link, true, now);
+    wire_pump(now);
+    TEST_ASSERT(station_a.link.peer_busy && station_a.link.t1_running, "T1 should keep running after an RNR F=1 answer", err);
+    wire_run(now, 500, 1000);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_DISCONNECTED
+            && (station_has_event(&station_a, AX25_LINK_ERROR, AX25_LINK_ERROR_I) || station_has_event(&station_a, AX25_LINK_ERROR, AX25_LINK_ERROR_U)),
+            "A peer that stays busy should be given up after N2 polls", err);
+
+    return 0;
+}
+
+int test_link_modulo128() {
+    printf("test_link_modulo128\n");
+    uint8_t err = 0;
+    ax25_link_config_t config;
+    ax25_link_config_default(&config);
+    config.modulo128 = true;
+    config.k = 32;
+    stations_init(&config);
+    ax25_link_connect(&station_a.link, 0);
+    TEST_ASSERT(station_a.out[0][14] == 0x7F, "Modulo 128 should connect with SABME", err);
+    wire_pump(0);
+    TEST_ASSERT(station_b.link.modulo128 && station_a.link.state == AX25_LINK_CONNECTED, "SABME should select modulo 128 at both ends", err);
+
+    static uint8_t sent[100 * 100];
+    fill_pattern(sent, sizeof(sent), 3);
+    for (int i = 0; i < 100; i++)
+        ax25_link_send(&station_a.link, PID_NO_L3, sent + i * 100, 100, 0);
+    TEST_ASSERT(station_a.out_count == 32 && station_a.out_len[0] == 14 + 2 + 1 + 100, "A window of 32 two-byte control I-frames should go out", err);
+    wire_pump(0);
+    TEST_ASSERT(station_b.rx_frames == 100 && memcmp(station_b.rx, sent, sizeof(sent)) == 0 && station_a.link.vs == 100 && station_a.link.tx_count == 0,
+            "Every frame should arrive over the modulo 128 link", err);
+
+    // SREJ asks for a single frame again
+    station_b.rx_len = 0;
+    for (int i = 0; i < 4; i++)
+        ax25_link_send(&station_a.link, PID_NO_L3, sent + i * 100, 100, 10);
+    station_a.out_count = 0;
+    ax25_frame_storage_t srej;
+    uint8_t frame[32];
+    srej.base.type = AX25_FRAME_SUPERVISORY_SREJ_16BIT;
+    srej.base.header = station_b.link.header;
+    srej.base.header.cr = false;
+    srej.supervisory.code = 0x0C;
+    srej.supervisory.nr = 101;
+    srej.supervisory.pf = false;
+    size_t len = ax25_frame_encode_into(&srej.base, frame, sizeof(frame), &err);
+    ax25_link_receive(&station_a.link, frame, len, 10);
+    TEST_ASSERT(station_a.out_count == 1 && station_a.out[0][14] == (101 & 0x7F) << 1 && station_a.link.retransmissions == 1,
+            "SREJ should resend only the requested frame", err);
+    TEST_ASSERT(station_a.link.va == 100, "SREJ with F=0 should not acknowledge anything", err);
+
+    // A version 2.0 peer answers SABME with FRMR: retry with SABM
+    stations_init(&config);
+    ax25_link_connect(&station_a.link, 0);
+    station_a.out_count = 0;
+    ax25_frame_storage_t frmr;
+    memset(&frmr, 0, sizeof(frmr));
+    frmr.base.type = AX25_FRAME_UNNUMBERED_FRMR;
+    frmr.base.header = station_b.link.header;
+    frmr.base.header.cr = false;
+    frmr.frmr.base.modifier = 0x87;
+    frmr.frmr.base.pf = true;
+    frmr.frmr.frmr_control = 0x6F;
+    frmr.frmr.w = true;
+    len = ax25_frame_encode_into(&frmr.base, frame, sizeof(frame), &err);
+    ax25_link_receive(&station_a.link, frame, len, 0);
+    TEST_ASSERT(!station_a.link.modulo128 && station_a.out_count == 1 && station_a.out[0][14] == 0x3F, "FRMR to SABME should fall back to SABM", err);
+    wire_pump(0);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_CONNECTED && !station_b.link.modulo128, "The link should come up in modulo 8", err);
+
+    return 0;
+}
+
+int test_link_srej() {
+    printf("test_link_srej\n");
+    uint8_t err = 0;
+    ax25_link_config_t config;
+    ax25_link_config_default(&config);
+    config.modulo128 = true;
+    config.k = 32;
+    stations_init(&config);
+    ax25_link_connect(&station_a.link, 0);
+    wire_pump(0);
+
+    static uint8_t sent[32 * 64];
+    fill_pattern(sent, sizeof(sent), 5);
+
+    // Two frames of a burst lost: each is asked for once and resent alone
+    for (int i = 0; i < 12; i++)
+        ax25_link_send(&station_a.link, PID_NO_L3, sent + i * 64, 64, 0);
+    wire_drop(&station_a, 7);
+    wire_drop(&station_a, 2);
+    wire_deliver(&station_a, &station_b, 0);
+    TEST_ASSERT(station_b.link.vr == 2 && station_b.link.rx_held_count == 8 && station_b.rx_frames == 2, "Frames after a gap should be held", err);
+    // RR after each of frames 0 and 1, then SREJ 2 and SREJ 7
+    TEST_ASSERT(station_b.out_count == 4 && station_b.out[2][14] == 0x0D && station_b.out[2][15] == (2 << 1) && station_b.out[3][14] == 0x0D
+            && station_b.out[3][15] == (7 << 1), "Each missing frame should be requested once with SREJ", err);
+    wire_pump(0);
+    TEST_ASSERT(station_b.rx_frames == 12 && station_b.rx_len == 12 * 64 && memcmp(station_b.rx, sent, 12 * 64) == 0, "Frames should be delivered in order",
+            err);
+    TEST_ASSERT(station_a.link.retransmissions == 2 && station_a.link.tx_count == 0 && station_b.link.rx_held_count == 0,
+            "Only the lost frames should be sent again", err);
+
+    // The resent frame is lost too: T1 polls, the answer is an SREJ F=1 for it
+    station_b.rx_len = 0;
+    station_b.rx_frames = 0;
+    for (int i = 0; i < 6; i++)
+        ax25_link_send(&station_a.link, PID_NO_L3, sent + i * 64, 64, 0);
+    wire_drop(&station_a, 1);
+    wire_deliver(&station_a, &station_b, 0);
+    station_a.drop_iframes = 1;
+    wire_pump(0);
+    TEST_ASSERT(station_b.rx_frames == 1 && station_b.link.rx_held_count == 4 && station_a.link.t1_running, "The gap should remain until T1 expires", err);
+    wire_run(0, 500, 100);
+    TEST_ASSERT(station_b.rx_frames == 6 && memcmp(station_b.rx, sent, 6 * 64) == 0 && station_a.link.state == AX25_LINK_CONNECTED,
+            "The poll should recover the missing frame", err);
+    TEST_ASSERT(station_a.link.retransmissions == 4 && station_a.link.tx_count == 0, "Timer recovery should not go back N", err);
+
+    // Without SREJ the same loss costs the rest of the window
+    config.srej = false;
+    stations_init(&config);
+    ax25_link_connect(&station_a.link, 0);
+    wire_pump(0);
+    for (int i = 0; i < 12; i++)
+        ax25_link_send(&station_a.link, PID_NO_L3, sent + i * 64, 64, 0);
+    wire_drop(&station_a, 2);
+    wire_pump(0);
+    TEST_ASSERT(station_b.rx_frames == 12 && memcmp(station_b.rx, sent, 12 * 64) == 0 && station_a.link.retransmissions == 10,
+            "REJ should go back to the lost frame", err);
+
+    // A window wider than the reorder span: every I-frame reaches the peer twice, the copy
+    // after the original has been delivered, and no copy may pass for a later frame
+    config.srej = true;
+    config.k = 100;
+    config.n1 = 16;
+    stations_init(&config);
+    ax25_link_connect(&station_a.link, 0);
+    wire_pump(0);
+    static uint8_t copies[WIRE_FRAMES][WIRE_LEN];
+    static size_t copies_len[WIRE_FRAMES];
+    static uint8_t wide[200 * 16];
+    fill_pattern(wide, sizeof(wide), 7);
+    for (int batch = 0; batch < 2; batch++) {
+        for (int i = 0; i < 100; i++)
+            ax25_link_send(&station_a.link, PID_NO_L3, wide + (batch * 100 + i) * 16, 16, 0);
+        if (batch == 0)
+            TEST_ASSERT(station_a.out_count == AX25_LINK_MAX_REORDER, "The window should be capped at the reorder span", err);
+        for (int round = 0; round < 1000 && station_a.out_count + station_b.out_count > 0; round++) {
+            int count = station_a.out_count;
+            memcpy(copies, station_a.out, sizeof(copies[0]) * count);
+            memcpy(copies_len, station_a.out_len, sizeof(size_t) * count);
+            wire_deliver(&station_a, &station_b, 0);
+            for (int i = 0; i < count; i++)
+                ax25_link_receive(&station_b.link, copies[i], copies_len[i], 0);
+            wire_deliver(&station_b, &station_a, 0);
+        }
+    }
+    TEST_ASSERT(station_b.rx_frames == 200 && station_b.rx_len == sizeof(wide) && memcmp(station_b.rx, wide, sizeof(wide)) == 0,
+            "Old copies should not be delivered in place of new frames", err);
+
+    return 0;
+}
+
+int test_link_segments() {
+    printf("test_link_segments\n");
+    uint8_t err = 0;
+    ax25_link_config_t config;
+    ax25_link_config_default(&config);
+    stations_init(&config);
+    static uint8_t buffer[AX25_REASSEMBLY_MAX_LEN];
+    ax25_reassembler_t reassembler;
+    ax25_reassembler_init(&reassembler, buffer, sizeof(buffer));
+    ax25_link_set_reassembler(&station_b.link, &reassembler);
+    ax25_link_connect(&station_a.link, 0);
+    wire_pump(0);
+
+    // A payload of 40 segments, each sent as an I-frame with PID 0x08
+    static uint8_t sent[10000];
+    fill_pattern(sent, sizeof(sent), 6);
+    size_t num_segments;
+    ax25_segmented_info_t *segments = ax25_segment_info_fields(sent, sizeof(sent), config.n1 + 1, &err, &num_segments);
+    for (size_t i = 0; i < num_segments; i++)
+        ax25_link_send(&station_a.link, segments[i].info_field[0], segments[i].info_field + 1, segments[i].info_field_len - 1, 0);
+    ax25_free_segmented_info(segments, num_segments);
+    wire_pump(0);
+    TEST_ASSERT(num_segments == 40 && station_b.rx_frames == 1 && station_b.rx_len == sizeof(sent) && memcmp(station_b.rx, sent, sizeof(sent)) == 0,
+            "Segments should be delivered as one payload", err);
+    TEST_ASSERT(reassembler.payloads == 1 && reassembler.errors == 0, "The link reassembler should count the payload", err);
+
+    // Without a reassembler segments are delivered as received
+    station_b.rx_frames = 0;
+    ax25_link_set_reassembler(&station_b.link, NULL);
+    ax25_link_send(&station_a.link, PID_SEGMENTATION, (const uint8_t* ) "\xC0\x00\x01x", 4, 0);
+    wire_pump(0);
+    TEST_ASSERT(station_b.rx_frames == 1 && reassembler.payloads == 1, "Segments should pass through without a reassembler", err);
+
+    return 0;
+}
+
+int test_link_wheel() {
+    printf("test_link_wheel\n");
+    uint8_t err = 0;
+    static timer_wheel_t wheel;
+    ax25_link_config_t config;
+    ax25_link_config_default(&config);
+    config.t2 = 500;
+    stations_init(&config);
+    timer_wheel_init(&wheel, 10, 0);
+    TEST_ASSERT(ax25_link_set_wheel(&station_a.link, &wheel) == 0 && ax25_link_set_wheel(&station_b.link, &wheel) == 0,
+            "Idle links should move to the wheel", err);
+
+    ax25_link_connect(&station_a.link, 0);
+    TEST_ASSERT(wheel.count == 1 && timer_wheel_armed(&station_a.link.t1_timer), "T1 should be armed on the wheel", err);
+    TEST_ASSERT(ax25_link_set_wheel(&station_a.link, NULL) == -1, "A link with a timer running should keep its wheel", err);
+    wire_pump(0);
+    TEST_ASSERT(wheel.count == 2 && !timer_wheel_armed(&station_a.link.t1_timer) && timer_wheel_armed(&station_a.link.t3_timer),
+            "T1 should be cancelled and both T3 armed once connected", err);
+
+    // Every I-frame is acknowledged one second later: T1 converges on twice the round trip
+    uint8_t data[32];
+    fill_pattern(data, sizeof(data), 4);
+    uint32_t now = 0;
+    bool delayed = true;
+    for (int i = 0; i < 40; i++) {
+        ax25_link_send(&station_a.link, PID_NO_L3, data, sizeof(data), now);
+        wire_deliver(&station_a, &station_b, now + 500);
+        delayed &= (station_b.out_count == 0);
+        now += 1000;
+        timer_wheel_advance(&wheel, now);
+        wire_deliver(&station_b, &station_a, now);
+    }
+    TEST_ASSERT(delayed, "T2 should delay the acknowledgements", err);
+    TEST_ASSERT(station_b.rx_frames == 40 && station_a.link.tx_count == 0 && station_a.link.retransmissions == 0, "Every frame should be acknowledged",
+            err);
+    TEST_ASSERT(station_a.link.t1v >= 2000 && station_a.link.t1v <= 2100, "T1 should be twice the smoothed round trip time", err);
+
+    // Several I-frames within T2 share one RR
+    for (int i = 0; i < 3; i++)
+        ax25_link_send(&station_a.link, PID_NO_L3, data, sizeof(data), now);
+    wire_deliver(&station_a, &station_b, now);
+    timer_wheel_advance(&wheel, now + 490);
+    TEST_ASSERT(station_b.out_count == 0, "No acknowledgement should go out before T2 expires", err);
+    timer_wheel_advance(&wheel, now + 500);
+    TEST_ASSERT(station_b.out_count == 1 && station_b.out[0][14] == ((station_b.link.vr << 5) | 0x01), "One RR should acknowledge the three frames",
+            err);
+    now += 500;
+    wire_pump(now);
+
+    // The wheel drives T1 recovery, rounded up to its 10 ms tick
+    uint32_t t1 = (station_a.link.t1v + 9) / 10 * 10;
+    station_b.deaf = true;
+    ax25_link_send(&station_a.link, PID_NO_L3, data, sizeof(data), now);
+    station_a.out_count = 0;
+    ax25_link_tick(&station_a.link, now + t1);
+    TEST_ASSERT(station_a.out_count == 0, "Polling should do nothing for a link on a wheel", err);
+    timer_wheel_advance(&wheel, now + t1);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_TIMER_RECOVERY && station_a.out_count == 1 && station_a.out[0][14] == 0x11,
+            "T1 expiry on the wheel should poll the peer", err);
+    for (uint32_t t = now + t1; station_a.link.state != AX25_LINK_DISCONNECTED && t - now < 1000000; t += 1000)
+        timer_wheel_advance(&wheel, t);
+    TEST_ASSERT(station_a.link.state == AX25_LINK_DISCONNECTED && station_has_event(&station_a, AX25_LINK_ERROR, AX25_LINK_ERROR_I),
+            "The wheel should run the N2 retries", err);
+    TEST_ASSERT(!timer_wheel_armed(&station_a.link.t1_timer) && !timer_wheel_armed(&station_a.link.t2_timer)
+            && !timer_wheel_armed(&station_a.link.t3_timer), "A disconnected link should leave nothing on the wheel", err);
+
+    return 0;
+}
+
+int test_ax25_link_main() {
+    int result = 0;
+    printf("\n----------------------------------------------------------------------------------\n");
+    printf("Starting AX.25 Link Tests\n");
+    printf("----------------------------------------------------------------------------------\n\n");
+    result |= test_link_connect();
+    result |= test_link_transfer();
+    result |= test_link_timer_recovery();
+    result |= test_link_modulo128();
+    result |= test_link_srej();
+    result |= test_link_segments();
+    result |= test_link_wheel();
+    printf("\n----------------------------------------------------------------------------------\n");
+    printf("Tests AX.25 Link Completed. %s\n", result == 0 ? "All tests passed" : "Some tests failed");
+    printf("----------------------------------------------------------------------------------\n\n");
+    return result;
+}
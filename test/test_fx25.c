@@ -0,0 +1,222 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "test_common.h"
+#include "hdlc.h"
+#include "fx25.h"
+
+static uint32_t assert_count = 0;
+static uint32_t rng_state = 12345;
+
+static uint32_t fx25_test_rand(void) {
+    rng_state = rng_state * 1103515245 + 12345;
+    return rng_state >> 16;
+}
+
+// Adds errors at distinct random positions
+static void corrupt(unsigned char *block, int n, int errors) {
+    bool hit[FX25_MAX_BLOCK_LEN] = { false };
+    for (int e = 0; e < errors; e++) {
+        int pos;
+        do {
+            pos = fx25_test_rand() % n;
+        } while (hit[pos]);
+        hit[pos] = true;
+        block[pos] ^= 1 + fx25_test_rand() % 255;
+    }
+}
+
+int test_fx25_rs() {
+    printf("test_fx25_rs\n");
+    uint8_t err = 0;
+
+    // Every mode: clean blocks pass untouched, up to nroots / 2 errors are corrected
+    bool clean_ok = true, corrected_ok = true, rejected_ok = true;
+    for (int tag = 1; tag <= 0x0B; tag++) {
+        const fx25_mode_t *mode = fx25_mode_get(tag);
+        int nroots = mode->n - mode->k;
+        for (int trial = 0; trial < 20; trial++) {
+            unsigned char block[FX25_MAX_BLOCK_LEN], original[FX25_MAX_BLOCK_LEN];
+            for (int i = 0; i < mode->k; i++) {
+                block[i] = fx25_test_rand() & 0xFF;
+            }
+            fx25_rs_encode(block, mode->k, block + mode->k, nroots);
+            memcpy(original, block, mode->n);
+
+            clean_ok &= (fx25_rs_decode(block, mode->n, nroots) == 0 && memcmp(block, original, mode->n) == 0);
+
+            int errors = 1 + trial % (nroots / 2);
+            corrupt(block, mode->n, errors);
+            int result = fx25_rs_decode(block, mode->n, nroots);
+            corrected_ok &= (result == errors && memcmp(block, original, mode->n) == 0);
+
+            // Beyond the capacity the block must never be returned as the original
+            memcpy(block, original, mode->n);
+            corrupt(block, mode->n, nroots / 2 + 1);
+            result = fx25_rs_decode(block, mode->n, nroots);
+            rejected_ok &= (result == -1 || memcmp(block, original, mode->n) != 0);
+        }
+    }
+    TEST_ASSERT(clean_ok, "Clean codeblocks should decode with no correction", err);
+    TEST_ASSERT(corrected_ok, "Up to nroots / 2 byte errors should be corrected in every mode", err);
+    TEST_ASSERT(rejected_ok, "Too many errors should not silently restore the block", err);
+
+    unsigned char block[64] = { 0 };
+    TEST_ASSERT(fx25_rs_decode(block, 64, 20) == -1, "An unsupported number of check bytes should be rejected", err);
+
+    return 0;
+}
+
+int test_fx25_mode() {
+    printf("test_fx25_mode\n");
+    uint8_t err = 0;
+
+    TEST_ASSERT(fx25_mode_get(0x00) == NULL && fx25_mode_get(0x0C) == NULL, "Reserved and undefined tags have no mode", err);
+    TEST_ASSERT(fx25_mode_get(0x01)->value == 0xB74DB7DF8A532F3EULL && fx25_mode_get(0x01)->k == 239, "Tag_01 is RS(255,239)", err);
+    TEST_ASSERT(fx25_mode_select(30, 16)->tag == 0x04, "A short frame with 16 check bytes uses RS(48,32)", err);
+    TEST_ASSERT(fx25_mode_select(33, 16)->tag == 0x03, "One byte more moves to RS(80,64)", err);
+    TEST_ASSERT(fx25_mode_select(100, 32)->tag == 0x06, "100 bytes with 32 check bytes use RS(160,128)", err);
+    TEST_ASSERT(fx25_mode_select(191, 64)->tag == 0x09, "191 bytes with 64 check bytes use RS(255,191)", err);
+    TEST_ASSERT(fx25_mode_select(192, 64) == NULL, "Frames longer than the largest mode are rejected", err);
+    TEST_ASSERT(fx25_mode_select(10, 24) == NULL, "Check sizes other than 16, 32 and 64 are rejected", err);
+
+    return 0;
+}
+
+typedef struct {
+    int count;
+    int len;
+    unsigned char frame[256];
+} fx25_capture_t;
+
+static void fx25_capture(const unsigned char *frame, int frameLen, void *ctx) {
+    fx25_capture_t *cap = (fx25_capture_t*) ctx;
+    if (frameLen <= (int) sizeof(cap->frame)) {
+        memcpy(cap->frame, frame, frameLen);
+        cap->len = frameLen;
+    }
+    cap->count++;
+}
+
+int test_fx25_frame() {
+    printf("test_fx25_frame\n");
+    uint8_t err = 0;
+
+    uint8_t ui_frame[] = { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0, 'F', 'X', '2', '5', '!', 0x7E, 0xFF };
+    unsigned char out[FX25_MAX_FRAME_LEN];
+    unsigned char stuffed[64];
+    int outLen, stuffedLen;
+
+    TEST_ASSERT(fx25_frame_encode(ui_frame, sizeof(ui_frame), 16, out, &outLen) == 0, "fx25_frame_encode should succeed", err);
+    hdlc_frame_encode_fast(ui_frame, sizeof(ui_frame), stuffed, &stuffedLen);
+    const fx25_mode_t *mode = fx25_mode_select(stuffedLen, 16);
+    TEST_ASSERT(outLen == FX25_TAG_LEN + mode->n, "Output should hold the tag and the whole codeblock", err);
+    const unsigned char tag01[] = { 0x3E, 0x2F, 0x53, 0x8A, 0xDF, 0xB7, 0x4D, 0xB7 };
+    unsigned char tag[FX25_TAG_LEN];
+    for (int i = 0; i < FX25_TAG_LEN; i++) {
+        tag[i] = ReverseBits(out[i]);
+    }
+    bool tag01_order = true;
+    for (int i = 0; i < FX25_TAG_LEN; i++) {
+        tag01_order &= (((fx25_mode_get(0x01)->value >> (8 * i)) & 0xFF) == tag01[i]);
+    }
+    TEST_ASSERT(tag01_order, "Tag_01 should be sent as 3E 2F 53 8A DF B7 4D B7", err);
+    TEST_ASSERT(tag[0] == (mode->value & 0xFF) && tag[7] == (mode->value >> 56), "Tag bytes should be sent least significant first", err);
+    TEST_ASSERT(memcmp(out + FX25_TAG_LEN, stuffed, stuffedLen) == 0, "Codeblock should start with the HDLC encoded frame", err);
+
+    unsigned char legacy[FX25_MAX_FRAME_LEN];
+    int legacyLen;
+    int result = hdlc_frame_decode_fast(out + FX25_TAG_LEN, mode->k, legacy, &legacyLen);
+    TEST_ASSERT(result == 0 && legacyLen == sizeof(ui_frame) && memcmp(legacy, ui_frame, sizeof(ui_frame)) == 0,
+            "Receivers without FX.25 should still decode the frame", err);
+
+    unsigned char big[250] = { 0 };
+    TEST_ASSERT(fx25_frame_encode(big, sizeof(big), 16, out, &outLen) == -1, "Frames too long for any mode should be rejected", err);
+    TEST_ASSERT(fx25_frame_encode(ui_frame, sizeof(ui_frame), 8, out, &outLen) == -1, "Invalid check size should be rejected", err);
+
+    // Over the air: preamble, tag with bit errors, corrupted codeblock, at every bit alignment
+    bool all_recovered = true;
+    fx25_rx_t *rx = malloc(sizeof(fx25_rx_t));
+    for (int checkBytes = 16; checkBytes <= 64; checkBytes *= 2) {
+        fx25_frame_encode(ui_frame, sizeof(ui_frame), checkBytes, out, &outLen);
+        mode = fx25_mode_select(stuffedLen, checkBytes);
+        for (int shift = 0; shift < 8; shift++) {
+            unsigned char stream[2 * FX25_MAX_FRAME_LEN], shifted[2 * FX25_MAX_FRAME_LEN + 1];
+            int streamLen = 0;
+            memset(stream, 0x7E, 8);
+            streamLen += 8;
+            memcpy(stream + streamLen, out, outLen);
+            stream[streamLen + 2] ^= 0x41;
+            stream[streamLen + 6] ^= 0x08;
+            corrupt(stream + streamLen + FX25_TAG_LEN, mode->n, checkBytes / 2);
+            streamLen += outLen;
+            memset(stream + streamLen, 0x7E, 4);
+            streamLen += 4;
+            for (int i = 0; i <= streamLen; i++) {
+                unsigned int prev = (i > 0) ? stream[i - 1] : 0x7E;
+                unsigned int cur = (i < streamLen) ? stream[i] : 0x7E;
+                shifted[i] = (uint8_t) ((((prev << 8) | cur) >> shift) & 0xFF);
+            }
+
+            fx25_capture_t cap = { 0 };
+            fx25_rx_init(rx, fx25_capture, &cap);
+            int delivered = 0;
+            for (int pos = 0; pos <= streamLen; pos += 7) {
+                delivered += fx25_rx_push(rx, shifted + pos, (streamLen + 1 - pos < 7) ? streamLen + 1 - pos : 7);
+            }
+            all_recovered &= (delivered == 1 && cap.count == 1 && cap.len == sizeof(ui_frame) && memcmp(cap.frame, ui_frame, sizeof(ui_frame)) == 0);
+            all_recovered &= (rx->blocks == 1 && rx->corrected == (uint32_t) checkBytes / 2 && rx->failures == 0);
+        }
+    }
+    TEST_ASSERT(all_recovered, "Receiver should correct the codeblock and deliver the frame at every alignment", err);
+
+    // One byte error too many
+    fx25_frame_encode(ui_frame, sizeof(ui_frame), 16, out, &outLen);
+    mode = fx25_mode_select(stuffedLen, 16);
+    corrupt(out + FX25_TAG_LEN, mode->n, 9);
+    fx25_capture_t cap = { 0 };
+    fx25_rx_init(rx, fx25_capture, &cap);
+    fx25_rx_push(rx, out, outLen);
+    TEST_ASSERT(cap.count == 0 && rx->failures + rx->blocks == 1, "An uncorrectable codeblock should not deliver a wrong frame", err);
+    free(rx);
+
+    return 0;
+}
+
+int test_fx25_main() {
+    int result = 0;
+    printf("\n----------------------------------------------------------------------------------\n");
+    printf("Starting FX.25 Tests\n");
+    printf("----------------------------------------------------------------------------------\n\n");
+    result |= test_fx25_rs();
+    result |= test_fx25_mode();
+    result |= test_fx25_frame();
+    printf("\n----------------------------------------------------------------------------------\n");
+    printf("Tests FX.25 Completed. %s\n", result == 0 ? "All tests passed" : "Some tests failed");
+    printf("----------------------------------------------------------------------------------\n\n");
+    return result;
+}
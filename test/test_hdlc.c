@@ -28,6 +28,7 @@
 #include "test_common.h"
 #include "ax25.h"
 #include "hdlc.h"
+#include "common.h"
 
 static uint32_t assert_count = 0;
 
@@ -239,12 +240,773 @@ int test_hdlc() {
     return 0;
 }
 
+typedef struct {
+    int count;
+    int lens[8];
+    unsigned char frames[8][300];
+} deframer_capture_t;
+
+static void deframer_capture(const unsigned char *frame, int frameLen, void *ctx) {
+    deframer_capture_t *cap = (deframer_capture_t*) ctx;
+    if (cap->count < 8 && frameLen <= 300) {
+        memcpy(cap->frames[cap->count], frame, frameLen);
+        cap->lens[cap->count] = frameLen;
+    }
+    cap->count++;
+}
+
+int test_hdlc_deframer() {
+    printf("test_hdlc_deframer\n");
+    uint8_t err = 0;
+
+    uint8_t ui_frame[] = { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0, 'T', 'E', 'S', 'T' };
+    uint8_t i_frame[] = { 0xAC, 0x82, 0x66, 0x84, 0x84, 0x84, 0xEE, 0xAC, 0x82, 0x66, 0x82, 0x82, 0x82, 0x63, 0x00, 0xF0, 'H', 'e', 'l', 'l', 'o' };
+    uint8_t stuff_frame[] = { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0, 0x1F, 0xFF, 0xFF, 0x1F };
+    uint8_t *frames[] = { ui_frame, i_frame, stuff_frame };
+    size_t lens[] = { sizeof(ui_frame), sizeof(i_frame), sizeof(stuff_frame) };
+
+    // Build a continuous bitstream: idle flags, three frames, an aborted frame, a corrupted frame
+    unsigned char stream[1024];
+    int streamLen = 0;
+    stream[streamLen++] = 0x7E;
+    stream[streamLen++] = 0x7E;
+    for (int f = 0; f < 3; f++) {
+        unsigned char copy[64];
+        int encodedLen;
+        memcpy(copy, frames[f], lens[f]);
+        hdlc_frame_encode(copy, lens[f], stream + streamLen, &encodedLen);
+        streamLen += encodedLen;
+    }
+    {
+        unsigned char copy[64];
+        int encodedLen;
+        memcpy(copy, ui_frame, sizeof(ui_frame));
+        hdlc_frame_encode(copy, sizeof(ui_frame), stream + streamLen, &encodedLen);
+        stream[streamLen + encodedLen / 2] = 0xFF; // Abort in the middle of the frame
+        streamLen += encodedLen;
+        memcpy(copy, i_frame, sizeof(i_frame));
+        hdlc_frame_encode(copy, sizeof(i_frame), stream + streamLen, &encodedLen);
+        stream[streamLen + 5] ^= 0x10;             // Corrupt one bit, FCS must fail
+        streamLen += encodedLen;
+    }
+
+    // Whole stream in one call
+    {
+        deframer_capture_t cap = { 0 };
+        hdlc_deframer_t deframer;
+        hdlc_deframer_init(&deframer, deframer_capture, &cap);
+        int delivered = hdlc_deframer_push(&deframer, stream, streamLen);
+        TEST_ASSERT(delivered == 3, "hdlc_deframer_push should deliver three frames", err);
+        TEST_ASSERT(cap.count == 3, "Callback should be called three times", err);
+        for (int f = 0; f < 3 && f < cap.count; f++) {
+            COMPARE_FRAME(cap.frames[f], (size_t )cap.lens[f], frames[f], lens[f], "Deframed frame should match original");
+        }
+        TEST_ASSERT(deframer.frames == 3, "Deframer should count three frames", err);
+        TEST_ASSERT(deframer.aborts >= 1, "Deframer should count the abort sequence", err);
+        TEST_ASSERT(deframer.fcsErrors >= 1, "Deframer should count the FCS error", err);
+    }
+
+    // Same stream split in chunks of every size from 1 to 9 bytes
+    for (int chunk = 1; chunk <= 9; chunk++) {
+        deframer_capture_t cap = { 0 };
+        hdlc_deframer_t deframer;
+        hdlc_deframer_init(&deframer, deframer_capture, &cap);
+        int delivered = 0;
+        for (int pos = 0; pos < streamLen; pos += chunk) {
+            int n = (streamLen - pos < chunk) ? streamLen - pos : chunk;
+            delivered += hdlc_deframer_push(&deframer, stream + pos, n);
+        }
+        bool match = (delivered == 3 && cap.count == 3);
+        for (int f = 0; match && f < 3; f++) {
+            match = (cap.lens[f] == (int) lens[f] && memcmp(cap.frames[f], frames[f], lens[f]) == 0);
+        }
+        TEST_ASSERT(match, "Chunked deframing should deliver the same three frames", err);
+    }
+
+    // Reset drops a partial frame
+    {
+        deframer_capture_t cap = { 0 };
+        hdlc_deframer_t deframer;
+        hdlc_deframer_init(&deframer, deframer_capture, &cap);
+        hdlc_deframer_push(&deframer, stream, 12);
+        hdlc_deframer_reset(&deframer);
+        hdlc_deframer_push(&deframer, stream + 12, streamLen - 12);
+        TEST_ASSERT(cap.count == 2, "Frame interrupted by reset should be dropped, following frames delivered", err);
+        if (cap.count == 2) {
+            COMPARE_FRAME(cap.frames[0], (size_t )cap.lens[0], i_frame, sizeof(i_frame), "First frame after reset should be the I-frame");
+        }
+    }
+
+    return 0;
+}
+
+int test_hdlc_decode_fast() {
+    printf("test_hdlc_decode_fast\n");
+    uint8_t err = 0;
+    uint32_t seed = 12345;
+
+    // Table-driven decoder must agree with the bit-serial reference on random frames
+    bool all_match = true;
+    bool all_fail = true;
+    for (int n = 0; n < 200; n++) {
+        unsigned char frame[300];
+        unsigned char copy[302];
+        int frameLen = 1 + n;
+        for (int i = 0; i < frameLen; i++) {
+            seed = seed * 1103515245 + 12345;
+            // Bias towards 1 bits so that bit stuffing happens often
+            frame[i] = (n & 1) ? (uint8_t) (seed >> 16) | 0xF8 : (uint8_t) (seed >> 16);
+        }
+        memcpy(copy, frame, frameLen);
+        unsigned char encodedFrame[1024];
+        int encodedLen;
+        hdlc_frame_encode(copy, frameLen, encodedFrame, &encodedLen);
+
+        unsigned char refFrame[1024], fastFrame[1024];
+        int refLen = -1, fastLen = -1;
+        int refResult = hdlc_frame_decode(encodedFrame, encodedLen, refFrame, &refLen);
+        int fastResult = hdlc_frame_decode_fast(encodedFrame, encodedLen, fastFrame, &fastLen);
+        if (refResult != 0 || fastResult != 0 || refLen != fastLen || fastLen != frameLen || memcmp(fastFrame, frame, frameLen) != 0)
+            all_match = false;
+
+        encodedFrame[1 + (n % (encodedLen - 2))] ^= (uint8_t) (1 << (n % 8));
+        if (hdlc_frame_decode_fast(encodedFrame, encodedLen, fastFrame, &fastLen) == 0)
+            all_fail = false;
+    }
+    TEST_ASSERT(all_match, "hdlc_frame_decode_fast should match hdlc_frame_decode on 200 random frames", err);
+    TEST_ASSERT(all_fail, "hdlc_frame_decode_fast should reject frames with a flipped bit", err);
+
+    // Leading flag fill before the frame
+    {
+        uint8_t ax25_ui_frame[] = { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0, 'T', 'E', 'S', 'T' };
+        unsigned char copy[sizeof(ax25_ui_frame) + 2];
+        unsigned char stream[1024] = { 0x7E, 0x7E, 0x7E };
+        int encodedLen;
+        memcpy(copy, ax25_ui_frame, sizeof(ax25_ui_frame));
+        hdlc_frame_encode(copy, sizeof(ax25_ui_frame), stream + 3, &encodedLen);
+        unsigned char decodedFrame[1024];
+        int decodedLen;
+        int decode_result = hdlc_frame_decode_fast(stream, encodedLen + 3, decodedFrame, &decodedLen);
+        TEST_ASSERT(decode_result == 0, "hdlc_frame_decode_fast should skip leading flag fill", err);
+        COMPARE_FRAME(decodedFrame, (size_t )decodedLen, ax25_ui_frame, sizeof(ax25_ui_frame), "Decoded frame after flag fill should match original");
+    }
+
+    // Abort inside the frame
+    {
+        uint8_t abort_frame[] = { 0x7E, 0x12, 0x34, 0xFF, 0x56, 0x7E };
+        unsigned char decodedFrame[64];
+        int decodedLen;
+        TEST_ASSERT(hdlc_frame_decode_fast(abort_frame, sizeof(abort_frame), decodedFrame, &decodedLen) != 0, "hdlc_frame_decode_fast should fail on abort",
+                err);
+    }
+
+    // No flags
+    {
+        uint8_t no_flags_frame[] = { 0x00, 0x01, 0x02, 0x03 };
+        unsigned char decodedFrame[64];
+        int decodedLen;
+        TEST_ASSERT(hdlc_frame_decode_fast(no_flags_frame, sizeof(no_flags_frame), decodedFrame, &decodedLen) != 0,
+                "hdlc_frame_decode_fast should fail for frame with no flags", err);
+    }
+
+    return 0;
+}
+
+int test_hdlc_encode_fast() {
+    printf("test_hdlc_encode_fast\n");
+    uint8_t err = 0;
+    uint32_t seed = 54321;
+
+    // Table-driven encoder must produce the same bitstream as the bit-serial encoder
+    bool all_match = true;
+    bool input_kept = true;
+    for (int n = 0; n < 300; n++) {
+        unsigned char frame[300];
+        unsigned char copy[302];
+        int frameLen = n;
+        for (int i = 0; i < frameLen; i++) {
+            seed = seed * 1103515245 + 12345;
+            frame[i] = (n % 3 == 0) ? 0xFF : (n % 3 == 1) ? (uint8_t) (seed >> 16) | 0x7C : (uint8_t) (seed >> 16);
+        }
+        memcpy(copy, frame, frameLen);
+        unsigned char refFrame[1024], fastFrame[1024];
+        int refLen, fastLen;
+        hdlc_frame_encode(copy, frameLen, refFrame, &refLen);
+        memcpy(copy, frame, frameLen);
+        hdlc_frame_encode_fast(copy, frameLen, fastFrame, &fastLen);
+        if (refLen != fastLen || memcmp(refFrame, fastFrame, refLen) != 0)
+            all_match = false;
+        if (memcmp(copy, frame, frameLen) != 0)
+            input_kept = false;
+        if (fastLen > (frameLen + 2) * 6 / 5 + 4)
+            all_match = false;
+    }
+    TEST_ASSERT(all_match, "hdlc_frame_encode_fast should match hdlc_frame_encode on 300 frames", err);
+    TEST_ASSERT(input_kept, "hdlc_frame_encode_fast should not modify the input frame", err);
+
+    // Retransmitting the same const frame with hdlc_frame_encode needs no copy
+    {
+        static const unsigned char beacon[] = { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0, 'B', 'C',
+                'N' };
+        unsigned char first[128], second[128];
+        int firstLen, secondLen;
+        hdlc_frame_encode(beacon, sizeof(beacon), first, &firstLen);
+        hdlc_frame_encode(beacon, sizeof(beacon), second, &secondLen);
+        COMPARE_FRAME(second, (size_t )secondLen, first, (size_t )firstLen, "Encoding the same frame twice should give the same bitstream");
+        unsigned char decodedFrame[128];
+        int decodedLen;
+        TEST_ASSERT(hdlc_frame_decode(second, secondLen, decodedFrame, &decodedLen) == 0, "Retransmitted frame should decode", err);
+        COMPARE_FRAME(decodedFrame, (size_t )decodedLen, beacon, sizeof(beacon), "Retransmitted frame should match original");
+    }
+
+    // Round trip through the table-driven decoder
+    {
+        uint8_t ax25_bitstuff_frame[] =
+                { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0, 0x1F, 0x1F, 0x1F, 0x1F };
+        unsigned char encodedFrame[1024];
+        int encodedLen;
+        hdlc_frame_encode_fast(ax25_bitstuff_frame, sizeof(ax25_bitstuff_frame), encodedFrame, &encodedLen);
+        unsigned char decodedFrame[1024];
+        int decodedLen;
+        int decode_result = hdlc_frame_decode_fast(encodedFrame, encodedLen, decodedFrame, &decodedLen);
+        TEST_ASSERT(decode_result == 0, "hdlc_frame_decode_fast should decode hdlc_frame_encode_fast output", err);
+        COMPARE_FRAME(decodedFrame, (size_t )decodedLen, ax25_bitstuff_frame, sizeof(ax25_bitstuff_frame), "Round trip frame should match original");
+    }
+
+    return 0;
+}
+
+int test_crc_kernels() {
+    printf("test_crc_kernels\n");
+    uint8_t err = 0;
+    uint32_t seed = 2468;
+
+    // Known answer: CRC() is CRC-16/GENIBUS, check value of "123456789" is 0xD64E
+    unsigned char check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT(crc_set_kernel(CRC_KERNEL_TABLE), "Table kernel should always be available", err);
+    TEST_ASSERT(CRC(check, sizeof(check)) == 0xD64E, "Table kernel should match the CRC-CCITT check value", err);
+
+    // Every kernel must agree with the table kernel on all lengths and alignments
+    unsigned char data[600];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (uint8_t) (seed >> 16);
+    }
+    uint16_t ref[520];
+    for (int len = 0; len < 520; len++) {
+        ref[len] = CRC(data + (len % 7), len);
+    }
+
+    crc_kernel_t kernels[] = { CRC_KERNEL_SLICE8, CRC_KERNEL_PCLMUL, CRC_KERNEL_AUTO };
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (!crc_set_kernel(kernels[k])) {
+            printf("  kernel %d not supported, skipped\n", kernels[k]);
+            continue;
+        }
+        bool match = true;
+        for (int len = 0; len < 520; len++) {
+            if (CRC(data + (len % 7), len) != ref[len])
+                match = false;
+        }
+        TEST_ASSERT(match, "CRC kernel should match the table kernel on every length", err);
+    }
+    TEST_ASSERT(crc_get_kernel() != CRC_KERNEL_AUTO, "Automatic selection should resolve to a concrete kernel", err);
+
+    return 0;
+}
+
+int test_crc_stream() {
+    printf("test_crc_stream\n");
+    uint8_t err = 0;
+    uint32_t seed = 13579;
+
+    // Known answer: CRC-16/X-25 of "123456789" is 0x906E
+    {
+        crc_ctx_t ctx;
+        crc_init(&ctx);
+        crc_update(&ctx, (const unsigned char*) "123456789", 9);
+        TEST_ASSERT(crc_final(&ctx) == 0x906E, "crc_final should match the CRC-16/X-25 check value", err);
+    }
+
+    unsigned char data[300];
+    unsigned char reversed[300];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (uint8_t) (seed >> 16);
+        reversed[i] = ReverseBits(data[i]);
+    }
+
+    // Any split into fragments must give the FCS that CRC() computes on the reversed frame
+    bool match = true;
+    bool split_match = true;
+    for (int len = 0; len <= 300; len += 7) {
+        crc_ctx_t whole;
+        crc_init(&whole);
+        crc_update(&whole, data, len);
+        uint16_t fcs = crc_final(&whole);
+        uint16_t ref = CRC(reversed, len);
+        if (ReverseBits(fcs & 0xFF) != (ref >> 8) || ReverseBits(fcs >> 8) != (ref & 0xFF))
+            match = false;
+
+        for (int cut = 0; cut <= len; cut += 5) {
+            crc_ctx_t ctx;
+            crc_init(&ctx);
+            crc_update(&ctx, data, cut / 2);
+            crc_update(&ctx, data + cut / 2, cut - cut / 2);
+            crc_update(&ctx, data + cut, 0);
+            crc_update(&ctx, data + cut, len - cut);
+            if (crc_final(&ctx) != fcs)
+                split_match = false;
+        }
+    }
+    TEST_ASSERT(match, "crc_final should agree with CRC() on the bit-reversed frame", err);
+    TEST_ASSERT(split_match, "crc_update over fragments should match a single update", err);
+
+    return 0;
+}
+
+typedef struct {
+    int count[4];
+    bool match;
+} multi_rx_capture_t;
+
+static void multi_rx_capture(int channel, const unsigned char *frame, int frameLen, void *ctx) {
+    multi_rx_capture_t *cap = (multi_rx_capture_t*) ctx;
+    // Every frame carries its channel and sequence number in the last two bytes
+    if (channel < 0 || channel >= 4 || frameLen != 18 || frame[16] != channel || frame[17] != cap->count[channel])
+        cap->match = false;
+    if (channel >= 0 && channel < 4)
+        cap->count[channel]++;
+}
+
+int test_hdlc_multi_rx() {
+    printf("test_hdlc_multi_rx\n");
+    uint8_t err = 0;
+
+    // Each channel gets its own stream of frames tagged with the channel number
+    static unsigned char streams[4][1024];
+    int streamLen[4] = { 0 };
+    for (int ch = 0; ch < 4; ch++) {
+        for (int f = 0; f < 1 + ch; f++) {
+            streams[ch][streamLen[ch]++] = 0x7E;
+        }
+        for (int f = 0; f < 5; f++) {
+            unsigned char frame[18] = { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0 };
+            frame[16] = ch;
+            frame[17] = f;
+            int encodedLen;
+            hdlc_frame_encode(frame, sizeof(frame), streams[ch] + streamLen[ch], &encodedLen);
+            streamLen[ch] += encodedLen;
+        }
+    }
+
+    multi_rx_capture_t cap = { { 0 }, true };
+    hdlc_multi_rx_t *mrx = malloc(sizeof(hdlc_multi_rx_t));
+    TEST_ASSERT(hdlc_multi_rx_init(mrx, HDLC_MAX_CHANNELS + 1, multi_rx_capture, &cap) == -1, "Too many channels should be rejected", err);
+    TEST_ASSERT(hdlc_multi_rx_init(mrx, 4, multi_rx_capture, &cap) == 0, "hdlc_multi_rx_init should succeed for 4 channels", err);
+
+    // Interleave blocks of a different size on every channel
+    int pos[4] = { 0 };
+    int delivered = 0;
+    bool pending = true;
+    while (pending) {
+        const unsigned char *data[4];
+        int len[4];
+        pending = false;
+        for (int ch = 0; ch < 4; ch++) {
+            int chunk = 3 + 2 * ch;
+            len[ch] = (streamLen[ch] - pos[ch] < chunk) ? streamLen[ch] - pos[ch] : chunk;
+            data[ch] = (len[ch] > 0) ? streams[ch] + pos[ch] : NULL;
+            pos[ch] += len[ch];
+            pending |= (pos[ch] < streamLen[ch]);
+        }
+        delivered += hdlc_multi_rx_push(mrx, data, len);
+    }
+
+    TEST_ASSERT(delivered == 20, "hdlc_multi_rx_push should deliver five frames per channel", err);
+    TEST_ASSERT(cap.match, "Frames should be tagged with their channel and arrive in order", err);
+    bool counts = true;
+    for (int ch = 0; ch < 4; ch++) {
+        counts &= (cap.count[ch] == 5 && mrx->frames[ch] == 5 && mrx->fcsErrors[ch] == 0);
+    }
+    TEST_ASSERT(counts, "Per-channel statistics should count five frames", err);
+
+    free(mrx);
+    return 0;
+}
+
+// Bit-by-bit reference for hdlc_scan_flags
+static int scan_flags_reference(const unsigned char *data, int len, int start) {
+    for (int i = start; i < len; i++) {
+        for (int k = 7; k >= 0; k--) {
+            int run = 0;
+            for (int b = i * 8 + (7 - k); b < len * 8 && ((data[b / 8] >> (7 - b % 8)) & 0x01); b++)
+                run++;
+            if (run >= 6)
+                return i;
+        }
+    }
+    return len;
+}
+
+int test_hdlc_scan_flags() {
+    printf("test_hdlc_scan_flags\n");
+    uint8_t err = 0;
+    uint32_t seed = 777;
+
+    // Stuffing-safe noise with one flag planted at every bit offset and every position
+    bool all_match = true;
+    unsigned char data[160];
+    for (int n = 0; n < 400; n++) {
+        int len = 1 + n % 150;
+        for (int i = 0; i < len; i++) {
+            seed = seed * 1103515245 + 12345;
+            data[i] = (uint8_t) (seed >> 16) & 0x77;
+        }
+        int pos = (n * 7) % len;
+        int shift = n % 8;
+        data[pos] |= 0x7E >> shift;
+        if (pos + 1 < len)
+            data[pos + 1] |= (uint8_t) (0x7E << (8 - shift));
+        int start = (n % 3 == 0) ? 0 : (n * 13) % len;
+        if (hdlc_scan_flags(data, len, start) != scan_flags_reference(data, len, start))
+            all_match = false;
+    }
+    TEST_ASSERT(all_match, "hdlc_scan_flags should match the bit-by-bit reference", err);
+
+    memset(data, 0x55, sizeof(data));
+    TEST_ASSERT(hdlc_scan_flags(data, sizeof(data), 0) == sizeof(data), "No candidate should be found in alternating bits", err);
+
+    // Long flag fill and noise at every bit phase must not change what the deframer delivers
+    uint8_t ui_frame[] = { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0, 'I', 'D', 'L', 'E' };
+    static unsigned char stream[2048], shifted[2049];
+    int streamLen = 0;
+    for (int i = 0; i < 100; i++) {
+        seed = seed * 1103515245 + 12345;
+        stream[streamLen++] = (uint8_t) (seed >> 16) & 0x77;
+    }
+    memset(stream + streamLen, 0x7E, 500);
+    streamLen += 500;
+    int encodedLen;
+    hdlc_frame_encode(ui_frame, sizeof(ui_frame), stream + streamLen, &encodedLen);
+    streamLen += encodedLen;
+    memset(stream + streamLen, 0x7E, 300);
+    streamLen += 300;
+    memset(stream + streamLen, 0xFF, 50);
+    streamLen += 50;
+    hdlc_frame_encode(ui_frame, sizeof(ui_frame), stream + streamLen, &encodedLen);
+    streamLen += encodedLen;
+    stream[streamLen++] = 0x7E;
+
+    bool delivered_all = true;
+    for (int shift = 0; shift < 8; shift++) {
+        for (int i = 0; i <= streamLen; i++) {
+            unsigned int prev = (i > 0) ? stream[i - 1] : 0;
+            unsigned int cur = (i < streamLen) ? stream[i] : 0;
+            shifted[i] = (uint8_t) ((((prev << 8) | cur) >> shift) & 0xFF);
+        }
+        deframer_capture_t cap = { 0 };
+        hdlc_deframer_t deframer;
+        hdlc_deframer_init(&deframer, deframer_capture, &cap);
+        for (int pos = 0; pos <= streamLen; pos += 97) {
+            hdlc_deframer_push(&deframer, shifted + pos, (streamLen + 1 - pos < 97) ? streamLen + 1 - pos : 97);
+        }
+        if (cap.count != 2 || cap.lens[0] != sizeof(ui_frame) || memcmp(cap.frames[0], ui_frame, sizeof(ui_frame)) != 0
+                || cap.lens[1] != sizeof(ui_frame) || memcmp(cap.frames[1], ui_frame, sizeof(ui_frame)) != 0 || deframer.fcsErrors != 0)
+            delivered_all = false;
+    }
+    TEST_ASSERT(delivered_all, "Deframer should deliver both frames through flag fill and noise at every bit phase", err);
+
+    return 0;
+}
+
+// Bit-by-bit NRZI reference: a 0 bit toggles the line level, a 1 bit keeps it
+static void nrzi_reference(const unsigned char *in, unsigned char *out, int len, uint8_t level) {
+    for (int i = 0; i < len; i++) {
+        unsigned char byte = 0;
+        for (int k = 7; k >= 0; k--) {
+            if (!((in[i] >> k) & 0x01))
+                level ^= 1;
+            byte |= level << k;
+        }
+        out[i] = byte;
+    }
+}
+
+static void multi_rx_count(int channel, const unsigned char *frame, int frameLen, void *ctx) {
+    (void) frame;
+    (void) frameLen;
+    ((int*) ctx)[channel]++;
+}
+
+int test_hdlc_nrzi() {
+    printf("test_hdlc_nrzi\n");
+    uint8_t err = 0;
+    uint32_t seed = 4242;
+
+    // Transcoding in uneven chunks matches the bit-serial reference and round-trips
+    unsigned char plain[300], coded[300], ref[300], back[300];
+    for (int i = 0; i < (int) sizeof(plain); i++) {
+        seed = seed * 1103515245 + 12345;
+        plain[i] = (seed >> 16) & 0xFF;
+    }
+    nrzi_reference(plain, ref, sizeof(plain), 1);
+    uint8_t txLevel = 1, rxLevel = 1;
+    for (int pos = 0, chunk = 1; pos < (int) sizeof(plain); pos += chunk, chunk = chunk % 11 + 1) {
+        int n = ((int) sizeof(plain) - pos < chunk) ? (int) sizeof(plain) - pos : chunk;
+        hdlc_nrzi_encode(plain + pos, coded + pos, n, &txLevel);
+    }
+    TEST_ASSERT(memcmp(coded, ref, sizeof(plain)) == 0, "hdlc_nrzi_encode should match the bit-serial reference", err);
+    memcpy(back, coded, sizeof(coded));
+    hdlc_nrzi_decode(back, back, 150, &rxLevel);
+    hdlc_nrzi_decode(back + 150, back + 150, sizeof(back) - 150, &rxLevel);
+    TEST_ASSERT(memcmp(back, plain, sizeof(plain)) == 0, "hdlc_nrzi_decode should restore the bitstream in place", err);
+    TEST_ASSERT(txLevel == rxLevel && txLevel == (coded[sizeof(coded) - 1] & 0x01), "Both sides should end on the last line level", err);
+
+    // Fused encoder: same bits as a separate pass, continuous across frames
+    uint8_t ui_frame[] = { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0, 'N', 'R', 'Z', 'I', 0xFF, 0xFF };
+    static unsigned char stream[2048], expected[2048];
+    int streamLen = 0, expectedLen = 0;
+    uint8_t fusedLevel = 0, passLevel = 0;
+    for (int f = 0; f < 3; f++) {
+        int encodedLen;
+        ui_frame[sizeof(ui_frame) - 1] = f;
+        hdlc_frame_encode_nrzi(ui_frame, sizeof(ui_frame), stream + streamLen, &encodedLen, &fusedLevel);
+        streamLen += encodedLen;
+        hdlc_frame_encode_fast(ui_frame, sizeof(ui_frame), expected + expectedLen, &encodedLen);
+        hdlc_nrzi_encode(expected + expectedLen, expected + expectedLen, encodedLen, &passLevel);
+        expectedLen += encodedLen;
+    }
+    TEST_ASSERT(streamLen == expectedLen && memcmp(stream, expected, streamLen) == 0, "hdlc_frame_encode_nrzi should equal encoding then NRZI coding", err);
+
+    unsigned char decoded[300];
+    int decodedLen = 0;
+    uint8_t level = 0;
+    int encodedLen;
+    ui_frame[sizeof(ui_frame) - 1] = 0;
+    hdlc_frame_encode_nrzi(ui_frame, sizeof(ui_frame), coded, &encodedLen, &level);
+    int result = hdlc_frame_decode_nrzi(coded, encodedLen, decoded, &decodedLen, 0);
+    TEST_ASSERT(result == 0 && decodedLen == sizeof(ui_frame) && memcmp(decoded, ui_frame, sizeof(ui_frame)) == 0, "hdlc_frame_decode_nrzi should decode the frame", err);
+    result = hdlc_frame_decode_nrzi(coded, encodedLen, decoded, &decodedLen, 1);
+    TEST_ASSERT(result == -1, "A wrong initial level should corrupt the opening flag", err);
+
+    // Streaming: flag fill, noise, frames and an abort, NRZI coded and pushed in uneven chunks
+    streamLen = 0;
+    for (int i = 0; i < 64; i++) {
+        seed = seed * 1103515245 + 12345;
+        stream[streamLen++] = (seed >> 16) & 0x77;
+    }
+    memset(stream + streamLen, 0x7E, 200);
+    streamLen += 200;
+    for (int f = 0; f < 2; f++) {
+        ui_frame[sizeof(ui_frame) - 1] = f;
+        hdlc_frame_encode_fast(ui_frame, sizeof(ui_frame), stream + streamLen, &encodedLen);
+        streamLen += encodedLen;
+        memset(stream + streamLen, 0xFF, 20);
+        streamLen += 20;
+    }
+    stream[streamLen++] = 0x7E;
+    level = 0;
+    hdlc_nrzi_encode(stream, stream, streamLen, &level);
+
+    deframer_capture_t cap = { 0 };
+    hdlc_deframer_t deframer;
+    hdlc_deframer_init(&deframer, deframer_capture, &cap);
+    hdlc_deframer_set_nrzi(&deframer, true);
+    hdlc_deframer_reset(&deframer);
+    TEST_ASSERT(deframer.rx.nrzi, "hdlc_deframer_reset should keep the NRZI setting", err);
+    for (int pos = 0, chunk = 1; pos < streamLen; pos += chunk, chunk = chunk % 13 + 1) {
+        hdlc_deframer_push(&deframer, stream + pos, (streamLen - pos < chunk) ? streamLen - pos : chunk);
+    }
+    TEST_ASSERT(cap.count == 2, "NRZI deframer should deliver both frames", err);
+    TEST_ASSERT(cap.lens[0] == sizeof(ui_frame) && cap.frames[0][sizeof(ui_frame) - 1] == 0 && cap.frames[1][sizeof(ui_frame) - 1] == 1,
+            "NRZI deframer should deliver the frames in order", err);
+    TEST_ASSERT(deframer.fcsErrors == 0, "No FCS error expected on the NRZI stream", err);
+
+    int counts[2] = { 0 };
+    hdlc_multi_rx_t *mrx = malloc(sizeof(hdlc_multi_rx_t));
+    hdlc_multi_rx_init(mrx, 2, multi_rx_count, counts);
+    hdlc_multi_rx_set_nrzi(mrx, true);
+    for (int pos = 0; pos < streamLen; pos += 50) {
+        const unsigned char *data[2] = { stream + pos, stream + pos };
+        int len[2] = { (streamLen - pos < 50) ? streamLen - pos : 50, (streamLen - pos < 50) ? streamLen - pos : 50 };
+        hdlc_multi_rx_push(mrx, data, len);
+    }
+    TEST_ASSERT(counts[0] == 2 && counts[1] == 2, "NRZI multi-channel engine should deliver both frames on every channel", err);
+    free(mrx);
+
+    return 0;
+}
+
+int test_hdlc_recover() {
+    printf("test_hdlc_recover\n");
+    uint8_t err = 0;
+
+    uint8_t ui_frame[] = { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0, 'F', 'I', 'X', 'M', 'E' };
+    unsigned char encoded[64], damaged[64], decoded[64];
+    int encodedLen, decodedLen;
+    hdlc_frame_encode_fast(ui_frame, sizeof(ui_frame), encoded, &encodedLen);
+
+    int result = hdlc_frame_decode_recover(encoded, encodedLen, decoded, &decodedLen, NULL);
+    TEST_ASSERT(result == 0 && decodedLen == sizeof(ui_frame) && memcmp(decoded, ui_frame, sizeof(ui_frame)) == 0, "An intact frame should need no flip", err);
+
+    // Every single bit error between the flags: recovered unless it breaks the stuffing, never wrong
+    int recovered = 0, wrong = 0, total = 0;
+    for (int r = 8; r < (encodedLen - 1) * 8; r++) {
+        memcpy(damaged, encoded, encodedLen);
+        damaged[r / 8] ^= 0x80 >> (r % 8);
+        total++;
+        if (hdlc_frame_decode_recover(damaged, encodedLen, decoded, &decodedLen, NULL) == 1) {
+            if (decodedLen == sizeof(ui_frame) && memcmp(decoded, ui_frame, sizeof(ui_frame)) == 0)
+                recovered++;
+            else
+                wrong++;
+        }
+    }
+    TEST_ASSERT(wrong == 0, "A repaired frame should always be the original one", err);
+    TEST_ASSERT(recovered * 10 >= total * 9, "At least 90% of single bit errors should be repaired", err);
+
+    // One NRZI level error flips two adjacent bits
+    uint8_t level = 0;
+    unsigned char line[64];
+    hdlc_frame_encode_nrzi(ui_frame, sizeof(ui_frame), line, &encodedLen, &level);
+    line[10] ^= 0x08;
+    level = 0;
+    hdlc_nrzi_decode(line, damaged, encodedLen, &level);
+    hdlc_recover_t single = { 1, NULL, 0 };
+    hdlc_recover_t pairs = { 2, NULL, 0 };
+    TEST_ASSERT(hdlc_frame_decode_recover(damaged, encodedLen, decoded, &decodedLen, &single) == -1, "A line level error is not a single bit error", err);
+    result = hdlc_frame_decode_recover(damaged, encodedLen, decoded, &decodedLen, &pairs);
+    TEST_ASSERT(result == 2 && memcmp(decoded, ui_frame, sizeof(ui_frame)) == 0, "Adjacent pair search should repair a line level error", err);
+
+    // Two distant errors are only found among the least confident bits
+    uint8_t confidence[64 * 8];
+    memset(confidence, 200, sizeof(confidence));
+    memcpy(damaged, encoded, encodedLen);
+    damaged[4] ^= 0x04;
+    damaged[17] ^= 0x40;
+    confidence[4 * 8 + 5] = 20;
+    confidence[17 * 8 + 1] = 35;
+    for (int i = 0; i < 6; i++) {
+        confidence[(7 + 3 * i) * 8 + i] = 30 + i;
+    }
+    TEST_ASSERT(hdlc_frame_decode_recover(damaged, encodedLen, decoded, &decodedLen, &pairs) == -1, "Distant errors should not be found without confidence",
+            err);
+    hdlc_recover_t weighted = { 2, confidence, 8 };
+    result = hdlc_frame_decode_recover(damaged, encodedLen, decoded, &decodedLen, &weighted);
+    TEST_ASSERT(result == 2 && decodedLen == sizeof(ui_frame) && memcmp(decoded, ui_frame, sizeof(ui_frame)) == 0,
+            "Confidence should lead the search to both errors", err);
+    weighted.candidates = 4;
+    TEST_ASSERT(hdlc_frame_decode_recover(damaged, encodedLen, decoded, &decodedLen, &weighted) == -1, "Errors outside the candidates should not be repaired",
+            err);
+
+    // Deframer: a damaged frame between two intact ones
+    static unsigned char stream[256];
+    int streamLen = 0;
+    for (int f = 0; f < 3; f++) {
+        ui_frame[sizeof(ui_frame) - 1] = 'A' + f;
+        hdlc_frame_encode_fast(ui_frame, sizeof(ui_frame), stream + streamLen, &encodedLen);
+        if (f == 1)
+            stream[streamLen + 12] ^= 0x02;
+        streamLen += encodedLen;
+    }
+    deframer_capture_t cap = { 0 };
+    hdlc_deframer_t deframer;
+    hdlc_deframer_init(&deframer, deframer_capture, &cap);
+    hdlc_deframer_push(&deframer, stream, streamLen);
+    TEST_ASSERT(cap.count == 2 && deframer.fcsErrors == 1, "Without repair the damaged frame should be dropped", err);
+
+    memset(&cap, 0, sizeof(cap));
+    hdlc_deframer_init(&deframer, deframer_capture, &cap);
+    hdlc_deframer_set_recover(&deframer, 1);
+    hdlc_deframer_push(&deframer, stream, streamLen);
+    TEST_ASSERT(cap.count == 3 && deframer.recovered == 1 && deframer.fcsErrors == 0, "With repair every frame should be delivered", err);
+    TEST_ASSERT(cap.frames[1][sizeof(ui_frame) - 1] == 'B' && memcmp(cap.frames[1], ui_frame, sizeof(ui_frame) - 1) == 0, "The repaired frame should be intact",
+            err);
+
+    return 0;
+}
+
+int test_hdlc_batch() {
+    printf("test_hdlc_batch\n");
+    uint8_t err = 0;
+
+    uint8_t frames[5][40];
+    hdlc_frame_desc_t descs[5];
+    static unsigned char encoded[1024], single[128], decoded[1024];
+    int encodedLen, singleLen, separateLen = 0;
+    for (int f = 0; f < 5; f++) {
+        uint8_t header[] = { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0 };
+        memcpy(frames[f], header, sizeof(header));
+        for (int i = sizeof(header); i < 20 + 4 * f; i++) {
+            frames[f][i] = (f & 1) ? 0xFF : (uint8_t) (i * 13 + f);
+        }
+        descs[f].frame = frames[f];
+        descs[f].len = 20 + 4 * f;
+        hdlc_frame_encode_fast(frames[f], descs[f].len, single, &singleLen);
+        separateLen += singleLen;
+    }
+
+    hdlc_frame_encode_batch(descs, 5, encoded, &encodedLen, NULL);
+    TEST_ASSERT(encodedLen < separateLen - 3, "Shared flags should make the burst shorter than separate frames", err);
+    hdlc_frame_encode_batch(descs, 1, encoded, &encodedLen, NULL);
+    hdlc_frame_encode_fast(frames[0], descs[0].len, single, &singleLen);
+    TEST_ASSERT(encodedLen == singleLen && memcmp(encoded, single, singleLen) == 0, "A batch of one should equal hdlc_frame_encode_fast", err);
+
+    hdlc_frame_desc_t out[8];
+    hdlc_frame_encode_batch(descs, 5, encoded, &encodedLen, NULL);
+    int count = hdlc_frame_decode_batch(encoded, encodedLen, decoded, sizeof(decoded), out, 8, NULL);
+    bool all_ok = (count == 5);
+    for (int f = 0; f < count && f < 5; f++) {
+        all_ok &= (out[f].len == descs[f].len && memcmp(out[f].frame, frames[f], descs[f].len) == 0);
+    }
+    TEST_ASSERT(all_ok, "Batch decode should return every frame of the burst in order", err);
+    TEST_ASSERT(out[1].frame == decoded + out[0].len, "Decoded frames should be packed in the output buffer", err);
+
+    deframer_capture_t cap = { 0 };
+    hdlc_deframer_t deframer;
+    hdlc_deframer_init(&deframer, deframer_capture, &cap);
+    hdlc_deframer_push(&deframer, encoded, encodedLen);
+    TEST_ASSERT(cap.count == 5, "The streaming deframer should accept shared flags", err);
+
+    count = hdlc_frame_decode_batch(encoded, encodedLen, decoded, sizeof(decoded), out, 3, NULL);
+    TEST_ASSERT(count == 3, "Decoding should stop when the descriptor array is full", err);
+    count = hdlc_frame_decode_batch(encoded, encodedLen, decoded, descs[0].len + descs[1].len + 1, out, 8, NULL);
+    TEST_ASSERT(count == 2, "Decoding should stop when the output buffer is full", err);
+
+    // A damaged frame is skipped without losing its neighbours
+    encoded[encodedLen / 2] ^= 0x10;
+    count = hdlc_frame_decode_batch(encoded, encodedLen, decoded, sizeof(decoded), out, 8, NULL);
+    TEST_ASSERT(count == 4, "Only the damaged frame should be lost", err);
+
+    uint8_t txLevel = 1, rxLevel = 1;
+    hdlc_frame_encode_batch(descs, 5, encoded, &encodedLen, &txLevel);
+    count = hdlc_frame_decode_batch(encoded, encodedLen, decoded, sizeof(decoded), out, 8, &rxLevel);
+    all_ok = (count == 5 && rxLevel == txLevel);
+    for (int f = 0; f < count && f < 5; f++) {
+        all_ok &= (out[f].len == descs[f].len && memcmp(out[f].frame, frames[f], descs[f].len) == 0);
+    }
+    TEST_ASSERT(all_ok, "NRZI bursts should round trip", err);
+
+    return 0;
+}
+
 int test_hdlc_main() {
     int result = 0;
     printf("\n----------------------------------------------------------------------------------\n");
     printf("Starting HDLC Tests\n");
     printf("----------------------------------------------------------------------------------\n\n");
+    result |= test_crc_kernels();
+    result |= test_crc_stream();
     result |= test_hdlc();
+    result |= test_hdlc_decode_fast();
+    result |= test_hdlc_encode_fast();
+    result |= test_hdlc_deframer();
+    result |= test_hdlc_multi_rx();
+    result |= test_hdlc_scan_flags();
+    result |= test_hdlc_nrzi();
+    result |= test_hdlc_recover();
+    result |= test_hdlc_batch();
     printf("\n----------------------------------------------------------------------------------\n");
     printf("Tests HDLC Completed. %s\n", result == 0 ? "All tests passed" : "Some tests failed");
     printf("----------------------------------------------------------------------------------\n\n");
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "test_common.h"
+#include "il2p.h"
+
+static uint32_t assert_count = 0;
+
+// Test vectors from the IL2P specification, without the sync word
+static const unsigned char s_frame[] = { 0x96, 0x82, 0x64, 0x88, 0x8a, 0xae, 0xe4, 0x96, 0x96, 0x68, 0x90, 0x8a, 0x94, 0x6f, 0xb1 };
+static const unsigned char s_packet[] = { 0x26, 0x57, 0x4d, 0x57, 0xf1, 0x96, 0xcc, 0x85, 0x42, 0xe7, 0x24, 0xf7, 0x2e, 0x8a, 0x97 };
+static const unsigned char ui_frame[] = { 0x86, 0xa2, 0x40, 0x40, 0x40, 0x40, 0x60, 0x96, 0x96, 0x68, 0x90, 0x8a, 0x94, 0x7f, 0x03, 0xf0 };
+static const unsigned char ui_packet[] = { 0x6a, 0xea, 0x9c, 0xc2, 0x01, 0x11, 0xfc, 0x14, 0x1f, 0xda, 0x6e, 0xf2, 0x53, 0x91, 0xbd };
+static const unsigned char i_frame[] = { 0x96, 0x82, 0x64, 0x88, 0x8a, 0xae, 0xe4, 0x96, 0x96, 0x68, 0x90, 0x8a, 0x94, 0x65, 0xb8, 0xcf, 0x30, 0x31, 0x32,
+        0x33, 0x34, 0x35, 0x36, 0x37, 0x38 };
+static const unsigned char i_packet[] = { 0x26, 0x13, 0x6d, 0x02, 0x8c, 0xfe, 0xfb, 0xe8, 0xaa, 0x94, 0x2d, 0x6a, 0x34, 0x43, 0x35, 0x3c, 0x69, 0x9f, 0x0c,
+        0x75, 0x5a, 0x38, 0xa1, 0x7f, 0xf3, 0xfc };
+
+static bool il2p_matches(const unsigned char *frame, int frameLen, const unsigned char *packet, int packetLen) {
+    unsigned char out[IL2P_MAX_ENCODED_LEN];
+    int outLen;
+
+    if (il2p_frame_encode(frame, frameLen, out, &outLen, 0) != 0)
+        return false;
+    return outLen == IL2P_SYNC_LEN + packetLen && out[0] == 0xF1 && out[1] == 0x5E && out[2] == 0x48 && memcmp(out + IL2P_SYNC_LEN, packet, packetLen) == 0;
+}
+
+static bool il2p_round_trip(const unsigned char *frame, int frameLen, int options) {
+    unsigned char out[IL2P_MAX_ENCODED_LEN], back[IL2P_MAX_FRAME_LEN];
+    int outLen, backLen;
+
+    if (il2p_frame_encode(frame, frameLen, out, &outLen, options) != 0)
+        return false;
+    return il2p_frame_decode(out, outLen, back, &backLen) == 0 && backLen == frameLen && memcmp(back, frame, frameLen) == 0;
+}
+
+int test_il2p_scramble() {
+    printf("test_il2p_scramble\n");
+    uint8_t err = 0;
+
+    unsigned char data[300], scrambled[300], back[300];
+    for (int i = 0; i < (int) sizeof(data); i++) {
+        data[i] = (uint8_t) (i * 37 + 11);
+    }
+
+    bool all_ok = true;
+    for (int len = 1; len <= (int) sizeof(data); len += 13) {
+        il2p_scramble(data, scrambled, len);
+        il2p_descramble(scrambled, back, len);
+        all_ok &= (memcmp(back, data, len) == 0);
+    }
+    TEST_ASSERT(all_ok, "Descrambling should restore any block length", err);
+
+    memset(data, 0, 16);
+    il2p_scramble(data, scrambled, 16);
+    bool whitened = false;
+    for (int i = 0; i < 16; i++) {
+        whitened |= (scrambled[i] != 0);
+    }
+    TEST_ASSERT(whitened, "Scrambler should whiten runs of zeros", err);
+
+    return 0;
+}
+
+int test_il2p_vectors() {
+    printf("test_il2p_vectors\n");
+    uint8_t err = 0;
+
+    TEST_ASSERT(il2p_matches(s_frame, sizeof(s_frame), s_packet, sizeof(s_packet)), "S frame should match the specification vector", err);
+    TEST_ASSERT(il2p_matches(ui_frame, sizeof(ui_frame), ui_packet, sizeof(ui_packet)), "UI frame should match the specification vector", err);
+    TEST_ASSERT(il2p_matches(i_frame, sizeof(i_frame), i_packet, sizeof(i_packet)), "I frame should match the specification vector", err);
+
+    unsigned char packet[64], frame[IL2P_MAX_FRAME_LEN];
+    int frameLen;
+    packet[0] = 0xF1;
+    packet[1] = 0x5E;
+    packet[2] = 0x48;
+    memcpy(packet + IL2P_SYNC_LEN, i_packet, sizeof(i_packet));
+    int result = il2p_frame_decode(packet, IL2P_SYNC_LEN + sizeof(i_packet), frame, &frameLen);
+    TEST_ASSERT(result == 0 && frameLen == sizeof(i_frame) && memcmp(frame, i_frame, sizeof(i_frame)) == 0, "I frame vector should decode to the AX.25 frame",
+            err);
+
+    return 0;
+}
+
+int test_il2p_frame() {
+    printf("test_il2p_frame\n");
+    uint8_t err = 0;
+
+    // Type 1 frames: every U frame, RNR response, I frame with poll
+    static const uint8_t u_controls[] = { 0x3F, 0x53, 0x1F, 0x73, 0x97, 0xAF, 0xE3 };
+    bool all_ok = true;
+    unsigned char frame[IL2P_MAX_FRAME_LEN];
+    memcpy(frame, s_frame, sizeof(s_frame));
+    for (int i = 0; i < (int) sizeof(u_controls); i++) {
+        frame[14] = u_controls[i];
+        all_ok &= il2p_round_trip(frame, 15, 0);
+    }
+    frame[6] &= 0x7F;
+    frame[13] |= 0x80;
+    frame[14] = 0x45;
+    all_ok &= il2p_round_trip(frame, 15, 0);
+    TEST_ASSERT(all_ok, "U and S frames should survive the type 1 header", err);
+
+    // Type 0 frames: repeaters, lowercase callsign, unknown PID, modulo 128
+    unsigned char out[IL2P_MAX_ENCODED_LEN];
+    int outLen;
+    static const unsigned char digi_frame[] = { 0x86, 0xa2, 0x40, 0x40, 0x40, 0x40, 0x60, 0x96, 0x96, 0x68, 0x90, 0x8a, 0x94, 0x7e, 0xae, 0x92, 0x88,
+            0x8a, 0x62, 0x40, 0x63, 0x03, 0xf0, 'h', 'i' };
+    TEST_ASSERT(il2p_round_trip(digi_frame, sizeof(digi_frame), 0), "Frames with repeaters should be carried whole", err);
+    il2p_frame_encode(digi_frame, sizeof(digi_frame), out, &outLen, 0);
+    TEST_ASSERT(outLen == IL2P_SYNC_LEN + IL2P_HEADER_LEN + IL2P_HEADER_PARITY + sizeof(digi_frame) + 2, "Type 0 payload should be the whole frame", err);
+
+    memcpy(frame, ui_frame, sizeof(ui_frame));
+    frame[1] = 'q' << 1;
+    all_ok = il2p_round_trip(frame, sizeof(ui_frame), 0);
+    memcpy(frame, ui_frame, sizeof(ui_frame));
+    frame[15] = 0xC3;
+    all_ok &= il2p_round_trip(frame, sizeof(ui_frame), 0);
+    memcpy(frame, i_frame, sizeof(i_frame));
+    all_ok &= il2p_round_trip(frame, sizeof(i_frame), IL2P_OPT_MODULO128);
+    TEST_ASSERT(all_ok, "Untranslatable frames should round trip through type 0", err);
+
+    // Payload sizes across the block boundaries, both FEC levels. The specification UI frame
+    // clears both command bits, which the type 1 header cannot express: make it a command.
+    memcpy(frame, ui_frame, sizeof(ui_frame));
+    frame[6] |= 0x80;
+    for (int i = 0; i < IL2P_MAX_PAYLOAD; i++) {
+        frame[sizeof(ui_frame) + i] = (uint8_t) (i * 7);
+    }
+    static const int sizes[] = { 0, 1, 246, 247, 248, 300, 494, 495, 700, 1023 };
+    all_ok = true;
+    for (int s = 0; s < (int) (sizeof(sizes) / sizeof(sizes[0])); s++) {
+        all_ok &= il2p_round_trip(frame, sizeof(ui_frame) + sizes[s], 0);
+        all_ok &= il2p_round_trip(frame, sizeof(ui_frame) + sizes[s], IL2P_OPT_MAX_FEC);
+    }
+    TEST_ASSERT(all_ok, "Payloads of every block layout should round trip", err);
+    TEST_ASSERT(il2p_frame_encode(frame, sizeof(ui_frame) + 1024, out, &outLen, 0) == -1, "Payloads over 1023 bytes should be rejected", err);
+
+    il2p_frame_encode(frame, sizeof(ui_frame) + 1023, out, &outLen, IL2P_OPT_MAX_FEC);
+    TEST_ASSERT(outLen == IL2P_MAX_ENCODED_LEN, "Largest max FEC packet should fill IL2P_MAX_ENCODED_LEN", err);
+    il2p_frame_encode(frame, sizeof(ui_frame) + 300, out, &outLen, 0);
+    // 300 bytes: two blocks of 150 bytes, 6 check bytes each
+    TEST_ASSERT(outLen == IL2P_SYNC_LEN + IL2P_HEADER_LEN + IL2P_HEADER_PARITY + 300 + 2 * 6, "Baseline FEC should split 300 bytes into two blocks", err);
+
+    return 0;
+}
+
+int test_il2p_errors() {
+    printf("test_il2p_errors\n");
+    uint8_t err = 0;
+
+    unsigned char frame[IL2P_MAX_FRAME_LEN], back[IL2P_MAX_FRAME_LEN];
+    unsigned char out[IL2P_MAX_ENCODED_LEN], stream[IL2P_MAX_ENCODED_LEN + 16];
+    int outLen, backLen;
+    memcpy(frame, ui_frame, sizeof(ui_frame));
+    frame[6] |= 0x80;
+    for (int i = 0; i < 300; i++) {
+        frame[sizeof(ui_frame) + i] = (uint8_t) (i ^ 0x5A);
+    }
+    int frameLen = sizeof(ui_frame) + 300;
+    il2p_frame_encode(frame, frameLen, out, &outLen, 0);
+
+    // One header error, three errors in each payload block, sync word one bit off
+    out[1] ^= 0x04;
+    out[IL2P_SYNC_LEN + 5] ^= 0xFF;
+    for (int b = 0; b < 2; b++) {
+        int block = IL2P_SYNC_LEN + IL2P_HEADER_LEN + IL2P_HEADER_PARITY + b * 156;
+        out[block] ^= 0x11;
+        out[block + 77] ^= 0x80;
+        out[block + 155] ^= 0x3C;
+    }
+
+    bool all_ok = true;
+    for (int shift = 0; shift < 8; shift++) {
+        // Preamble, then the packet at an arbitrary bit alignment
+        memset(stream, 0x55, sizeof(stream));
+        for (int bit = 0; bit < outLen * 8; bit++) {
+            int pos = 32 + shift + bit;
+            unsigned char mask = 0x80 >> (pos % 8);
+            stream[pos / 8] = (out[bit / 8] & (0x80 >> (bit % 8))) ? (stream[pos / 8] | mask) : (stream[pos / 8] & ~mask);
+        }
+        int corrected = il2p_frame_decode(stream, outLen + 6, back, &backLen);
+        all_ok &= (corrected == 7 && backLen == frameLen && memcmp(back, frame, frameLen) == 0);
+    }
+    TEST_ASSERT(all_ok, "Decoder should find the sync word at any alignment and correct every block", err);
+
+    out[IL2P_SYNC_LEN + IL2P_HEADER_LEN + IL2P_HEADER_PARITY + 10] ^= 0x01;
+    out[IL2P_SYNC_LEN + IL2P_HEADER_LEN + IL2P_HEADER_PARITY + 20] ^= 0x01;
+    TEST_ASSERT(il2p_frame_decode(out, outLen, back, &backLen) == -1, "An uncorrectable block should fail the packet", err);
+    TEST_ASSERT(il2p_frame_decode(out, outLen - 1, back, &backLen) == -1, "A truncated packet should fail", err);
+
+    memset(stream, 0x55, 64);
+    TEST_ASSERT(il2p_frame_decode(stream, 64, back, &backLen) == -1, "Preamble alone should not decode", err);
+
+    return 0;
+}
+
+int test_il2p_main() {
+    int result = 0;
+    printf("\n----------------------------------------------------------------------------------\n");
+    printf("Starting IL2P Tests\n");
+    printf("----------------------------------------------------------------------------------\n\n");
+    result |= test_il2p_scramble();
+    result |= test_il2p_vectors();
+    result |= test_il2p_frame();
+    result |= test_il2p_errors();
+    printf("\n----------------------------------------------------------------------------------\n");
+    printf("Tests IL2P Completed. %s\n", result == 0 ? "All tests passed" : "Some tests failed");
+    printf("----------------------------------------------------------------------------------\n\n");
+    return result;
+}
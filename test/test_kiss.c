@@ -0,0 +1,215 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "test_common.h"
+#include "ax25.h"
+#include "kiss.h"
+
+static uint32_t assert_count = 0;
+
+typedef struct {
+    int count;
+    int ports[8];
+    int commands[8];
+    int lens[8];
+    unsigned char frames[8][300];
+} kiss_capture_t;
+
+static void kiss_capture(int port, int command, const unsigned char *data, int dataLen, void *ctx) {
+    kiss_capture_t *cap = (kiss_capture_t*) ctx;
+    if (cap->count < 8 && dataLen <= 300) {
+        cap->ports[cap->count] = port;
+        cap->commands[cap->count] = command;
+        cap->lens[cap->count] = dataLen;
+        memcpy(cap->frames[cap->count], data, dataLen);
+    }
+    cap->count++;
+}
+
+int test_kiss_encode() {
+    printf("test_kiss_encode\n");
+    uint8_t err = 0;
+
+    unsigned char data[] = { 0x01, KISS_FEND, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, KISS_FESC, 0x0A };
+    unsigned char expected[] = { KISS_FEND, 0x30, 0x01, KISS_FESC, KISS_TFEND, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, KISS_FESC, KISS_TFESC, 0x0A,
+            KISS_FEND };
+    unsigned char encoded[KISS_ENCODED_MAX(300)];
+    int encodedLen;
+    int result = kiss_frame_encode(3, KISS_CMD_DATA, data, sizeof(data), encoded, &encodedLen, false);
+    TEST_ASSERT(result == 0 && encodedLen == sizeof(expected) && memcmp(encoded, expected, sizeof(expected)) == 0, "FEND and FESC should be escaped", err);
+
+    unsigned char all[256];
+    for (int i = 0; i < 256; i++) {
+        all[i] = (uint8_t) i;
+    }
+    kiss_frame_encode(0, KISS_CMD_DATA, all, sizeof(all), encoded, &encodedLen, false);
+    TEST_ASSERT(encodedLen == 256 + 2 + 3, "Every byte value should be escaped exactly when needed", err);
+
+    memset(all, KISS_FEND, sizeof(all));
+    kiss_frame_encode(0, KISS_CMD_DATA, all, sizeof(all), encoded, &encodedLen, true);
+    TEST_ASSERT((size_t) encodedLen <= KISS_ENCODED_MAX(sizeof(all)), "KISS_ENCODED_MAX should bound the worst case", err);
+
+    unsigned char txdelay[] = { KISS_FEND, 0x11, 30, KISS_FEND };
+    result = kiss_command_encode(1, KISS_CMD_TXDELAY, 30, encoded, &encodedLen);
+    TEST_ASSERT(result == 0 && encodedLen == 4 && memcmp(encoded, txdelay, 4) == 0, "TXDELAY should be a one byte command", err);
+    unsigned char ret[] = { KISS_FEND, 0xFF, KISS_FEND };
+    result = kiss_command_encode(5, KISS_CMD_RETURN, 0, encoded, &encodedLen);
+    TEST_ASSERT(result == 0 && encodedLen == 3 && memcmp(encoded, ret, 3) == 0, "Return should be FEND FF FEND", err);
+    TEST_ASSERT(kiss_command_encode(0, KISS_CMD_DATA, 0, encoded, &encodedLen) == -1, "Data is not a parameter command", err);
+    TEST_ASSERT(kiss_frame_encode(16, KISS_CMD_DATA, data, 1, encoded, &encodedLen, false) == -1, "Port 16 should be rejected", err);
+    TEST_ASSERT(kiss_frame_encode(8, KISS_CMD_DATA, data, 1, encoded, &encodedLen, true) == -1, "SMACK should only address 8 ports", err);
+
+    return 0;
+}
+
+int test_kiss_decode() {
+    printf("test_kiss_decode\n");
+    uint8_t err = 0;
+
+    uint8_t ui_frame[] = { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0, 'K', 0xC0, 'I', 0xDB, 'S', 'S' };
+    unsigned char encoded[KISS_ENCODED_MAX(sizeof(ui_frame))];
+    int encodedLen, port, command, dataLen;
+
+    kiss_frame_encode(2, KISS_CMD_DATA, ui_frame, sizeof(ui_frame), encoded, &encodedLen, false);
+    int result = kiss_frame_decode(encoded, encodedLen, &port, &command, &dataLen, true);
+    TEST_ASSERT(result == 0 && port == 2 && command == KISS_CMD_DATA, "Port and command should be decoded", err);
+    TEST_ASSERT(dataLen == sizeof(ui_frame) && memcmp(encoded + 1, ui_frame, sizeof(ui_frame)) == 0, "Data should be unescaped in place", err);
+
+    uint8_t decodeErr = 0;
+    ax25_frame_t *frame = ax25_frame_decode(encoded + 1, dataLen, 0, &decodeErr);
+    TEST_ASSERT(frame != NULL && frame->type == AX25_FRAME_UNNUMBERED_INFORMATION, "Data should feed ax25_frame_decode directly", err);
+    ax25_frame_free(frame, &decodeErr);
+
+    kiss_frame_encode(7, KISS_CMD_DATA, ui_frame, sizeof(ui_frame), encoded, &encodedLen, true);
+    TEST_ASSERT(encoded[1] == 0xF0, "SMACK should set bit 7 of the type byte", err);
+    result = kiss_frame_decode(encoded, encodedLen, &port, &command, &dataLen, true);
+    TEST_ASSERT(result == 0 && port == 7 && dataLen == sizeof(ui_frame) && memcmp(encoded + 1, ui_frame, sizeof(ui_frame)) == 0,
+            "SMACK CRC should be checked and removed", err);
+
+    kiss_frame_encode(0, KISS_CMD_DATA, ui_frame, sizeof(ui_frame), encoded, &encodedLen, true);
+    encoded[5] ^= 0x10;
+    TEST_ASSERT(kiss_frame_decode(encoded, encodedLen, &port, &command, &dataLen, true) == -1, "A corrupted SMACK frame should be rejected", err);
+
+    // Plain KISS on ports 8 to 15: bit 7 of the type byte is part of the port number
+    kiss_frame_encode(12, KISS_CMD_DATA, ui_frame, sizeof(ui_frame), encoded, &encodedLen, false);
+    result = kiss_frame_decode(encoded, encodedLen, &port, &command, &dataLen, false);
+    TEST_ASSERT(result == 0 && port == 12 && dataLen == sizeof(ui_frame) && memcmp(encoded + 1, ui_frame, sizeof(ui_frame)) == 0,
+            "Ports 8 to 15 should round-trip without SMACK", err);
+
+    unsigned char empty[] = { KISS_FEND, KISS_FEND };
+    TEST_ASSERT(kiss_frame_decode(empty, sizeof(empty), &port, &command, &dataLen, true) == -1, "An empty frame should be rejected", err);
+    unsigned char lone_fesc[] = { KISS_FEND, KISS_FESC, KISS_FEND };
+    TEST_ASSERT(kiss_frame_decode(lone_fesc, sizeof(lone_fesc), &port, &command, &dataLen, false) == -1, "A frame of a lone FESC should be rejected", err);
+
+    return 0;
+}
+
+int test_kiss_deframer() {
+    printf("test_kiss_deframer\n");
+    uint8_t err = 0;
+
+    uint8_t ui_frame[] = { 0x82, 0x84, 0x86, 0x88, 0x8A, 0x8C, 0xEE, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x98, 0x63, 0x03, 0xF0, 0xC0, 0xDB, 0xDB, 0xC0, 0x00 };
+    static unsigned char stream[1024];
+    int streamLen = 0, encodedLen;
+
+    // Noise, a data frame per port, a SMACK frame, a parameter and empty frames
+    memcpy(stream, "noise", 5);
+    streamLen += 5;
+    for (int p = 0; p < 3; p++) {
+        ui_frame[sizeof(ui_frame) - 1] = p;
+        kiss_frame_encode(p, KISS_CMD_DATA, ui_frame, sizeof(ui_frame), stream + streamLen, &encodedLen, false);
+        streamLen += encodedLen;
+        stream[streamLen++] = KISS_FEND;
+    }
+    kiss_frame_encode(5, KISS_CMD_DATA, ui_frame, sizeof(ui_frame), stream + streamLen, &encodedLen, true);
+    streamLen += encodedLen;
+    kiss_command_encode(1, KISS_CMD_PERSIST, 63, stream + streamLen, &encodedLen);
+    streamLen += encodedLen;
+
+    bool all_ok = true;
+    for (int chunk = 1; chunk <= 64; chunk++) {
+        kiss_capture_t cap = { 0 };
+        kiss_deframer_t deframer;
+        kiss_deframer_init(&deframer, kiss_capture, &cap, true);
+        int delivered = 0;
+        for (int pos = 0; pos < streamLen; pos += chunk) {
+            delivered += kiss_deframer_push(&deframer, stream + pos, (streamLen - pos < chunk) ? streamLen - pos : chunk);
+        }
+        all_ok &= (delivered == 5 && cap.count == 5 && deframer.frames == 5 && deframer.crcErrors == 0);
+        for (int f = 0; f < 4 && f < cap.count; f++) {
+            ui_frame[sizeof(ui_frame) - 1] = (f < 3) ? f : 2;
+            all_ok &= (cap.commands[f] == KISS_CMD_DATA && cap.ports[f] == ((f < 3) ? f : 5) && cap.lens[f] == sizeof(ui_frame)
+                    && memcmp(cap.frames[f], ui_frame, sizeof(ui_frame)) == 0);
+        }
+        all_ok &= (cap.ports[4] == 1 && cap.commands[4] == KISS_CMD_PERSIST && cap.lens[4] == 1 && cap.frames[4][0] == 63);
+    }
+    TEST_ASSERT(all_ok, "Deframer should deliver every frame for every chunk size", err);
+
+    // Frame longer than the buffer, then a good frame
+    static unsigned char big[KISS_MAX_FRAME_LEN + 16];
+    memset(big, 0x55, sizeof(big));
+    big[0] = KISS_FEND;
+    big[sizeof(big) - 1] = KISS_FEND;
+    kiss_capture_t cap = { 0 };
+    kiss_deframer_t deframer;
+    kiss_deframer_init(&deframer, kiss_capture, &cap, true);
+    kiss_deframer_push(&deframer, big, sizeof(big));
+    kiss_deframer_push(&deframer, stream + 5, 30);
+    TEST_ASSERT(deframer.overruns == 1 && cap.count == 1 && cap.ports[0] == 0, "An oversized frame should be dropped without losing the next one", err);
+
+    // Corrupted SMACK frame
+    kiss_frame_encode(0, KISS_CMD_DATA, ui_frame, sizeof(ui_frame), stream, &encodedLen, true);
+    stream[3] ^= 0x01;
+    kiss_deframer_reset(&deframer);
+    cap.count = 0;
+    kiss_deframer_push(&deframer, stream, encodedLen);
+    TEST_ASSERT(cap.count == 0 && deframer.crcErrors == 1, "A corrupted SMACK frame should be counted and dropped", err);
+
+    // Without SMACK, a frame for port 9 is delivered as it is
+    kiss_frame_encode(9, KISS_CMD_DATA, ui_frame, sizeof(ui_frame), stream, &encodedLen, false);
+    kiss_deframer_init(&deframer, kiss_capture, &cap, false);
+    cap.count = 0;
+    kiss_deframer_push(&deframer, stream, encodedLen);
+    TEST_ASSERT(cap.count == 1 && cap.ports[0] == 9 && cap.lens[0] == sizeof(ui_frame) && deframer.crcErrors == 0,
+            "A plain KISS deframer should deliver ports 8 to 15", err);
+
+    return 0;
+}
+
+int test_kiss_main() {
+    int result = 0;
+    printf("\n----------------------------------------------------------------------------------\n");
+    printf("Starting KISS Tests\n");
+    printf("----------------------------------------------------------------------------------\n\n");
+    result |= test_kiss_encode();
+    result |= test_kiss_decode();
+    result |= test_kiss_deframer();
+    printf("\n----------------------------------------------------------------------------------\n");
+    printf("Tests KISS Completed. %s\n", result == 0 ? "All tests passed" : "Some tests failed");
+    printf("----------------------------------------------------------------------------------\n\n");
+    return result;
+}
@@ -20,13 +20,23 @@
  */
 
 #include "test_ax25.h"
+#include "test_ax25_link.h"
 #include "test_hdlc.h"
 #include "test_aprs.h"
+#include "test_fx25.h"
+#include "test_il2p.h"
+#include "test_kiss.h"
+#include "test_timer_wheel.h"
 
 int main() {
     test_ax25_main();
+    test_ax25_link_main();
     test_hdlc_main();
     test_aprs_main();
+    test_fx25_main();
+    test_il2p_main();
+    test_kiss_main();
+    test_timer_wheel_main();
 }
 
 
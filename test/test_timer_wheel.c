@@ -0,0 +1,219 @@
+/*
+ * Copyright 2025 Emiliano Augusto Gonzalez (egonzalez . hiperion @ gmail . com))
+ * * Project Site: https://github.com/hiperiondev/HamRadioLib *
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "test_common.h"
+#include "timer_wheel.h"
+
+static uint32_t assert_count = 0;
+
+#define WHEEL_TIMERS 512
+
+typedef struct {
+    timer_wheel_t *wheel;
+    timer_wheel_entry_t entry;
+    uint32_t due;                 // Time the timer was armed for
+    uint32_t fired_at;            // Wheel time when it fired
+    int fired;
+    timer_wheel_entry_t *cancel;  // Timer cancelled from the callback
+    uint32_t period;              // Re-armed from the callback when not 0
+} wheel_probe_t;
+
+static wheel_probe_t probes[WHEEL_TIMERS];
+static int fire_order[WHEEL_TIMERS];
+static int fire_count;
+
+static void probe_fired(void *ctx) {
+    wheel_probe_t *probe = ctx;
+    probe->fired++;
+    probe->fired_at = probe->wheel->now;
+    if (fire_count < WHEEL_TIMERS)
+        fire_order[fire_count] = (int) (probe - probes);
+    fire_count++;
+    if (probe->cancel)
+        timer_wheel_cancel(probe->wheel, probe->cancel);
+    if (probe->period) {
+        probe->due = probe->wheel->now + probe->period;
+        timer_wheel_arm(probe->wheel, &probe->entry, probe->period);
+    }
+}
+
+static void probes_init(timer_wheel_t *wheel) {
+    memset(probes, 0, sizeof(probes));
+    fire_count = 0;
+    for (int i = 0; i < WHEEL_TIMERS; i++) {
+        probes[i].wheel = wheel;
+        timer_wheel_entry_init(&probes[i].entry, probe_fired, &probes[i]);
+    }
+}
+
+static void probe_arm(timer_wheel_t *wheel, int i, uint32_t delay) {
+    probes[i].due = wheel->now + delay;
+    timer_wheel_arm(wheel, &probes[i].entry, delay);
+}
+
+static uint32_t wheel_random(uint32_t *state) {
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 8;
+}
+
+int test_timer_wheel_arm() {
+    printf("test_timer_wheel_arm\n");
+    uint8_t err = 0;
+    static timer_wheel_t wheel;
+    timer_wheel_init(&wheel, 10, 1000);
+    probes_init(&wheel);
+
+    probe_arm(&wheel, 0, 25);
+    TEST_ASSERT(timer_wheel_armed(&probes[0].entry) && wheel.count == 1, "An armed timer should be counted", err);
+    TEST_ASSERT(timer_wheel_advance(&wheel, 1024) == 0 && probes[0].fired == 0, "A timer should not fire early", err);
+    TEST_ASSERT(timer_wheel_advance(&wheel, 1030) == 1 && probes[0].fired == 1 && probes[0].fired_at == 1030,
+            "A timer should fire on the first tick at or after its expiry", err);
+    TEST_ASSERT(!timer_wheel_armed(&probes[0].entry) && wheel.count == 0, "A fired timer should be disarmed", err);
+
+    // Armed between two ticks: rounded up from the exact time
+    timer_wheel_advance(&wheel, 1037);
+    probe_arm(&wheel, 1, 10);
+    timer_wheel_advance(&wheel, 1046);
+    TEST_ASSERT(probes[1].fired == 0, "Rounding should never make a timer early", err);
+    timer_wheel_advance(&wheel, 1050);
+    TEST_ASSERT(probes[1].fired == 1 && probes[1].fired_at == 1050, "The timer should fire on the next tick", err);
+
+    probe_arm(&wheel, 2, 0);
+    timer_wheel_advance(&wheel, 1060);
+    TEST_ASSERT(probes[2].fired == 1, "A zero delay should expire on the next tick", err);
+
+    probe_arm(&wheel, 3, 100);
+    probe_arm(&wheel, 4, 100);
+    timer_wheel_cancel(&wheel, &probes[3].entry);
+    timer_wheel_cancel(&wheel, &probes[3].entry);
+    probe_arm(&wheel, 4, 500);
+    TEST_ASSERT(wheel.count == 1, "Cancelling twice and re-arming should keep the count right", err);
+    timer_wheel_advance(&wheel, 1200);
+    TEST_ASSERT(probes[3].fired == 0 && probes[4].fired == 0, "Cancelled and re-armed timers should not fire at the old time", err);
+    timer_wheel_advance(&wheel, 1560);
+    TEST_ASSERT(probes[4].fired == 1 && probes[4].fired_at == 1560, "A re-armed timer should fire at the new time", err);
+    TEST_ASSERT(wheel.occupied[0] == 0 && wheel.occupied[1] == 0 && wheel.occupied[2] == 0 && wheel.occupied[3] == 0,
+            "An empty wheel should have no occupied slot", err);
+
+    TEST_ASSERT(timer_wheel_advance(&wheel, 1500) == 0 && wheel.now == 1560, "Time going backwards should be ignored", err);
+
+    return 0;
+}
+
+int test_timer_wheel_levels() {
+    printf("test_timer_wheel_levels\n");
+    uint8_t err = 0;
+    static timer_wheel_t wheel;
+    uint32_t seed = 7;
+
+    // Clock about to wrap, delays across every level and beyond the wheel range
+    uint32_t now = 0xFFFF0000u;
+    timer_wheel_init(&wheel, 1, now);
+    probes_init(&wheel);
+    for (int i = 0; i < WHEEL_TIMERS; i++) {
+        uint32_t delay = 1 + wheel_random(&seed) % (1u << (6 * (i % 5) + 4));
+        if (i % 50 == 0)
+            delay = TIMER_WHEEL_RANGE + wheel_random(&seed) % 100000;
+        probe_arm(&wheel, i, delay);
+    }
+
+    bool on_time = true;
+    while (wheel.count > 0) {
+        now += 1 + wheel_random(&seed) % 70000;
+        timer_wheel_advance(&wheel, now);
+    }
+    for (int i = 0; i < WHEEL_TIMERS; i++)
+        on_time &= (probes[i].fired == 1 && probes[i].fired_at == probes[i].due);
+    TEST_ASSERT(fire_count == WHEEL_TIMERS && on_time, "With a 1 ms tick every timer should fire exactly once, at its expiry", err);
+
+    bool ordered = true;
+    for (int i = 1; i < WHEEL_TIMERS; i++)
+        ordered &= ((int32_t) (probes[fire_order[i]].due - probes[fire_order[i - 1]].due) >= 0);
+    TEST_ASSERT(ordered, "Timers should fire in expiry order", err);
+
+    // Coarser tick: never early, at most one tick late
+    timer_wheel_init(&wheel, 10, 12345);
+    probes_init(&wheel);
+    now = 12345;
+    for (int i = 0; i < WHEEL_TIMERS; i++)
+        probe_arm(&wheel, i, wheel_random(&seed) % 400000);
+    while (wheel.count > 0) {
+        now += 1 + wheel_random(&seed) % 3000;
+        timer_wheel_advance(&wheel, now);
+        if (wheel_random(&seed) % 4 == 0)
+            probe_arm(&wheel, wheel_random(&seed) % WHEEL_TIMERS, wheel_random(&seed) % 5000);
+        if (fire_count > 4 * WHEEL_TIMERS)
+            break;
+    }
+    bool bounded = true;
+    for (int i = 0; i < WHEEL_TIMERS; i++)
+        bounded &= (probes[i].fired >= 1 && (int32_t) (probes[i].fired_at - probes[i].due) >= 0 && probes[i].fired_at - probes[i].due < 10);
+    TEST_ASSERT(bounded && wheel.count == 0, "Timers should fire within one tick after their expiry", err);
+
+    return 0;
+}
+
+int test_timer_wheel_callbacks() {
+    printf("test_timer_wheel_callbacks\n");
+    uint8_t err = 0;
+    static timer_wheel_t wheel;
+    timer_wheel_init(&wheel, 10, 0);
+    probes_init(&wheel);
+
+    // Periodic timer re-armed from its own callback, one advance covering many periods
+    probes[0].period = 100;
+    probe_arm(&wheel, 0, 100);
+    TEST_ASSERT(timer_wheel_advance(&wheel, 1000) == 10 && probes[0].fired_at == 1000 && probes[0].due == 1100,
+            "A periodic timer should fire once per period, each at its own time", err);
+
+    // Two timers due on the same tick, each cancelling the other: whichever fires first wins
+    probes[1].cancel = &probes[2].entry;
+    probes[2].cancel = &probes[1].entry;
+    probe_arm(&wheel, 1, 50);
+    probe_arm(&wheel, 2, 50);
+    timer_wheel_advance(&wheel, 1050);
+    TEST_ASSERT(probes[1].fired + probes[2].fired == 1 && !timer_wheel_armed(&probes[1].entry) && !timer_wheel_armed(&probes[2].entry),
+            "A timer cancelled by a callback should not fire", err);
+    timer_wheel_cancel(&wheel, &probes[0].entry);
+    TEST_ASSERT(wheel.count == 0, "No timer should be left", err);
+
+    return 0;
+}
+
+int test_timer_wheel_main() {
+    int result = 0;
+    printf("\n----------------------------------------------------------------------------------\n");
+    printf("Starting Timer Wheel Tests\n");
+    printf("----------------------------------------------------------------------------------\n\n");
+    result |= test_timer_wheel_arm();
+    result |= test_timer_wheel_levels();
+    result |= test_timer_wheel_callbacks();
+    printf("\n----------------------------------------------------------------------------------\n");
+    printf("Tests Timer Wheel Completed. %s\n", result == 0 ? "All tests passed" : "Some tests failed");
+    printf("----------------------------------------------------------------------------------\n\n");
+    return result;
+}
@@ -320,6 +320,11 @@ void aprs_frame_print(const unsigned char *aprs_frame, int aprs_len) {
     // Treat the input as the raw APRS information field
     const char *info = (const char*) aprs_frame;
 
+    // Strings of the decoded packet are allocated here and dropped on return
+    unsigned char scratch[2 * APRS_MAX_INFO_LEN];
+    mem_arena_t arena;
+    mem_arena_init(&arena, scratch, sizeof(scratch));
+
     // Extract and print the Data Type Indicator (DTI)
     char dti = info[0];
     printf("Data Type Indicator: %c\n", dti);
@@ -328,7 +333,7 @@ void aprs_frame_print(const unsigned char *aprs_frame, int aprs_len) {
         case '!':
         case '=': {
             aprs_position_no_ts_t pos;
-            if (aprs_decode_position_no_ts(info, &pos) == 0) {
+            if (aprs_decode_position_no_ts_arena(info, &pos, &arena) == 0) {
                 printf("Position: %.6f, %.6f\n", pos.latitude, pos.longitude);
                 printf("Symbol Table: %c\n", pos.symbol_table);
                 printf("Symbol Code: %c\n", pos.symbol_code);
@@ -338,7 +343,6 @@ void aprs_frame_print(const unsigned char *aprs_frame, int aprs_len) {
                 }
                 if (pos.comment) {
                     printf("Comment: %s\n", pos.comment);
-                    free(pos.comment);
                 }
             } else {
                 printf("Failed to decode position\n");
@@ -348,14 +352,13 @@ void aprs_frame_print(const unsigned char *aprs_frame, int aprs_len) {
         case '/':
         case '@': {
             aprs_position_with_ts_t pos;
-            if (aprs_decode_position_with_ts(info, &pos) == 0) {
+            if (aprs_decode_position_with_ts_arena(info, &pos, &arena) == 0) {
                 printf("Timestamp: %s\n", pos.timestamp);
                 printf("Position: %.6f, %.6f\n", pos.latitude, pos.longitude);
                 printf("Symbol Table: %c\n", pos.symbol_table);
                 printf("Symbol Code: %c\n", pos.symbol_code);
                 if (pos.comment) {
                     printf("Comment: %s\n", pos.comment);
-                    free(pos.comment);
                 }
             } else {
                 printf("Failed to decode position with timestamp\n");
@@ -364,14 +367,12 @@ void aprs_frame_print(const unsigned char *aprs_frame, int aprs_len) {
         }
         case ':': {
             aprs_message_t msg;
-            if (aprs_decode_message(info, &msg) == 0) {
+            if (aprs_decode_message_arena(info, &msg, &arena) == 0) {
                 printf("Addressee: %s\n", msg.addressee);
                 printf("Message: %s\n", msg.message);
                 if (msg.message_number) {
                     printf("Message Number: %s\n", msg.message_number);
-                    free(msg.message_number);
                 }
-                free(msg.message);
             } else {
                 printf("Failed to decode message\n");
             }
@@ -391,7 +392,7 @@ void aprs_frame_print(const unsigned char *aprs_frame, int aprs_len) {
         }
         case ';': {
             aprs_object_report_t obj;
-            if (aprs_decode_object_report(info, &obj) == 0) {
+            if (aprs_decode_object_report_arena(info, &obj, &arena) == 0) {
                 printf("Object Name: %s\n", obj.name);
                 printf("Timestamp: %s\n", obj.timestamp);
                 printf("Position: %.6f, %.6f\n", obj.latitude, obj.longitude);